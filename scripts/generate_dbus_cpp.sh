@@ -17,3 +17,17 @@ qdbusxml2cpp razerled.xml -a razerledadaptor.h:razerledadaptor.cpp -c RazerLEDAd
 mv razerledadaptor.h razerledadaptor.cpp src/dbus/
 # add razer_test.h include
 sed -i '/#define RAZERLEDADAPTOR_H/a #include "../razer_test.h"\nusing namespace razer_test;' src/dbus/razerledadaptor.h
+
+
+# Proxies of the client library, they include razer_test.h from the include path
+for interface in razerdevice:RazerDeviceInterface razerled:RazerLEDInterface devicemanager:DeviceManagerInterface; do
+    name=${interface%%:*}
+    class=${interface##*:}
+    qdbusxml2cpp $name.xml -p ${name}interface.h:${name}interface.cpp -c $class -i razer_test.h
+    mv ${name}interface.h ${name}interface.cpp src/client/
+    sed -i '/#include "razer_test.h"/a using namespace razer_test;' src/client/${name}interface.h
+done
+
+
+# Dispatchers of the device and LED interfaces, used instead of the adaptors by default
+python3 scripts/generate_dbus_dispatch.py
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+#
+# Generates the DBusDispatcher tables of the device and LED interfaces from the introspection XML.
+# The property getters are taken from the Q_PROPERTY declarations of the exported class.
+# Run from the root of the repository, like generate_dbus_cpp.sh.
+
+import re
+import xml.etree.ElementTree as ET
+
+LICENSE = open('src/dbus/dbusdispatcher.h').read().split('*/', 1)[0] + '*/\n'
+
+BASIC_TYPES = {
+    'b': 'bool',
+    'y': 'uchar',
+    'n': 'short',
+    'q': 'ushort',
+    'i': 'int',
+    'u': 'uint',
+    'x': 'qlonglong',
+    't': 'qulonglong',
+    'd': 'double',
+    's': 'QString',
+    'o': 'QDBusObjectPath',
+    'h': 'QDBusUnixFileDescriptor',
+    'ay': 'QByteArray',
+    'as': 'QStringList',
+    'ao': 'QList<QDBusObjectPath>',
+}
+
+TYPE_ANNOTATION = 'org.qtproject.QtDBus.QtTypeName'
+
+# Frame data, rate limited separately from the control commands
+BULK_METHODS = {'defineCustomFrame', 'defineLayerFrame', 'displayCustomFrame', 'submitFrame'}
+
+# Change what the device shows, suspended for clients that don't own the lighting lease
+LIGHTING_METHODS = {
+    'defineCustomFrame', 'defineLayerFrame', 'displayCustomFrame', 'pauseCustomEffectThread', 'playAnimation',
+    'removeLayer', 'setLayerProperties', 'startCustomEffectThread', 'submitFrame',
+    'setNone', 'setStatic', 'setBreathing', 'setBreathingDual', 'setBreathingRandom', 'setBlinking',
+    'setSpectrum', 'setWave', 'setReactive', 'setBrightness',
+    'setColorCorrection', 'setSoftwareBrightness', 'setFrameInterpolation', 'setTransitionDuration',
+}
+
+# Answered by the daemon alone, they work while the device doesn't respond
+METHODS_WITHOUT_DEVICE = {
+    'acquireLighting', 'releaseLighting', 'getLightingOwner', 'getMaxDPI', 'getMonotonicTime',
+    'setCommitDelay', 'setFrameInterpolation', 'setTransitionDuration',
+}
+
+
+def cpp_type(element, annotation):
+    for child in element.findall('annotation'):
+        if child.get('name') == annotation:
+            return child.get('value')
+    return None
+
+
+def arg_type(method, arg, annotation):
+    return cpp_type(method, annotation) or BASIC_TYPES[arg.get('type')]
+
+
+def c_string(text):
+    lines = text.splitlines(True)
+    return '\n'.join('    "%s"' % line.replace('\\', '\\\\').replace('"', '\\"').replace('\n', '\\n') for line in lines)
+
+
+def generate(xml, header, cls, dispatcher, variable, out):
+    source = open(xml).read()
+    interface = ET.fromstring(source.split('\n', 1)[1]).find('interface')
+    iface = interface.get('name')
+    introspection = re.search(r'(  <interface.*?</interface>\n)', source, re.S).group(1)
+    getters = dict((name, getter) for name, getter in
+                   re.findall(r'Q_PROPERTY\(.* (\w+) READ (\w+)\)', open(header).read()))
+
+    methods = []
+    for method in interface.findall('method'):
+        name = method.get('name')
+        ins = [arg for arg in method.findall('arg') if arg.get('direction') == 'in']
+        outs = [arg for arg in method.findall('arg') if arg.get('direction') == 'out']
+        assert len(outs) <= 1, name
+        args = ['qdbus_cast<%s>(arguments.at(%d))' % (arg_type(method, arg, '%s.In%d' % (TYPE_ANNOTATION, i)), i)
+                for i, arg in enumerate(ins)]
+        call = '%s->%s(%s)' % (variable, name, ', '.join(args))
+        if outs:
+            body = '    return QVariant::fromValue(%s);\n' % call
+        else:
+            body = '    %s;\n    return QVariant();\n' % call
+        reply = ''.join(arg.get('type') for arg in outs)
+        assert name not in LIGHTING_METHODS or reply in ('', 'b'), name
+        methods.append((name, ''.join(arg.get('type') for arg in ins), reply, bool(ins), call, body))
+
+    properties = []
+    for prop in interface.findall('property'):
+        properties.append((prop.get('name'), getters[prop.get('name')]))
+
+    signals = []
+    for signal in interface.findall('signal'):
+        args = [(BASIC_TYPES[arg.get('type')], arg.get('name')) for arg in signal.findall('arg')]
+        signals.append((signal.get('name'), args))
+
+    guard = dispatcher.upper() + '_H'
+    h = LICENSE + '\n'
+    h += '#ifndef %s\n#define %s\n\n' % (guard, guard)
+    h += '#include "dbusdispatcher.h"\n\n'
+    h += 'class %s;\n\n' % cls
+    h += '/*\n * Dispatcher for interface %s\n */\n' % iface
+    h += 'class %s : public DBusDispatcher\n{\npublic:\n' % dispatcher
+    h += '    explicit %s(%s *parent);\n};\n\n' % (dispatcher, cls)
+    h += '#endif // %s\n' % guard
+    open('src/dbus/%s.h' % out, 'w').write(h)
+
+    c = LICENSE + '\n'
+    c += '#include "%s.h"\n' % out
+    c += '#include "../%s"\n\n' % header[len('src/'):]
+    c += '/*\n * Implementation of dispatcher class %s\n */\n\n' % dispatcher
+    c += 'namespace {\n\n'
+    for name, signature, reply, has_args, call, body in sorted(methods):
+        c += 'QVariant method_%s(QObject *target, const QList<QVariant> &%s)\n{\n' % (name, 'arguments' if has_args else '/*arguments*/')
+        c += '    // handle method call %s.%s\n' % (iface, name)
+        c += '    auto *%s = static_cast<%s *>(target);\n' % (variable, cls)
+        c += body + '}\n\n'
+    for name, getter in sorted(properties):
+        c += 'QVariant property_%s(QObject *target)\n{\n' % name
+        c += '    // get the value of property %s\n' % name
+        c += '    return QVariant::fromValue(static_cast<%s *>(target)->%s());\n}\n\n' % (cls, getter)
+    c += 'const DBusDispatcher::Method methods[] = {\n'
+    c += ',\n'.join('    {"%s", "%s", "%s", ClientQos::TrafficClass::%s, %s, %s, method_%s}'
+                     % (name, signature, reply, 'Bulk' if name in BULK_METHODS else 'Control',
+                        'true' if name in LIGHTING_METHODS else 'false',
+                        'false' if name in METHODS_WITHOUT_DEVICE else 'true', name)
+                     for name, signature, reply, _, _, _ in sorted(methods))
+    c += '\n};\n\n'
+    c += 'const DBusDispatcher::Property properties[] = {\n'
+    c += ',\n'.join('    {"%s", property_%s}' % (name, name) for name, _ in sorted(properties))
+    c += '\n};\n\n'
+    c += 'const DBusDispatcher::Interface dispatchInterface = {\n'
+    c += '    "%s",\n' % iface
+    c += c_string(introspection) + ',\n'
+    c += '    methods, sizeof(methods) / sizeof(methods[0]),\n'
+    c += '    properties, sizeof(properties) / sizeof(properties[0])\n};\n\n'
+    c += '}\n\n'
+    c += '%s::%s(%s *parent)\n' % (dispatcher, dispatcher, cls)
+    c += '    : DBusDispatcher(dispatchInterface, parent, parent)\n{\n'
+    if signals:
+        c += '    // relay signals\n'
+    for name, args in signals:
+        params = ', '.join('%s %s' % arg for arg in args)
+        values = ', '.join('QVariant::fromValue(%s)' % arg[1] for arg in args)
+        c += '    connect(parent, &%s::%s, this, [this](%s) {\n' % (cls, name, params)
+        c += '        emitSignal(QStringLiteral("%s"), {%s});\n' % (name, values)
+        c += '    });\n'
+    c += '}\n'
+    open('src/dbus/%s.cpp' % out, 'w').write(c)
+
+
+generate('razerdevice.xml', 'src/device/razerdevice.h', 'RazerDevice', 'RazerDeviceDispatcher', 'device', 'razerdevicedispatcher')
+generate('razerled.xml', 'src/led/razerled.h', 'RazerLED', 'RazerLEDDispatcher', 'led', 'razerleddispatcher')
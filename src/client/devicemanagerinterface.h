@@ -0,0 +1,99 @@
+/*
+ * This file was generated by qdbusxml2cpp version 0.8
+ * Command line was: qdbusxml2cpp devicemanager.xml -p devicemanagerinterface.h:devicemanagerinterface.cpp -c DeviceManagerInterface -i razer_test.h
+ *
+ * qdbusxml2cpp is Copyright (C) 2017 The Qt Company Ltd.
+ *
+ * This is an auto-generated file.
+ * Do not edit! All changes made to it will be lost.
+ */
+
+#ifndef DEVICEMANAGERINTERFACE_H
+#define DEVICEMANAGERINTERFACE_H
+
+#include <QtCore/QObject>
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QMap>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+#include <QtDBus/QtDBus>
+#include "razer_test.h"
+using namespace razer_test;
+
+/*
+ * Proxy class for interface io.github.openrazer1.Manager
+ */
+class DeviceManagerInterface: public QDBusAbstractInterface
+{
+    Q_OBJECT
+public:
+    static inline const char *staticInterfaceName()
+    { return "io.github.openrazer1.Manager"; }
+
+public:
+    DeviceManagerInterface(const QString &service, const QString &path, const QDBusConnection &connection, QObject *parent = nullptr);
+
+    ~DeviceManagerInterface();
+
+    Q_PROPERTY(QList<QDBusObjectPath> Devices READ devices)
+    inline QList<QDBusObjectPath> devices() const
+    { return qvariant_cast< QList<QDBusObjectPath> >(property("Devices")); }
+
+    Q_PROPERTY(QString Version READ version)
+    inline QString version() const
+    { return qvariant_cast< QString >(property("Version")); }
+
+public Q_SLOTS: // METHODS
+    inline QDBusPendingReply<QList<razer_test::RazerOperationResult>> applyBatch(const QList<razer_test::RazerOperation> &operations)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(operations);
+        return asyncCallWithArgumentList(QStringLiteral("applyBatch"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> applyScene(const QString &name)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(name);
+        return asyncCallWithArgumentList(QStringLiteral("applyScene"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> defineScene(const QString &name, const QList<razer_test::RazerOperation> &operations)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(name) << QVariant::fromValue(operations);
+        return asyncCallWithArgumentList(QStringLiteral("defineScene"), argumentList);
+    }
+
+    inline QDBusPendingReply<QVariantMap> getBusUtilization()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("getBusUtilization"), argumentList);
+    }
+
+    inline QDBusPendingReply<QString> getPeerAddress()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("getPeerAddress"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> removeScene(const QString &name)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(name);
+        return asyncCallWithArgumentList(QStringLiteral("removeScene"), argumentList);
+    }
+
+Q_SIGNALS: // SIGNALS
+};
+
+namespace io {
+  namespace github {
+    namespace openrazer1 {
+      typedef ::DeviceManagerInterface Manager;
+    }
+  }
+}
+#endif
@@ -0,0 +1,160 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "razerclient.h"
+
+static const char *const serviceName = "io.github.openrazer1";
+static const char *const managerPath = "/io/github/openrazer1";
+static const char *const peerConnectionName = "razer_test_client";
+
+RazerClient::RazerClient(QObject *parent)
+    : QObject(parent)
+    , connection(QDBusConnection::systemBus())
+{
+    razer_test::registerMetaTypes();
+}
+
+RazerClient::~RazerClient()
+{
+    if (transport == Transport::Peer)
+        QDBusConnection::disconnectFromPeer(peerConnectionName);
+}
+
+bool RazerClient::connectToDaemon(bool allowPeer)
+{
+    QDBusConnection bus = QDBusConnection::systemBus();
+    if (!bus.isConnected()) {
+        qWarning("Failed to connect to the system bus.");
+        return false;
+    }
+    disconnectFromDaemon();
+    connection = bus;
+    service = serviceName;
+
+    if (!allowPeer) {
+        loadManager();
+        return true;
+    }
+    DeviceManagerInterface busManager(serviceName, managerPath, bus);
+    addressWatcher = new QDBusPendingCallWatcher(busManager.getPeerAddress(), this);
+    connect(addressWatcher, &QDBusPendingCallWatcher::finished, this, &RazerClient::peerAddressReceived);
+    return true;
+}
+
+RazerClient::Transport RazerClient::getTransport() const
+{
+    return transport;
+}
+
+QDBusConnection RazerClient::getConnection() const
+{
+    return connection;
+}
+
+bool RazerClient::isReady() const
+{
+    return readyEmitted;
+}
+
+DeviceManagerInterface *RazerClient::getManager() const
+{
+    return manager;
+}
+
+QList<RazerClientDevice *> RazerClient::getDevices() const
+{
+    return devices;
+}
+
+RazerClientDevice *RazerClient::getDevice(const QDBusObjectPath &path) const
+{
+    foreach (RazerClientDevice *device, devices) {
+        if (device->getPath() == path)
+            return device;
+    }
+    return nullptr;
+}
+
+void RazerClient::peerAddressReceived(QDBusPendingCallWatcher *watcher)
+{
+    QDBusPendingReply<QString> address = *watcher;
+    watcher->deleteLater();
+    addressWatcher = nullptr;
+    // Daemons without the peer-to-peer endpoint answer with an error, the bus works with them too
+    if (address.isValid() && !address.value().isEmpty()) {
+        QDBusConnection peer = QDBusConnection::connectToPeer(address.value(), peerConnectionName);
+        if (peer.isConnected()) {
+            connection = peer;
+            // There is no bus to route by service name
+            service = QString();
+            transport = Transport::Peer;
+        } else {
+            QDBusConnection::disconnectFromPeer(peerConnectionName);
+        }
+    }
+    loadManager();
+}
+
+void RazerClient::loadManager()
+{
+    manager = new DeviceManagerInterface(service, managerPath, connection, this);
+    managerCache = new RazerPropertyCache(connection, service, managerPath, DeviceManagerInterface::staticInterfaceName(), this);
+    connect(managerCache, &RazerPropertyCache::loaded, this, &RazerClient::managerLoaded);
+    managerCache->refresh();
+}
+
+void RazerClient::disconnectFromDaemon()
+{
+    delete addressWatcher;
+    addressWatcher = nullptr;
+    delete manager;
+    manager = nullptr;
+    delete managerCache;
+    managerCache = nullptr;
+    qDeleteAll(devices);
+    devices.clear();
+    readyEmitted = false;
+    if (transport == Transport::Peer)
+        QDBusConnection::disconnectFromPeer(peerConnectionName);
+    transport = Transport::SystemBus;
+}
+
+void RazerClient::managerLoaded()
+{
+    // Devices aren't added at runtime, only the first load creates them
+    if (!devices.isEmpty() || readyEmitted)
+        return;
+    foreach (const QDBusObjectPath &path, managerCache->value<QList<QDBusObjectPath>>("Devices")) {
+        auto *device = new RazerClientDevice(connection, service, path, this);
+        connect(device, &RazerClientDevice::ready, this, &RazerClient::checkReady);
+        devices.append(device);
+    }
+    checkReady();
+}
+
+void RazerClient::checkReady()
+{
+    if (readyEmitted)
+        return;
+    foreach (RazerClientDevice *device, devices) {
+        if (!device->isReady())
+            return;
+    }
+    readyEmitted = true;
+    emit ready();
+}
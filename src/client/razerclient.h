@@ -0,0 +1,81 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RAZERCLIENT_H
+#define RAZERCLIENT_H
+
+#include <QDBusPendingCallWatcher>
+#include <QObject>
+
+#include "devicemanagerinterface.h"
+#include "razerclientdevice.h"
+#include "razerpropertycache.h"
+
+/**
+ * Entry point of the client library.
+ *
+ * Connects to the daemon, directly if it offers a peer-to-peer address and through
+ * the system bus otherwise, and keeps a cached RazerClientDevice for every device.
+ */
+class RazerClient : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Transport {
+        SystemBus,
+        Peer
+    };
+
+    explicit RazerClient(QObject *parent = nullptr);
+    ~RazerClient() override;
+
+    // Asynchronous, ready() is emitted once all devices are loaded. Only fails right away without a system bus.
+    // Connecting again starts over, the devices of the previous connection are deleted.
+    bool connectToDaemon(bool allowPeer = true);
+    Transport getTransport() const;
+    QDBusConnection getConnection() const;
+    bool isReady() const;
+
+    DeviceManagerInterface *getManager() const;
+    QList<RazerClientDevice *> getDevices() const;
+    RazerClientDevice *getDevice(const QDBusObjectPath &path) const;
+
+signals:
+    void ready();
+
+private slots:
+    void peerAddressReceived(QDBusPendingCallWatcher *watcher);
+    void managerLoaded();
+    void checkReady();
+
+private:
+    void loadManager();
+    void disconnectFromDaemon();
+
+    QDBusConnection connection;
+    QString service;
+    Transport transport = Transport::SystemBus;
+    QDBusPendingCallWatcher *addressWatcher = nullptr;
+    DeviceManagerInterface *manager = nullptr;
+    RazerPropertyCache *managerCache = nullptr;
+    QList<RazerClientDevice *> devices;
+    bool readyEmitted = false;
+};
+
+#endif // RAZERCLIENT_H
@@ -0,0 +1,126 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "razerclientdevice.h"
+
+RazerClientDevice::RazerClientDevice(const QDBusConnection &connection, const QString &service, const QDBusObjectPath &path, QObject *parent)
+    : QObject(parent)
+    , connection(connection)
+    , service(service)
+    , path(path)
+{
+    proxy = new RazerDeviceInterface(service, path.path(), connection, this);
+    cache = new RazerPropertyCache(connection, service, path.path(), RazerDeviceInterface::staticInterfaceName(), this);
+    connect(cache, &RazerPropertyCache::loaded, this, &RazerClientDevice::cacheLoaded);
+    cache->refresh();
+}
+
+QDBusObjectPath RazerClientDevice::getPath() const
+{
+    return path;
+}
+
+RazerDeviceInterface *RazerClientDevice::getProxy() const
+{
+    return proxy;
+}
+
+RazerPropertyCache *RazerClientDevice::getCache() const
+{
+    return cache;
+}
+
+bool RazerClientDevice::isReady() const
+{
+    return readyEmitted;
+}
+
+QList<RazerClientLED *> RazerClientDevice::getLeds() const
+{
+    return leds;
+}
+
+RazerClientLED *RazerClientDevice::getLed(RazerLedId ledId) const
+{
+    foreach (RazerClientLED *led, leds) {
+        if (led->getLedId() == ledId)
+            return led;
+    }
+    return nullptr;
+}
+
+QString RazerClientDevice::getName() const
+{
+    return cache->value<QString>("Name");
+}
+
+QString RazerClientDevice::getType() const
+{
+    return cache->value<QString>("Type");
+}
+
+QStringList RazerClientDevice::getSupportedFx() const
+{
+    return cache->value<QStringList>("SupportedFx");
+}
+
+QStringList RazerClientDevice::getSupportedFeatures() const
+{
+    return cache->value<QStringList>("SupportedFeatures");
+}
+
+MatrixDimensions RazerClientDevice::getMatrixDimensions() const
+{
+    return cache->value<MatrixDimensions>("MatrixDimensions");
+}
+
+RazerDPI RazerClientDevice::getDPI() const
+{
+    return cache->value<RazerDPI>("DPI");
+}
+
+ushort RazerClientDevice::getPollRate() const
+{
+    return cache->value<ushort>("PollRate");
+}
+
+void RazerClientDevice::cacheLoaded()
+{
+    // The LEDs don't change, only the first load creates them
+    if (!leds.isEmpty() || readyEmitted) {
+        return;
+    }
+    foreach (const QDBusObjectPath &ledPath, cache->value<QList<QDBusObjectPath>>("Leds")) {
+        auto *led = new RazerClientLED(connection, service, ledPath, this);
+        connect(led->getCache(), &RazerPropertyCache::loaded, this, &RazerClientDevice::checkReady);
+        leds.append(led);
+    }
+    checkReady();
+}
+
+void RazerClientDevice::checkReady()
+{
+    if (readyEmitted)
+        return;
+    foreach (RazerClientLED *led, leds) {
+        if (!led->getCache()->isLoaded())
+            return;
+    }
+    readyEmitted = true;
+    emit ready();
+}
@@ -0,0 +1,76 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RAZERCLIENTDEVICE_H
+#define RAZERCLIENTDEVICE_H
+
+#include <QObject>
+
+#include "razerclientled.h"
+#include "razerdeviceinterface.h"
+#include "razerpropertycache.h"
+
+/**
+ * A device of the daemon, with its metadata and state cached on the client.
+ *
+ * The LEDs are known once the cache is loaded, ready() is emitted when the
+ * device and all of its LEDs are.
+ */
+class RazerClientDevice : public QObject
+{
+    Q_OBJECT
+
+public:
+    RazerClientDevice(const QDBusConnection &connection, const QString &service, const QDBusObjectPath &path, QObject *parent = nullptr);
+
+    QDBusObjectPath getPath() const;
+    // Asynchronous calls, e.g. getProxy()->setDPI(dpi)
+    RazerDeviceInterface *getProxy() const;
+    RazerPropertyCache *getCache() const;
+    bool isReady() const;
+
+    QList<RazerClientLED *> getLeds() const;
+    RazerClientLED *getLed(RazerLedId ledId) const;
+
+    // Cached, valid once the device is ready
+    QString getName() const;
+    QString getType() const;
+    QStringList getSupportedFx() const;
+    QStringList getSupportedFeatures() const;
+    MatrixDimensions getMatrixDimensions() const;
+    RazerDPI getDPI() const;
+    ushort getPollRate() const;
+
+signals:
+    void ready();
+
+private slots:
+    void cacheLoaded();
+    void checkReady();
+
+private:
+    QDBusConnection connection;
+    QString service;
+    QDBusObjectPath path;
+    RazerDeviceInterface *proxy;
+    RazerPropertyCache *cache;
+    QList<RazerClientLED *> leds;
+    bool readyEmitted = false;
+};
+
+#endif // RAZERCLIENTDEVICE_H
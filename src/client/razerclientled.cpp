@@ -0,0 +1,63 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "razerclientled.h"
+
+RazerClientLED::RazerClientLED(const QDBusConnection &connection, const QString &service, const QDBusObjectPath &path, QObject *parent)
+    : QObject(parent)
+    , path(path)
+{
+    proxy = new RazerLEDInterface(service, path.path(), connection, this);
+    cache = new RazerPropertyCache(connection, service, path.path(), RazerLEDInterface::staticInterfaceName(), this);
+    cache->refresh();
+}
+
+QDBusObjectPath RazerClientLED::getPath() const
+{
+    return path;
+}
+
+RazerLEDInterface *RazerClientLED::getProxy() const
+{
+    return proxy;
+}
+
+RazerPropertyCache *RazerClientLED::getCache() const
+{
+    return cache;
+}
+
+RazerLedId RazerClientLED::getLedId() const
+{
+    return cache->value<RazerLedId>("LedId");
+}
+
+RazerEffect RazerClientLED::getCurrentEffect() const
+{
+    return cache->value<RazerEffect>("CurrentEffect");
+}
+
+QList<RGB> RazerClientLED::getCurrentColors() const
+{
+    return cache->value<QList<RGB>>("CurrentColors");
+}
+
+uchar RazerClientLED::getBrightness() const
+{
+    return cache->value<uchar>("Brightness");
+}
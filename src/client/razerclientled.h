@@ -0,0 +1,54 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RAZERCLIENTLED_H
+#define RAZERCLIENTLED_H
+
+#include <QObject>
+
+#include "razerledinterface.h"
+#include "razerpropertycache.h"
+
+/**
+ * An LED of a device, with its state cached on the client.
+ */
+class RazerClientLED : public QObject
+{
+    Q_OBJECT
+
+public:
+    RazerClientLED(const QDBusConnection &connection, const QString &service, const QDBusObjectPath &path, QObject *parent = nullptr);
+
+    QDBusObjectPath getPath() const;
+    // Asynchronous calls, e.g. getProxy()->setStatic(color)
+    RazerLEDInterface *getProxy() const;
+    RazerPropertyCache *getCache() const;
+
+    // Cached, valid once the cache is loaded
+    RazerLedId getLedId() const;
+    RazerEffect getCurrentEffect() const;
+    QList<RGB> getCurrentColors() const;
+    uchar getBrightness() const;
+
+private:
+    QDBusObjectPath path;
+    RazerLEDInterface *proxy;
+    RazerPropertyCache *cache;
+};
+
+#endif // RAZERCLIENTLED_H
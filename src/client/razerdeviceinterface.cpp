@@ -0,0 +1,25 @@
+/*
+ * This file was generated by qdbusxml2cpp version 0.8
+ * Command line was: qdbusxml2cpp razerdevice.xml -p razerdeviceinterface.h:razerdeviceinterface.cpp -c RazerDeviceInterface -i razer_test.h
+ *
+ * qdbusxml2cpp is Copyright (C) 2017 The Qt Company Ltd.
+ *
+ * This is an auto-generated file.
+ * Do not edit! All changes made to it will be lost.
+ */
+
+#include "razerdeviceinterface.h"
+
+/*
+ * Implementation of interface class RazerDeviceInterface
+ */
+
+RazerDeviceInterface::RazerDeviceInterface(const QString &service, const QString &path, const QDBusConnection &connection, QObject *parent)
+    : QDBusAbstractInterface(service, path, staticInterfaceName(), connection, parent)
+{
+}
+
+RazerDeviceInterface::~RazerDeviceInterface()
+{
+}
+
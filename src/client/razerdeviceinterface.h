@@ -0,0 +1,263 @@
+/*
+ * This file was generated by qdbusxml2cpp version 0.8
+ * Command line was: qdbusxml2cpp razerdevice.xml -p razerdeviceinterface.h:razerdeviceinterface.cpp -c RazerDeviceInterface -i razer_test.h
+ *
+ * qdbusxml2cpp is Copyright (C) 2017 The Qt Company Ltd.
+ *
+ * This is an auto-generated file.
+ * Do not edit! All changes made to it will be lost.
+ */
+
+#ifndef RAZERDEVICEINTERFACE_H
+#define RAZERDEVICEINTERFACE_H
+
+#include <QtCore/QObject>
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QMap>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+#include <QtDBus/QtDBus>
+#include "razer_test.h"
+using namespace razer_test;
+
+/*
+ * Proxy class for interface io.github.openrazer1.Device
+ */
+class RazerDeviceInterface: public QDBusAbstractInterface
+{
+    Q_OBJECT
+public:
+    static inline const char *staticInterfaceName()
+    { return "io.github.openrazer1.Device"; }
+
+public:
+    RazerDeviceInterface(const QString &service, const QString &path, const QDBusConnection &connection, QObject *parent = nullptr);
+
+    ~RazerDeviceInterface();
+
+    Q_PROPERTY(RazerDPI DPI READ dPI)
+    inline RazerDPI dPI() const
+    { return qvariant_cast< RazerDPI >(property("DPI")); }
+
+    Q_PROPERTY(QList<QDBusObjectPath> Leds READ leds)
+    inline QList<QDBusObjectPath> leds() const
+    { return qvariant_cast< QList<QDBusObjectPath> >(property("Leds")); }
+
+    Q_PROPERTY(MatrixDimensions MatrixDimensions READ matrixDimensions)
+    inline MatrixDimensions matrixDimensions() const
+    { return qvariant_cast< MatrixDimensions >(property("MatrixDimensions")); }
+
+    Q_PROPERTY(QString Name READ name)
+    inline QString name() const
+    { return qvariant_cast< QString >(property("Name")); }
+
+    Q_PROPERTY(ushort PollRate READ pollRate)
+    inline ushort pollRate() const
+    { return qvariant_cast< ushort >(property("PollRate")); }
+
+    Q_PROPERTY(QStringList SupportedFeatures READ supportedFeatures)
+    inline QStringList supportedFeatures() const
+    { return qvariant_cast< QStringList >(property("SupportedFeatures")); }
+
+    Q_PROPERTY(QStringList SupportedFx READ supportedFx)
+    inline QStringList supportedFx() const
+    { return qvariant_cast< QStringList >(property("SupportedFx")); }
+
+    Q_PROPERTY(QString Type READ type)
+    inline QString type() const
+    { return qvariant_cast< QString >(property("Type")); }
+
+public Q_SLOTS: // METHODS
+    inline QDBusPendingReply<bool> acquireLighting(uchar priority)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(priority);
+        return asyncCallWithArgumentList(QStringLiteral("acquireLighting"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> commit()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("commit"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> defineCustomFrame(uchar row, uchar startColumn, uchar endColumn, const QByteArray &rgbData)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(row) << QVariant::fromValue(startColumn) << QVariant::fromValue(endColumn) << QVariant::fromValue(rgbData);
+        return asyncCallWithArgumentList(QStringLiteral("defineCustomFrame"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> defineLayerFrame(uchar layer, uchar row, uchar startColumn, uchar endColumn, const QByteArray &rgbData)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(layer) << QVariant::fromValue(row) << QVariant::fromValue(startColumn) << QVariant::fromValue(endColumn) << QVariant::fromValue(rgbData);
+        return asyncCallWithArgumentList(QStringLiteral("defineLayerFrame"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> displayCustomFrame()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("displayCustomFrame"), argumentList);
+    }
+
+    inline QDBusPendingReply<RazerDPI> getDPI()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("getDPI"), argumentList);
+    }
+
+    inline QDBusPendingReply<QString> getFirmwareVersion()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("getFirmwareVersion"), argumentList);
+    }
+
+    inline QDBusPendingReply<QString> getKeyboardLayout()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("getKeyboardLayout"), argumentList);
+    }
+
+    inline QDBusPendingReply<QString> getLightingOwner()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("getLightingOwner"), argumentList);
+    }
+
+    inline QDBusPendingReply<ushort> getMaxDPI()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("getMaxDPI"), argumentList);
+    }
+
+    inline QDBusPendingReply<qlonglong> getMonotonicTime()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("getMonotonicTime"), argumentList);
+    }
+
+    inline QDBusPendingReply<ushort> getPollRate()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("getPollRate"), argumentList);
+    }
+
+    inline QDBusPendingReply<QString> getSerial()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("getSerial"), argumentList);
+    }
+
+    inline QDBusPendingReply<> pauseCustomEffectThread()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("pauseCustomEffectThread"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> playAnimation(const QDBusUnixFileDescriptor &file, bool loop)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(file) << QVariant::fromValue(loop);
+        return asyncCallWithArgumentList(QStringLiteral("playAnimation"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> releaseLighting()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("releaseLighting"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> removeLayer(uchar layer)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(layer);
+        return asyncCallWithArgumentList(QStringLiteral("removeLayer"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> setColorCorrection(double gamma, double redGain, double greenGain, double blueGain)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(gamma) << QVariant::fromValue(redGain) << QVariant::fromValue(greenGain) << QVariant::fromValue(blueGain);
+        return asyncCallWithArgumentList(QStringLiteral("setColorCorrection"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> setCommitDelay(ushort milliseconds)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(milliseconds);
+        return asyncCallWithArgumentList(QStringLiteral("setCommitDelay"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> setDPI(razer_test::RazerDPI dpi)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(dpi);
+        return asyncCallWithArgumentList(QStringLiteral("setDPI"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> setFrameInterpolation(const QString &mode)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(mode);
+        return asyncCallWithArgumentList(QStringLiteral("setFrameInterpolation"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> setLayerProperties(uchar layer, const QString &blendMode, uchar opacity)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(layer) << QVariant::fromValue(blendMode) << QVariant::fromValue(opacity);
+        return asyncCallWithArgumentList(QStringLiteral("setLayerProperties"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> setPollRate(ushort poll_rate)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(poll_rate);
+        return asyncCallWithArgumentList(QStringLiteral("setPollRate"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> setSoftwareBrightness(uchar brightness)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(brightness);
+        return asyncCallWithArgumentList(QStringLiteral("setSoftwareBrightness"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> setTransitionDuration(ushort milliseconds)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(milliseconds);
+        return asyncCallWithArgumentList(QStringLiteral("setTransitionDuration"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> startCustomEffectThread(const QString &effectName)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(effectName);
+        return asyncCallWithArgumentList(QStringLiteral("startCustomEffectThread"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> submitFrame(qlonglong presentationTime, const QByteArray &rgbData)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(presentationTime) << QVariant::fromValue(rgbData);
+        return asyncCallWithArgumentList(QStringLiteral("submitFrame"), argumentList);
+    }
+
+Q_SIGNALS: // SIGNALS
+    void FrameDropped(qlonglong presentationTime);
+    void FramePresented(qlonglong presentationTime, qlonglong lateness);
+    void LightingOwnerChanged(const QString &owner);
+};
+
+namespace io {
+  namespace github {
+    namespace openrazer1 {
+      typedef ::RazerDeviceInterface Device;
+    }
+  }
+}
+#endif
@@ -0,0 +1,169 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QDBusPendingCallWatcher>
+
+#include <chrono>
+
+#include "razerframestream.h"
+#include "../stream/framestreamprotocol.h"
+
+using namespace FrameStream;
+
+// Same clock as the presentation timestamps of the daemon
+static qint64 monotonicTime()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+RazerFrameStream::RazerFrameStream(RazerClientDevice *device, QObject *parent)
+    : QObject(parent)
+    , device(device)
+{
+    socket = new QLocalSocket(this);
+    connect(socket, &QLocalSocket::connected, this, &RazerFrameStream::socketConnected);
+    connect(socket, &QLocalSocket::readyRead, this, &RazerFrameStream::readSocket);
+    connect(socket, static_cast<void (QLocalSocket::*)(QLocalSocket::LocalSocketError)>(&QLocalSocket::error),
+            this, &RazerFrameStream::socketError);
+    connect(device->getProxy(), &RazerDeviceInterface::FramePresented, this, &RazerFrameStream::framePresented);
+    connect(device->getProxy(), &RazerDeviceInterface::FrameDropped, this, &RazerFrameStream::frameDropped);
+}
+
+void RazerFrameStream::open(const QString &socketName)
+{
+    canSend = false;
+    transport = Transport::Socket;
+    buffer.clear();
+    socket->connectToServer(socketName.isEmpty() ? defaultSocketName : socketName);
+}
+
+bool RazerFrameStream::isReady() const
+{
+    return canSend;
+}
+
+RazerFrameStream::Transport RazerFrameStream::getTransport() const
+{
+    return transport;
+}
+
+quint32 RazerFrameStream::submitFrame(const QByteArray &rgbData, qint64 presentationTime, bool requestAck)
+{
+    quint32 sequence = nextSequence++;
+    if (transport == Transport::Socket && canSend) {
+        QByteArray frame;
+        frame.reserve(frameHeaderSize + rgbData.size());
+        appendUInt32(&frame, sequence);
+        appendInt64(&frame, presentationTime);
+        appendUInt8(&frame, requestAck ? RequestAck : 0);
+        frame.append(rgbData);
+        socket->write(encodeMessage(MessageType::Frame, frame));
+        return sequence;
+    }
+
+    // The acks are matched by presentation time, which the daemon would otherwise pick
+    if (presentationTime == 0)
+        presentationTime = monotonicTime();
+    QDBusPendingReply<bool> reply = device->getProxy()->submitFrame(presentationTime, rgbData);
+    if (requestAck) {
+        pendingAcks.insert(presentationTime, sequence);
+        auto *watcher = new QDBusPendingCallWatcher(reply, this);
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, presentationTime, sequence](QDBusPendingCallWatcher *watcher) {
+            QDBusPendingReply<bool> reply = *watcher;
+            watcher->deleteLater();
+            if ((reply.isError() || !reply.value()) && pendingAcks.value(presentationTime) == sequence) {
+                pendingAcks.remove(presentationTime);
+                emit frameFinished(sequence, FrameStatus::Rejected, 0);
+            }
+        });
+    }
+    return sequence;
+}
+
+void RazerFrameStream::socketConnected()
+{
+    QByteArray hello;
+    appendUInt16(&hello, protocolVersion);
+    socket->write(encodeMessage(MessageType::Hello, hello));
+    socket->write(encodeMessage(MessageType::SelectDevice, device->getPath().path().toUtf8()));
+}
+
+void RazerFrameStream::socketError()
+{
+    if (transport != Transport::Socket)
+        return;
+    qWarning("Frame socket not available (%s), using D-Bus.", qUtf8Printable(socket->errorString()));
+    fallBackToDBus();
+}
+
+void RazerFrameStream::readSocket()
+{
+    buffer.append(socket->readAll());
+    MessageType type;
+    QByteArray payload;
+    bool malformed;
+    while (takeMessage(&buffer, &type, &payload, &malformed)) {
+        switch (type) {
+        case MessageType::Welcome:
+            break;
+        case MessageType::DeviceSelected:
+            canSend = true;
+            emit ready();
+            break;
+        case MessageType::Ack:
+            if (payload.size() >= 13)
+                emit frameFinished(readUInt32(payload, 0), static_cast<FrameStatus>(static_cast<quint8>(payload.at(4))), readInt64(payload, 5));
+            break;
+        case MessageType::Error:
+            emit error(QString::fromUtf8(payload));
+            // Without a device the stream can't be used
+            if (!canSend)
+                fallBackToDBus();
+            break;
+        default:
+            break;
+        }
+    }
+    if (malformed) {
+        emit error("Malformed message on the frame socket.");
+        fallBackToDBus();
+    }
+}
+
+void RazerFrameStream::framePresented(qlonglong presentationTime, qlonglong lateness)
+{
+    if (pendingAcks.contains(presentationTime))
+        emit frameFinished(pendingAcks.take(presentationTime), FrameStatus::Presented, lateness);
+}
+
+void RazerFrameStream::frameDropped(qlonglong presentationTime)
+{
+    if (pendingAcks.contains(presentationTime))
+        emit frameFinished(pendingAcks.take(presentationTime), FrameStatus::Dropped, 0);
+}
+
+void RazerFrameStream::fallBackToDBus()
+{
+    transport = Transport::DBus;
+    socket->abort();
+    buffer.clear();
+    if (!canSend) {
+        canSend = true;
+        emit ready();
+    }
+}
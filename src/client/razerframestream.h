@@ -0,0 +1,88 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RAZERFRAMESTREAM_H
+#define RAZERFRAMESTREAM_H
+
+#include <QHash>
+#include <QLocalSocket>
+#include <QObject>
+
+#include "razerclientdevice.h"
+
+/**
+ * Streams custom frames to a device through the fastest transport available.
+ *
+ * The frame socket of the daemon is used if it can be reached, otherwise frames are
+ * sent with submitFrame over the D-Bus connection of the device.
+ */
+class RazerFrameStream : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Transport {
+        Socket,
+        DBus
+    };
+    Q_ENUM(Transport)
+    enum class FrameStatus {
+        Presented,
+        // Superseded by a newer frame that was due at the same time, or another client holds the lighting lease
+        Dropped,
+        Rejected
+    };
+    Q_ENUM(FrameStatus)
+
+    RazerFrameStream(RazerClientDevice *device, QObject *parent = nullptr);
+
+    // An empty socketName uses the default socket of the daemon. ready() is emitted once frames can be sent.
+    void open(const QString &socketName = QString());
+    bool isReady() const;
+    Transport getTransport() const;
+
+    // presentationTime is in microseconds of the monotonic clock (CLOCK_MONOTONIC), 0 shows the frame right away.
+    // Returns the sequence number that frameFinished() reports if an ack was requested.
+    quint32 submitFrame(const QByteArray &rgbData, qint64 presentationTime = 0, bool requestAck = false);
+
+signals:
+    void ready();
+    void frameFinished(quint32 sequence, RazerFrameStream::FrameStatus status, qint64 lateness);
+    void error(const QString &message);
+
+private slots:
+    void socketConnected();
+    void socketError();
+    void readSocket();
+    void framePresented(qlonglong presentationTime, qlonglong lateness);
+    void frameDropped(qlonglong presentationTime);
+
+private:
+    void fallBackToDBus();
+
+    RazerClientDevice *device;
+    QLocalSocket *socket;
+    QByteArray buffer;
+    Transport transport = Transport::DBus;
+    bool canSend = false;
+    quint32 nextSequence = 0;
+    // Sequence numbers of frames sent over D-Bus that wait for an ack, by presentation time
+    QHash<qint64, quint32> pendingAcks;
+};
+
+#endif // RAZERFRAMESTREAM_H
@@ -0,0 +1,25 @@
+/*
+ * This file was generated by qdbusxml2cpp version 0.8
+ * Command line was: qdbusxml2cpp razerled.xml -p razerledinterface.h:razerledinterface.cpp -c RazerLEDInterface -i razer_test.h
+ *
+ * qdbusxml2cpp is Copyright (C) 2017 The Qt Company Ltd.
+ *
+ * This is an auto-generated file.
+ * Do not edit! All changes made to it will be lost.
+ */
+
+#include "razerledinterface.h"
+
+/*
+ * Implementation of interface class RazerLEDInterface
+ */
+
+RazerLEDInterface::RazerLEDInterface(const QString &service, const QString &path, const QDBusConnection &connection, QObject *parent)
+    : QDBusAbstractInterface(service, path, staticInterfaceName(), connection, parent)
+{
+}
+
+RazerLEDInterface::~RazerLEDInterface()
+{
+}
+
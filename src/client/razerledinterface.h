@@ -0,0 +1,140 @@
+/*
+ * This file was generated by qdbusxml2cpp version 0.8
+ * Command line was: qdbusxml2cpp razerled.xml -p razerledinterface.h:razerledinterface.cpp -c RazerLEDInterface -i razer_test.h
+ *
+ * qdbusxml2cpp is Copyright (C) 2017 The Qt Company Ltd.
+ *
+ * This is an auto-generated file.
+ * Do not edit! All changes made to it will be lost.
+ */
+
+#ifndef RAZERLEDINTERFACE_H
+#define RAZERLEDINTERFACE_H
+
+#include <QtCore/QObject>
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QMap>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+#include <QtDBus/QtDBus>
+#include "razer_test.h"
+using namespace razer_test;
+
+/*
+ * Proxy class for interface io.github.openrazer1.Led
+ */
+class RazerLEDInterface: public QDBusAbstractInterface
+{
+    Q_OBJECT
+public:
+    static inline const char *staticInterfaceName()
+    { return "io.github.openrazer1.Led"; }
+
+public:
+    RazerLEDInterface(const QString &service, const QString &path, const QDBusConnection &connection, QObject *parent = nullptr);
+
+    ~RazerLEDInterface();
+
+    Q_PROPERTY(uchar Brightness READ brightness)
+    inline uchar brightness() const
+    { return qvariant_cast< uchar >(property("Brightness")); }
+
+    Q_PROPERTY(QList<RGB> CurrentColors READ currentColors)
+    inline QList<RGB> currentColors() const
+    { return qvariant_cast< QList<RGB> >(property("CurrentColors")); }
+
+    Q_PROPERTY(RazerEffect CurrentEffect READ currentEffect)
+    inline RazerEffect currentEffect() const
+    { return qvariant_cast< RazerEffect >(property("CurrentEffect")); }
+
+    Q_PROPERTY(RazerLedId LedId READ ledId)
+    inline RazerLedId ledId() const
+    { return qvariant_cast< RazerLedId >(property("LedId")); }
+
+public Q_SLOTS: // METHODS
+    inline QDBusPendingReply<uchar> getBrightness()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("getBrightness"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> setBlinking(razer_test::RGB color)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(color);
+        return asyncCallWithArgumentList(QStringLiteral("setBlinking"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> setBreathing(razer_test::RGB color)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(color);
+        return asyncCallWithArgumentList(QStringLiteral("setBreathing"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> setBreathingDual(razer_test::RGB color, razer_test::RGB color2)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(color) << QVariant::fromValue(color2);
+        return asyncCallWithArgumentList(QStringLiteral("setBreathingDual"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> setBreathingRandom()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("setBreathingRandom"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> setBrightness(uchar brightness)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(brightness);
+        return asyncCallWithArgumentList(QStringLiteral("setBrightness"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> setNone()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("setNone"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> setReactive(razer_test::ReactiveSpeed speed, razer_test::RGB color)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(speed) << QVariant::fromValue(color);
+        return asyncCallWithArgumentList(QStringLiteral("setReactive"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> setSpectrum()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("setSpectrum"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> setStatic(razer_test::RGB color)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(color);
+        return asyncCallWithArgumentList(QStringLiteral("setStatic"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> setWave(razer_test::WaveDirection direction)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(direction);
+        return asyncCallWithArgumentList(QStringLiteral("setWave"), argumentList);
+    }
+
+Q_SIGNALS: // SIGNALS
+};
+
+namespace io {
+  namespace github {
+    namespace openrazer1 {
+      typedef ::RazerLEDInterface Led;
+    }
+  }
+}
+#endif
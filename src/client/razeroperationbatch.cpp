@@ -0,0 +1,114 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "razeroperationbatch.h"
+
+void RazerOperationBatch::add(const QDBusObjectPath &object, const QString &method, const QVariantList &arguments)
+{
+    operations.append({object, method, arguments});
+}
+
+void RazerOperationBatch::setNone(const QDBusObjectPath &led)
+{
+    add(led, "setNone");
+}
+
+void RazerOperationBatch::setStatic(const QDBusObjectPath &led, RGB color)
+{
+    add(led, "setStatic", {QVariant::fromValue(color)});
+}
+
+void RazerOperationBatch::setBreathing(const QDBusObjectPath &led, RGB color)
+{
+    add(led, "setBreathing", {QVariant::fromValue(color)});
+}
+
+void RazerOperationBatch::setBreathingDual(const QDBusObjectPath &led, RGB color, RGB color2)
+{
+    add(led, "setBreathingDual", {QVariant::fromValue(color), QVariant::fromValue(color2)});
+}
+
+void RazerOperationBatch::setBreathingRandom(const QDBusObjectPath &led)
+{
+    add(led, "setBreathingRandom");
+}
+
+void RazerOperationBatch::setBlinking(const QDBusObjectPath &led, RGB color)
+{
+    add(led, "setBlinking", {QVariant::fromValue(color)});
+}
+
+void RazerOperationBatch::setSpectrum(const QDBusObjectPath &led)
+{
+    add(led, "setSpectrum");
+}
+
+void RazerOperationBatch::setWave(const QDBusObjectPath &led, WaveDirection direction)
+{
+    add(led, "setWave", {QVariant::fromValue(direction)});
+}
+
+void RazerOperationBatch::setReactive(const QDBusObjectPath &led, ReactiveSpeed speed, RGB color)
+{
+    add(led, "setReactive", {QVariant::fromValue(speed), QVariant::fromValue(color)});
+}
+
+void RazerOperationBatch::setBrightness(const QDBusObjectPath &led, uchar brightness)
+{
+    add(led, "setBrightness", {QVariant::fromValue(brightness)});
+}
+
+void RazerOperationBatch::setDPI(const QDBusObjectPath &device, RazerDPI dpi)
+{
+    add(device, "setDPI", {QVariant::fromValue(dpi)});
+}
+
+void RazerOperationBatch::setPollRate(const QDBusObjectPath &device, ushort pollRate)
+{
+    add(device, "setPollRate", {QVariant::fromValue(pollRate)});
+}
+
+QList<RazerOperation> RazerOperationBatch::getOperations() const
+{
+    return operations;
+}
+
+int RazerOperationBatch::size() const
+{
+    return operations.size();
+}
+
+bool RazerOperationBatch::isEmpty() const
+{
+    return operations.isEmpty();
+}
+
+void RazerOperationBatch::clear()
+{
+    operations.clear();
+}
+
+QDBusPendingReply<QList<RazerOperationResult>> RazerOperationBatch::apply(DeviceManagerInterface *manager) const
+{
+    return manager->applyBatch(operations);
+}
+
+QDBusPendingReply<bool> RazerOperationBatch::defineScene(DeviceManagerInterface *manager, const QString &name) const
+{
+    return manager->defineScene(name, operations);
+}
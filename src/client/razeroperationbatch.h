@@ -0,0 +1,63 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RAZEROPERATIONBATCH_H
+#define RAZEROPERATIONBATCH_H
+
+#include <QList>
+
+#include "devicemanagerinterface.h"
+
+/**
+ * Collects LED and device operations to send them in one call.
+ *
+ * apply() runs them with Manager.applyBatch, which sends the reports of all devices
+ * in parallel. defineScene() stores them on the daemon to be applied later.
+ */
+class RazerOperationBatch
+{
+public:
+    void add(const QDBusObjectPath &object, const QString &method, const QVariantList &arguments = QVariantList());
+
+    void setNone(const QDBusObjectPath &led);
+    void setStatic(const QDBusObjectPath &led, RGB color);
+    void setBreathing(const QDBusObjectPath &led, RGB color);
+    void setBreathingDual(const QDBusObjectPath &led, RGB color, RGB color2);
+    void setBreathingRandom(const QDBusObjectPath &led);
+    void setBlinking(const QDBusObjectPath &led, RGB color);
+    void setSpectrum(const QDBusObjectPath &led);
+    void setWave(const QDBusObjectPath &led, WaveDirection direction);
+    void setReactive(const QDBusObjectPath &led, ReactiveSpeed speed, RGB color);
+    void setBrightness(const QDBusObjectPath &led, uchar brightness);
+    void setDPI(const QDBusObjectPath &device, RazerDPI dpi);
+    void setPollRate(const QDBusObjectPath &device, ushort pollRate);
+
+    QList<RazerOperation> getOperations() const;
+    int size() const;
+    bool isEmpty() const;
+    void clear();
+
+    // One result per operation, in the order they were added
+    QDBusPendingReply<QList<RazerOperationResult>> apply(DeviceManagerInterface *manager) const;
+    QDBusPendingReply<bool> defineScene(DeviceManagerInterface *manager, const QString &name) const;
+
+private:
+    QList<RazerOperation> operations;
+};
+
+#endif // RAZEROPERATIONBATCH_H
@@ -0,0 +1,86 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+
+#include "razerpropertycache.h"
+
+RazerPropertyCache::RazerPropertyCache(const QDBusConnection &connection, const QString &service, const QString &path, const QString &interface, QObject *parent)
+    : QObject(parent)
+    , connection(connection)
+    , service(service)
+    , path(path)
+    , interface(interface)
+{
+    this->connection.connect(service, path, "org.freedesktop.DBus.Properties", "PropertiesChanged",
+                             this, SLOT(propertiesChanged(QString, QVariantMap, QStringList)));
+}
+
+void RazerPropertyCache::refresh()
+{
+    QDBusMessage message = QDBusMessage::createMethodCall(service, path, "org.freedesktop.DBus.Properties", "GetAll");
+    message << interface;
+    changedSinceRefresh.clear();
+    auto *watcher = new QDBusPendingCallWatcher(connection.asyncCall(message), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, &RazerPropertyCache::getAllFinished);
+}
+
+bool RazerPropertyCache::isLoaded() const
+{
+    return hasProperties;
+}
+
+QVariant RazerPropertyCache::value(const QString &name) const
+{
+    return properties.value(name);
+}
+
+void RazerPropertyCache::getAllFinished(QDBusPendingCallWatcher *watcher)
+{
+    QDBusPendingReply<QVariantMap> reply = *watcher;
+    watcher->deleteLater();
+    if (reply.isError()) {
+        qWarning("Failed to get the properties of %s: %s", qUtf8Printable(path), qUtf8Printable(reply.error().message()));
+        return;
+    }
+    QVariantMap all = reply.value();
+    for (auto it = all.constBegin(); it != all.constEnd(); ++it) {
+        if (!changedSinceRefresh.contains(it.key()))
+            properties.insert(it.key(), it.value());
+    }
+    hasProperties = true;
+    emit loaded();
+}
+
+void RazerPropertyCache::propertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated)
+{
+    if (interface != this->interface)
+        return;
+    for (auto it = changed.constBegin(); it != changed.constEnd(); ++it) {
+        properties.insert(it.key(), it.value());
+        changedSinceRefresh.insert(it.key());
+        emit propertyChanged(it.key());
+    }
+    foreach (const QString &name, invalidated) {
+        properties.remove(name);
+        changedSinceRefresh.insert(name);
+        emit propertyChanged(name);
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RAZERPROPERTYCACHE_H
+#define RAZERPROPERTYCACHE_H
+
+#include <QDBusArgument>
+#include <QDBusConnection>
+#include <QObject>
+#include <QSet>
+#include <QVariantMap>
+
+class QDBusPendingCallWatcher;
+
+/**
+ * Local copy of the properties of one D-Bus object.
+ *
+ * All properties are fetched with one asynchronous GetAll and kept up to date
+ * from PropertiesChanged, so reading them never blocks on the daemon.
+ */
+class RazerPropertyCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    RazerPropertyCache(const QDBusConnection &connection, const QString &service, const QString &path, const QString &interface, QObject *parent = nullptr);
+
+    // Fetches all properties again, loaded() is emitted when they arrived
+    void refresh();
+    bool isLoaded() const;
+
+    QVariant value(const QString &name) const;
+    template<typename T>
+    T value(const QString &name) const
+    {
+        QVariant variant = value(name);
+        // Types that aren't built into D-Bus arrive still marshalled
+        if (variant.userType() == qMetaTypeId<QDBusArgument>())
+            return qdbus_cast<T>(variant);
+        return qvariant_cast<T>(variant);
+    }
+
+signals:
+    void loaded();
+    void propertyChanged(const QString &name);
+
+private slots:
+    void getAllFinished(QDBusPendingCallWatcher *watcher);
+    void propertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated);
+
+private:
+    QDBusConnection connection;
+    QString service;
+    QString path;
+    QString interface;
+    QVariantMap properties;
+    // Changes that arrived while GetAll was pending are newer than its reply
+    QSet<QString> changedSinceRefresh;
+    bool hasProperties = false;
+};
+
+#endif // RAZERPROPERTYCACHE_H
@@ -0,0 +1,57 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "animationeffect.h"
+
+AnimationEffect::AnimationEffect(AnimationFile *animation, bool loop) : CustomEffectBase(animation->width(), animation->height()), animation(animation), loop(loop)
+{
+}
+
+bool AnimationEffect::initialize()
+{
+    position = 0;
+    finished = false;
+    current.resize(width, height);
+    msleep = animation->frameDuration(0);
+    return true;
+}
+
+void AnimationEffect::prepareRgbData(CustomFrame &frame)
+{
+    // Delta frames build on the previous one, so decode into our own frame and share it
+    if (!animation->decodeNextFrame(position, current)) {
+        finished = true;
+        return;
+    }
+    frame = current;
+
+    // msleep is the time this frame stays on screen
+    msleep = animation->frameDuration(position);
+    position++;
+    if (position == animation->frameCount()) {
+        if (loop)
+            position = 0;
+        else
+            finished = true;
+    }
+}
+
+bool AnimationEffect::isStatic() const
+{
+    return finished;
+}
@@ -0,0 +1,49 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ANIMATIONEFFECT_H
+#define ANIMATIONEFFECT_H
+
+#include <QScopedPointer>
+
+#include "animationfile.h"
+#include "customeffectbase.h"
+
+/**
+ * Plays back an AnimationFile with the timing stored in the file.
+ */
+class AnimationEffect : public CustomEffectBase
+{
+public:
+    // Takes ownership of the opened file, which has to match the dimensions
+    AnimationEffect(AnimationFile *animation, bool loop);
+
+    bool initialize() override;
+    void prepareRgbData(CustomFrame &frame) override;
+    // Once the last frame of a non-looping animation was shown it stays on screen
+    bool isStatic() const override;
+
+private:
+    QScopedPointer<AnimationFile> animation;
+    const bool loop;
+    int position;
+    bool finished;
+    CustomFrame current;
+};
+
+#endif // ANIMATIONEFFECT_H
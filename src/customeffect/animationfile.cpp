@@ -0,0 +1,314 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtEndian>
+
+#include <climits>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "animationfile.h"
+
+static const char magic[4] = {'R', 'Z', 'A', 'N'};
+static const ushort formatVersion = 1;
+// Animations are read into memory as a whole, larger files are refused
+static const qint64 maxFileSize = 64 * 1024 * 1024;
+
+AnimationFile::~AnimationFile()
+{
+    close();
+}
+
+bool AnimationFile::open(const QString &path)
+{
+    close();
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning("Failed to open animation %s: %s", qUtf8Printable(path), qUtf8Printable(file.errorString()));
+        return false;
+    }
+    return load(file, path);
+}
+
+bool AnimationFile::open(int fd)
+{
+    close();
+    // Reading from a pipe or socket could block the daemon for as long as the client wants
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        qWarning("Animation from file descriptor %i is not a regular file.", fd);
+        return false;
+    }
+    int copy = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    QFile file;
+    if (copy < 0 || !file.open(copy, QIODevice::ReadOnly, QFileDevice::AutoCloseHandle)) {
+        qWarning("Failed to open animation from file descriptor %i.", fd);
+        if (copy >= 0)
+            ::close(copy);
+        return false;
+    }
+    return load(file, QString("file descriptor %1").arg(fd));
+}
+
+bool AnimationFile::load(QFile &file, const QString &name)
+{
+    // A private copy, whoever owns the file may change or truncate it while it is played
+    if (!file.seek(0)) {
+        qWarning("Failed to read animation %s.", qUtf8Printable(name));
+        return false;
+    }
+    contents = file.read(maxFileSize + 1);
+    if (contents.size() > maxFileSize) {
+        qWarning("Animation %s is larger than %lld bytes.", qUtf8Printable(name), maxFileSize);
+        close();
+        return false;
+    }
+    data = reinterpret_cast<const uchar *>(contents.constData());
+    size = contents.size();
+    if (size < headerSize || !parse()) {
+        qWarning("%s is not a valid animation.", qUtf8Printable(name));
+        close();
+        return false;
+    }
+    return true;
+}
+
+void AnimationFile::close()
+{
+    contents.clear();
+    data = nullptr;
+    size = 0;
+    widthValue = 0;
+    heightValue = 0;
+    offsets.clear();
+}
+
+bool AnimationFile::isOpen() const
+{
+    return data != nullptr;
+}
+
+uchar AnimationFile::width() const
+{
+    return widthValue;
+}
+
+uchar AnimationFile::height() const
+{
+    return heightValue;
+}
+
+int AnimationFile::frameCount() const
+{
+    return offsets.size();
+}
+
+ushort AnimationFile::frameDuration(int index) const
+{
+    return qFromLittleEndian<quint16>(frameRecord(index));
+}
+
+ushort AnimationFile::minFrameDuration() const
+{
+    ushort duration = 0xFFFF;
+    for (int i = 0; i < frameCount(); i++)
+        duration = qMin(duration, frameDuration(i));
+    return duration;
+}
+
+// Reads the header and the index, and checks every frame record once
+bool AnimationFile::parse()
+{
+    if (memcmp(data, magic, sizeof(magic)) != 0 || qFromLittleEndian<quint16>(data + 4) != formatVersion)
+        return false;
+    widthValue = data[6];
+    heightValue = data[7];
+    if (widthValue == 0 || heightValue == 0)
+        return false;
+
+    const quint32 frames = qFromLittleEndian<quint32>(data + 8);
+    const quint32 indexOffset = qFromLittleEndian<quint32>(data + 12);
+    if (frames == 0 || frames > INT_MAX / 4 || indexOffset < headerSize || indexOffset + static_cast<qint64>(frames) * 4 > size)
+        return false;
+
+    const qint64 keyframeSize = widthValue * heightValue * 3;
+    offsets.resize(static_cast<int>(frames));
+    for (quint32 i = 0; i < frames; i++) {
+        const quint32 offset = qFromLittleEndian<quint32>(data + indexOffset + i * 4);
+        if (offset < headerSize || offset + static_cast<qint64>(frameHeaderSize) > size)
+            return false;
+        // A frame without duration would make the effect thread spin
+        if (qFromLittleEndian<quint16>(data + offset) == 0)
+            return false;
+        const uchar type = data[offset + 2];
+        const quint32 payloadSize = qFromLittleEndian<quint32>(data + offset + 4);
+        if (offset + static_cast<qint64>(frameHeaderSize) + payloadSize > size)
+            return false;
+        if (type == Keyframe && payloadSize != keyframeSize)
+            return false;
+        if (type != Keyframe && (type != Delta || i == 0))
+            return false;
+        offsets[static_cast<int>(i)] = offset;
+    }
+    return true;
+}
+
+const uchar *AnimationFile::frameRecord(int index) const
+{
+    return data + offsets.at(index);
+}
+
+bool AnimationFile::isKeyframe(int index) const
+{
+    return frameRecord(index)[2] == Keyframe;
+}
+
+bool AnimationFile::decodeNextFrame(int index, CustomFrame &frame) const
+{
+    if (index < 0 || index >= frameCount() || frame.width() != width() || frame.height() != height())
+        return false;
+
+    const uchar *record = frameRecord(index);
+    const quint32 payloadSize = qFromLittleEndian<quint32>(record + 4);
+    if (offsets.at(index) + static_cast<qint64>(frameHeaderSize) + payloadSize > size) {
+        qWarning("Corrupt frame %d in animation.", index);
+        return false;
+    }
+    const uchar *payload = record + frameHeaderSize;
+    const uchar *end = payload + payloadSize;
+    uchar *dst = frame.data();
+
+    if (record[2] == Keyframe) {
+        if (payloadSize != static_cast<quint32>(frame.size())) {
+            qWarning("Corrupt keyframe %d in animation.", index);
+            return false;
+        }
+        memcpy(dst, payload, payloadSize);
+        return true;
+    }
+
+    const int pixels = width() * height();
+    int position = 0;
+    while (end - payload >= 4) {
+        position += qFromLittleEndian<quint16>(payload);
+        const int count = qFromLittleEndian<quint16>(payload + 2);
+        payload += 4;
+        if (position + count > pixels || end - payload < count * 3) {
+            qWarning("Corrupt delta frame %d in animation.", index);
+            return false;
+        }
+        memcpy(dst + position * 3, payload, count * 3);
+        payload += count * 3;
+        position += count;
+    }
+    return true;
+}
+
+bool AnimationFile::decodeFrame(int index, CustomFrame &frame) const
+{
+    if (index < 0 || index >= frameCount())
+        return false;
+
+    int keyframe = index;
+    while (!isKeyframe(keyframe))
+        keyframe--;
+    for (int i = keyframe; i <= index; i++) {
+        if (!decodeNextFrame(i, frame))
+            return false;
+    }
+    return true;
+}
+
+static void appendFrameHeader(QByteArray &out, ushort duration, uchar type, quint32 payloadSize)
+{
+    uchar header[8];
+    qToLittleEndian<quint16>(duration, header);
+    header[2] = type;
+    header[3] = 0;
+    qToLittleEndian<quint32>(payloadSize, header + 4);
+    out.append(reinterpret_cast<const char *>(header), sizeof(header));
+}
+
+QByteArray AnimationFile::encode(const QVector<CustomFrame> &frames, const QVector<ushort> &durations, int keyframeInterval)
+{
+    Q_ASSERT(!frames.isEmpty() && frames.size() == durations.size());
+    const uchar w = frames.first().width();
+    const uchar h = frames.first().height();
+    const int pixels = w * h;
+
+    QByteArray out(headerSize, '\0');
+    memcpy(out.data(), magic, sizeof(magic));
+    qToLittleEndian<quint16>(formatVersion, reinterpret_cast<uchar *>(out.data()) + 4);
+    out[6] = static_cast<char>(w);
+    out[7] = static_cast<char>(h);
+    qToLittleEndian<quint32>(frames.size(), reinterpret_cast<uchar *>(out.data()) + 8);
+
+    QVector<quint32> index;
+    for (int i = 0; i < frames.size(); i++) {
+        const CustomFrame &frame = frames.at(i);
+        Q_ASSERT(frame.width() == w && frame.height() == h);
+        index.append(out.size());
+
+        QByteArray delta;
+        bool keyframe = i % keyframeInterval == 0;
+        if (!keyframe) {
+            const uchar *prev = frames.at(i - 1).constData();
+            const uchar *cur = frame.constData();
+            int runEnd = 0;
+            int p = 0;
+            while (p < pixels) {
+                if (memcmp(prev + p * 3, cur + p * 3, 3) == 0) {
+                    p++;
+                    continue;
+                }
+                // Extend the run until two unchanged pixels in a row, a single one is cheaper to copy than a new run
+                int start = p;
+                while (p < pixels && p - start < 0xFFFF
+                       && (memcmp(prev + p * 3, cur + p * 3, 3) != 0
+                           || (p + 1 < pixels && memcmp(prev + (p + 1) * 3, cur + (p + 1) * 3, 3) != 0)))
+                    p++;
+                uchar run[4];
+                qToLittleEndian<quint16>(start - runEnd, run);
+                qToLittleEndian<quint16>(p - start, run + 2);
+                delta.append(reinterpret_cast<const char *>(run), sizeof(run));
+                delta.append(reinterpret_cast<const char *>(cur + start * 3), (p - start) * 3);
+                runEnd = p;
+            }
+            keyframe = delta.size() >= pixels * 3;
+        }
+
+        if (keyframe) {
+            appendFrameHeader(out, durations.at(i), Keyframe, pixels * 3);
+            out.append(reinterpret_cast<const char *>(frame.constData()), pixels * 3);
+        } else {
+            appendFrameHeader(out, durations.at(i), Delta, delta.size());
+            out.append(delta);
+        }
+    }
+
+    qToLittleEndian<quint32>(out.size(), reinterpret_cast<uchar *>(out.data()) + 12);
+    for (quint32 offset : index) {
+        uchar entry[4];
+        qToLittleEndian<quint32>(offset, entry);
+        out.append(reinterpret_cast<const char *>(entry), sizeof(entry));
+    }
+    return out;
+}
@@ -0,0 +1,102 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ANIMATIONFILE_H
+#define ANIMATIONFILE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+#include "customframe.h"
+
+/**
+ * Precompiled animation, read into memory when it is opened.
+ *
+ * All numbers are little endian.
+ *
+ * Header (16 bytes):
+ *   char[4] magic "RZAN"
+ *   u16     version (1)
+ *   u8      width
+ *   u8      height
+ *   u32     number of frames
+ *   u32     offset of the index
+ *
+ * Frame:
+ *   u16     duration in milliseconds, at least 1
+ *   u8      type, 0 = keyframe, 1 = delta
+ *   u8      reserved
+ *   u32     payload size
+ *   payload keyframe: width * height * 3 bytes of RGB data
+ *           delta: runs of {u16 unchanged pixels, u16 pixel count, count * 3 bytes RGB}
+ *           applied to the previous frame
+ *
+ * Index: u32 offset of every frame, so any frame can be found without
+ * decoding the ones before its keyframe. The first frame is always a keyframe.
+ */
+class AnimationFile
+{
+public:
+    ~AnimationFile();
+
+    // Returns false and leaves the object closed if the file is not a valid animation
+    bool open(const QString &path);
+    // Maps a copy of fd, the caller keeps its own descriptor
+    bool open(int fd);
+    void close();
+    bool isOpen() const;
+
+    uchar width() const;
+    uchar height() const;
+    int frameCount() const;
+    ushort frameDuration(int index) const;
+    ushort minFrameDuration() const;
+
+    // Apply the frame at index to frame, which has to contain the previous frame if index is a delta frame
+    bool decodeNextFrame(int index, CustomFrame &frame) const;
+    // Decode the frame at index from scratch, starting from the keyframe before it
+    bool decodeFrame(int index, CustomFrame &frame) const;
+
+    static QByteArray encode(const QVector<CustomFrame> &frames, const QVector<ushort> &durations, int keyframeInterval = 30);
+
+private:
+    enum FrameType : uchar {
+        Keyframe = 0,
+        Delta = 1
+    };
+
+    static const int headerSize = 16;
+    static const int frameHeaderSize = 8;
+
+    bool load(QFile &file, const QString &name);
+    bool parse();
+    const uchar *frameRecord(int index) const;
+    bool isKeyframe(int index) const;
+
+    QByteArray contents;
+    const uchar *data = nullptr;
+    qint64 size = 0;
+    uchar widthValue = 0;
+    uchar heightValue = 0;
+    // Offsets of the frame records, copied from the index
+    QVector<quint32> offsets;
+};
+
+#endif // ANIMATIONFILE_H
@@ -0,0 +1,106 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+
+#include "colorcorrection.h"
+
+ColorCorrection::ColorCorrection()
+{
+    rebuild();
+}
+
+void ColorCorrection::setGamma(double gamma)
+{
+    gammaValue = gamma;
+    rebuild();
+}
+
+void ColorCorrection::setWhiteBalance(double red, double green, double blue)
+{
+    gains[0] = qBound(0.0, red, 1.0);
+    gains[1] = qBound(0.0, green, 1.0);
+    gains[2] = qBound(0.0, blue, 1.0);
+    rebuild();
+}
+
+void ColorCorrection::setBrightness(uchar brightness)
+{
+    brightnessValue = brightness;
+    rebuild();
+}
+
+double ColorCorrection::gamma() const
+{
+    return gammaValue;
+}
+
+uchar ColorCorrection::brightness() const
+{
+    return brightnessValue;
+}
+
+bool ColorCorrection::isIdentity() const
+{
+    return path == Path::Identity;
+}
+
+void ColorCorrection::rebuild()
+{
+    for (int c = 0; c < 3; c++) {
+        const double gain = gains[c] * brightnessValue / 255.0;
+        for (int i = 0; i < 256; i++)
+            table[c][i] = static_cast<uchar>(std::lround(std::pow(i / 255.0, gammaValue) * gain * 255.0));
+    }
+    factors = {static_cast<uchar>(std::lround(gains[0] * brightnessValue)),
+               static_cast<uchar>(std::lround(gains[1] * brightnessValue)),
+               static_cast<uchar>(std::lround(gains[2] * brightnessValue))
+              };
+
+    if (gammaValue != 1.0)
+        path = Path::Table;
+    else if (factors.red != 0xFF || factors.green != 0xFF || factors.blue != 0xFF)
+        path = Path::Scale;
+    else
+        path = Path::Identity;
+}
+
+void ColorCorrection::apply(uchar *rgb, int pixels) const
+{
+    switch (path) {
+    case Path::Identity:
+        break;
+    case Path::Scale:
+        scaleRgbChannels(rgb, pixels, factors);
+        break;
+    case Path::Table:
+        for (int i = 0; i < pixels; i++) {
+            rgb[i * 3] = table[0][rgb[i * 3]];
+            rgb[i * 3 + 1] = table[1][rgb[i * 3 + 1]];
+            rgb[i * 3 + 2] = table[2][rgb[i * 3 + 2]];
+        }
+        break;
+    }
+}
+
+RGBval ColorCorrection::apply(RGBval color) const
+{
+    uchar rgb[3] = {color.red, color.green, color.blue};
+    apply(rgb, 1);
+    return {rgb[0], rgb[1], rgb[2]};
+}
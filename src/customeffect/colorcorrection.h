@@ -0,0 +1,68 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLORCORRECTION_H
+#define COLORCORRECTION_H
+
+#include "colorkernels.h"
+
+/**
+ * Output stage that makes colors look the same across devices.
+ *
+ * Gamma, white balance and software brightness are folded into one lookup
+ * table per channel, which is only rebuilt when a setting changes. Without
+ * gamma the correction is a plain per-channel scale and uses the vectorized
+ * kernel instead of the table.
+ */
+class ColorCorrection
+{
+public:
+    ColorCorrection();
+
+    // out = in ^ gamma, on values normalized to 0-1
+    void setGamma(double gamma);
+    // Gain of each channel, 0-1
+    void setWhiteBalance(double red, double green, double blue);
+    void setBrightness(uchar brightness);
+
+    double gamma() const;
+    uchar brightness() const;
+
+    bool isIdentity() const;
+    void apply(uchar *rgb, int pixels) const;
+    RGBval apply(RGBval color) const;
+
+private:
+    void rebuild();
+
+    enum class Path {
+        Identity,
+        Scale,
+        Table
+    };
+
+    double gammaValue = 1.0;
+    double gains[3] = {1.0, 1.0, 1.0};
+    uchar brightnessValue = 0xFF;
+
+    Path path = Path::Identity;
+    RGBval factors = {0xFF, 0xFF, 0xFF};
+    uchar table[3][256];
+};
+
+#endif // COLORCORRECTION_H
@@ -0,0 +1,572 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+
+#include "colorkernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define COLORKERNELS_X86
+#include <immintrin.h>
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+/* --------------------- SCALAR --------------------- */
+
+// x / 255, rounded to nearest. Exact for 0 <= x <= 255 * 255.
+static inline uchar div255(uint x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+static void fillScalar(uchar *dst, int pixels, RGBval color)
+{
+    for (int i = 0; i < pixels; i++) {
+        dst[i * 3] = color.red;
+        dst[i * 3 + 1] = color.green;
+        dst[i * 3 + 2] = color.blue;
+    }
+}
+
+static inline void gradientScalar(uchar *dst, int pixels, RGBval from, RGBval to)
+{
+    if (pixels == 1) {
+        fillScalar(dst, 1, from);
+        return;
+    }
+    const int last = pixels - 1;
+    for (int i = 0; i < pixels; i++) {
+        dst[i * 3] = (from.red * (last - i) + to.red * i + last / 2) / last;
+        dst[i * 3 + 1] = (from.green * (last - i) + to.green * i + last / 2) / last;
+        dst[i * 3 + 2] = (from.blue * (last - i) + to.blue * i + last / 2) / last;
+    }
+}
+
+static inline void hsvToRgbScalar(uchar *dst, const uchar *hsv, int pixels)
+{
+    for (int i = 0; i < pixels; i++) {
+        const uint h = hsv[i * 3], s = hsv[i * 3 + 1], v = hsv[i * 3 + 2];
+        // Six regions of 43 hue steps each, remainder scaled to 0-255
+        const uint region = h / 43;
+        const uint remainder = (h - region * 43) * 6;
+        const uchar p = div255(v * (255 - s));
+        const uchar q = div255(v * (255 - div255(s * remainder)));
+        const uchar t = div255(v * (255 - div255(s * (255 - remainder))));
+        // Written as selects instead of a switch so the loop can be vectorized
+        dst[i * 3] = (region == 0 || region == 5) ? v : region == 1 ? q : region == 4 ? t : p;
+        dst[i * 3 + 1] = region == 0 ? t : (region == 1 || region == 2) ? v : region == 3 ? q : p;
+        dst[i * 3 + 2] = region == 2 ? t : (region == 3 || region == 4) ? v : region == 5 ? q : p;
+    }
+}
+
+// Blending and scaling don't care about pixel boundaries, the vector versions use these for the tail bytes
+static inline void blendBytes(uchar *dst, const uchar *src, int bytes, uchar alpha)
+{
+    for (int i = 0; i < bytes; i++)
+        dst[i] = div255(src[i] * alpha + dst[i] * (255 - alpha));
+}
+
+static inline void scaleBytes(uchar *dst, int bytes, uchar factor)
+{
+    for (int i = 0; i < bytes; i++)
+        dst[i] = div255(dst[i] * factor);
+}
+
+static inline uchar blendModeByte(BlendMode mode, uint d, uint s)
+{
+    switch (mode) {
+    case BlendMode::Add:
+        return d + s > 255 ? 255 : d + s;
+    case BlendMode::Multiply:
+        return div255(d * s);
+    case BlendMode::Screen:
+        return d + s - div255(d * s);
+    default:
+        return s;
+    }
+}
+
+static inline void compositeBytes(uchar *dst, const uchar *src, const uchar *mask, int bytes, BlendMode mode, uchar opacity)
+{
+    for (int i = 0; i < bytes; i++) {
+        const uint a = mask != nullptr ? div255(mask[i] * opacity) : opacity;
+        dst[i] = div255(blendModeByte(mode, dst[i], src[i]) * a + dst[i] * (255 - a));
+    }
+}
+
+static void blendScalar(uchar *dst, const uchar *src, int pixels, uchar alpha)
+{
+    blendBytes(dst, src, pixels * 3, alpha);
+}
+
+static void scaleScalar(uchar *dst, int pixels, uchar factor)
+{
+    scaleBytes(dst, pixels * 3, factor);
+}
+
+static void scaleChannelsScalar(uchar *dst, int pixels, RGBval factors)
+{
+    for (int i = 0; i < pixels; i++) {
+        dst[i * 3] = div255(dst[i * 3] * factors.red);
+        dst[i * 3 + 1] = div255(dst[i * 3 + 1] * factors.green);
+        dst[i * 3 + 2] = div255(dst[i * 3 + 2] * factors.blue);
+    }
+}
+
+static void compositeScalar(uchar *dst, const uchar *src, const uchar *mask, int pixels, BlendMode mode, uchar opacity)
+{
+    compositeBytes(dst, src, mask, pixels * 3, mode, opacity);
+}
+
+static const ColorKernelTable scalarTable = {
+    "scalar",
+    fillScalar,
+    gradientScalar,
+    hsvToRgbScalar,
+    blendScalar,
+    scaleScalar,
+    scaleChannelsScalar,
+    compositeScalar
+};
+
+#ifdef COLORKERNELS_X86
+
+/* --------------------- SSE2 --------------------- */
+
+TARGET_SSE2 static inline __m128i div255Sse2(__m128i x)
+{
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+TARGET_SSE2 static void fillSse2(uchar *dst, int pixels, RGBval color)
+{
+    // 16 pixels are exactly three vectors
+    uchar pattern[48];
+    fillScalar(pattern, 16, color);
+    const __m128i p0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern));
+    const __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern + 16));
+    const __m128i p2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern + 32));
+
+    int i = 0;
+    for (; i + 16 <= pixels; i += 16) {
+        __m128i *out = reinterpret_cast<__m128i *>(dst + i * 3);
+        _mm_storeu_si128(out, p0);
+        _mm_storeu_si128(out + 1, p1);
+        _mm_storeu_si128(out + 2, p2);
+    }
+    fillScalar(dst + i * 3, pixels - i, color);
+}
+
+TARGET_SSE2 static void gradientSse2(uchar *dst, int pixels, RGBval from, RGBval to)
+{
+    gradientScalar(dst, pixels, from, to);
+}
+
+TARGET_SSE2 static void hsvToRgbSse2(uchar *dst, const uchar *hsv, int pixels)
+{
+    hsvToRgbScalar(dst, hsv, pixels);
+}
+
+TARGET_SSE2 static void blendSse2(uchar *dst, const uchar *src, int pixels, uchar alpha)
+{
+    const int bytes = pixels * 3;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i a = _mm_set1_epi16(alpha);
+    const __m128i ia = _mm_set1_epi16(255 - alpha);
+
+    int i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), a), _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), ia));
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), a), _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), ia));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(div255Sse2(lo), div255Sse2(hi)));
+    }
+    blendBytes(dst + i, src + i, bytes - i, alpha);
+}
+
+TARGET_SSE2 static void scaleSse2(uchar *dst, int pixels, uchar factor)
+{
+    const int bytes = pixels * 3;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i f = _mm_set1_epi16(factor);
+
+    int i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+        __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), f);
+        __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), f);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(div255Sse2(lo), div255Sse2(hi)));
+    }
+    scaleBytes(dst + i, bytes - i, factor);
+}
+
+TARGET_SSE2 static void scaleChannelsSse2(uchar *dst, int pixels, RGBval factors)
+{
+    // 16 pixels are exactly three vectors, so each vector always has the same factor in each byte
+    uchar pattern[48];
+    fillScalar(pattern, 16, factors);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i f[6];
+    for (int v = 0; v < 3; v++) {
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern + v * 16));
+        f[v * 2] = _mm_unpacklo_epi8(p, zero);
+        f[v * 2 + 1] = _mm_unpackhi_epi8(p, zero);
+    }
+
+    int i = 0;
+    for (; i + 16 <= pixels; i += 16) {
+        for (int v = 0; v < 3; v++) {
+            __m128i *out = reinterpret_cast<__m128i *>(dst + i * 3 + v * 16);
+            __m128i d = _mm_loadu_si128(out);
+            __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), f[v * 2]);
+            __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), f[v * 2 + 1]);
+            _mm_storeu_si128(out, _mm_packus_epi16(div255Sse2(lo), div255Sse2(hi)));
+        }
+    }
+    scaleChannelsScalar(dst + i * 3, pixels - i, factors);
+}
+
+// Works on 16 bit lanes holding one byte each
+template<BlendMode mode>
+TARGET_SSE2 static inline __m128i compositeLanesSse2(__m128i d, __m128i s, __m128i a)
+{
+    __m128i blended;
+    switch (mode) {
+    case BlendMode::Add:
+        blended = _mm_min_epi16(_mm_add_epi16(d, s), _mm_set1_epi16(255));
+        break;
+    case BlendMode::Multiply:
+        blended = div255Sse2(_mm_mullo_epi16(d, s));
+        break;
+    case BlendMode::Screen:
+        blended = _mm_sub_epi16(_mm_add_epi16(d, s), div255Sse2(_mm_mullo_epi16(d, s)));
+        break;
+    default:
+        blended = s;
+        break;
+    }
+    const __m128i ia = _mm_sub_epi16(_mm_set1_epi16(255), a);
+    return div255Sse2(_mm_add_epi16(_mm_mullo_epi16(blended, a), _mm_mullo_epi16(d, ia)));
+}
+
+template<BlendMode mode>
+TARGET_SSE2 static void compositeModeSse2(uchar *dst, const uchar *src, const uchar *mask, int bytes, uchar opacity)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i o = _mm_set1_epi16(opacity);
+
+    int i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m128i alo = o, ahi = o;
+        if (mask != nullptr) {
+            __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i *>(mask + i));
+            alo = div255Sse2(_mm_mullo_epi16(_mm_unpacklo_epi8(m, zero), o));
+            ahi = div255Sse2(_mm_mullo_epi16(_mm_unpackhi_epi8(m, zero), o));
+        }
+        __m128i lo = compositeLanesSse2<mode>(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(s, zero), alo);
+        __m128i hi = compositeLanesSse2<mode>(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(s, zero), ahi);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+    compositeBytes(dst + i, src + i, mask != nullptr ? mask + i : nullptr, bytes - i, mode, opacity);
+}
+
+TARGET_SSE2 static void compositeSse2(uchar *dst, const uchar *src, const uchar *mask, int pixels, BlendMode mode, uchar opacity)
+{
+    switch (mode) {
+    case BlendMode::Add:
+        compositeModeSse2<BlendMode::Add>(dst, src, mask, pixels * 3, opacity);
+        break;
+    case BlendMode::Multiply:
+        compositeModeSse2<BlendMode::Multiply>(dst, src, mask, pixels * 3, opacity);
+        break;
+    case BlendMode::Screen:
+        compositeModeSse2<BlendMode::Screen>(dst, src, mask, pixels * 3, opacity);
+        break;
+    default:
+        compositeModeSse2<BlendMode::Normal>(dst, src, mask, pixels * 3, opacity);
+        break;
+    }
+}
+
+static const ColorKernelTable sse2Table = {
+    "sse2",
+    fillSse2,
+    gradientSse2,
+    hsvToRgbSse2,
+    blendSse2,
+    scaleSse2,
+    scaleChannelsSse2,
+    compositeSse2
+};
+
+/* --------------------- AVX2 --------------------- */
+
+TARGET_AVX2 static inline __m256i div255Avx2(__m256i x)
+{
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+TARGET_AVX2 static void fillAvx2(uchar *dst, int pixels, RGBval color)
+{
+    // 32 pixels are exactly three vectors
+    uchar pattern[96];
+    fillScalar(pattern, 32, color);
+    const __m256i p0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pattern));
+    const __m256i p1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pattern + 32));
+    const __m256i p2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pattern + 64));
+
+    int i = 0;
+    for (; i + 32 <= pixels; i += 32) {
+        __m256i *out = reinterpret_cast<__m256i *>(dst + i * 3);
+        _mm256_storeu_si256(out, p0);
+        _mm256_storeu_si256(out + 1, p1);
+        _mm256_storeu_si256(out + 2, p2);
+    }
+    fillSse2(dst + i * 3, pixels - i, color);
+}
+
+// The per-pixel kernels are compiled for AVX2 so the compiler can vectorize them
+TARGET_AVX2 static void gradientAvx2(uchar *dst, int pixels, RGBval from, RGBval to)
+{
+    gradientScalar(dst, pixels, from, to);
+}
+
+TARGET_AVX2 static void hsvToRgbAvx2(uchar *dst, const uchar *hsv, int pixels)
+{
+    hsvToRgbScalar(dst, hsv, pixels);
+}
+
+TARGET_AVX2 static void blendAvx2(uchar *dst, const uchar *src, int pixels, uchar alpha)
+{
+    const int bytes = pixels * 3;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i a = _mm256_set1_epi16(alpha);
+    const __m256i ia = _mm256_set1_epi16(255 - alpha);
+
+    // unpack and pack both work per 128 bit lane, so the byte order is preserved
+    int i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(s, zero), a), _mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), ia));
+        __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(s, zero), a), _mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), ia));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_packus_epi16(div255Avx2(lo), div255Avx2(hi)));
+    }
+    blendBytes(dst + i, src + i, bytes - i, alpha);
+}
+
+TARGET_AVX2 static void scaleAvx2(uchar *dst, int pixels, uchar factor)
+{
+    const int bytes = pixels * 3;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i f = _mm256_set1_epi16(factor);
+
+    int i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+        __m256i lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), f);
+        __m256i hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), f);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_packus_epi16(div255Avx2(lo), div255Avx2(hi)));
+    }
+    scaleBytes(dst + i, bytes - i, factor);
+}
+
+TARGET_AVX2 static void scaleChannelsAvx2(uchar *dst, int pixels, RGBval factors)
+{
+    // 32 pixels are exactly three vectors
+    uchar pattern[96];
+    fillScalar(pattern, 32, factors);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i f[6];
+    for (int v = 0; v < 3; v++) {
+        __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pattern + v * 32));
+        f[v * 2] = _mm256_unpacklo_epi8(p, zero);
+        f[v * 2 + 1] = _mm256_unpackhi_epi8(p, zero);
+    }
+
+    int i = 0;
+    for (; i + 32 <= pixels; i += 32) {
+        for (int v = 0; v < 3; v++) {
+            __m256i *out = reinterpret_cast<__m256i *>(dst + i * 3 + v * 32);
+            __m256i d = _mm256_loadu_si256(out);
+            __m256i lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), f[v * 2]);
+            __m256i hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), f[v * 2 + 1]);
+            _mm256_storeu_si256(out, _mm256_packus_epi16(div255Avx2(lo), div255Avx2(hi)));
+        }
+    }
+    scaleChannelsSse2(dst + i * 3, pixels - i, factors);
+}
+
+template<BlendMode mode>
+TARGET_AVX2 static inline __m256i compositeLanesAvx2(__m256i d, __m256i s, __m256i a)
+{
+    __m256i blended;
+    switch (mode) {
+    case BlendMode::Add:
+        blended = _mm256_min_epi16(_mm256_add_epi16(d, s), _mm256_set1_epi16(255));
+        break;
+    case BlendMode::Multiply:
+        blended = div255Avx2(_mm256_mullo_epi16(d, s));
+        break;
+    case BlendMode::Screen:
+        blended = _mm256_sub_epi16(_mm256_add_epi16(d, s), div255Avx2(_mm256_mullo_epi16(d, s)));
+        break;
+    default:
+        blended = s;
+        break;
+    }
+    const __m256i ia = _mm256_sub_epi16(_mm256_set1_epi16(255), a);
+    return div255Avx2(_mm256_add_epi16(_mm256_mullo_epi16(blended, a), _mm256_mullo_epi16(d, ia)));
+}
+
+template<BlendMode mode>
+TARGET_AVX2 static void compositeModeAvx2(uchar *dst, const uchar *src, const uchar *mask, int bytes, uchar opacity)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i o = _mm256_set1_epi16(opacity);
+
+    int i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        __m256i alo = o, ahi = o;
+        if (mask != nullptr) {
+            __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(mask + i));
+            alo = div255Avx2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(m, zero), o));
+            ahi = div255Avx2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(m, zero), o));
+        }
+        __m256i lo = compositeLanesAvx2<mode>(_mm256_unpacklo_epi8(d, zero), _mm256_unpacklo_epi8(s, zero), alo);
+        __m256i hi = compositeLanesAvx2<mode>(_mm256_unpackhi_epi8(d, zero), _mm256_unpackhi_epi8(s, zero), ahi);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+    compositeBytes(dst + i, src + i, mask != nullptr ? mask + i : nullptr, bytes - i, mode, opacity);
+}
+
+TARGET_AVX2 static void compositeAvx2(uchar *dst, const uchar *src, const uchar *mask, int pixels, BlendMode mode, uchar opacity)
+{
+    switch (mode) {
+    case BlendMode::Add:
+        compositeModeAvx2<BlendMode::Add>(dst, src, mask, pixels * 3, opacity);
+        break;
+    case BlendMode::Multiply:
+        compositeModeAvx2<BlendMode::Multiply>(dst, src, mask, pixels * 3, opacity);
+        break;
+    case BlendMode::Screen:
+        compositeModeAvx2<BlendMode::Screen>(dst, src, mask, pixels * 3, opacity);
+        break;
+    default:
+        compositeModeAvx2<BlendMode::Normal>(dst, src, mask, pixels * 3, opacity);
+        break;
+    }
+}
+
+static const ColorKernelTable avx2Table = {
+    "avx2",
+    fillAvx2,
+    gradientAvx2,
+    hsvToRgbAvx2,
+    blendAvx2,
+    scaleAvx2,
+    scaleChannelsAvx2,
+    compositeAvx2
+};
+
+#endif // COLORKERNELS_X86
+
+/* --------------------- DISPATCH --------------------- */
+
+const ColorKernelTable *colorKernelTable(ColorKernelIsa isa)
+{
+    switch (isa) {
+    case ColorKernelIsa::Scalar:
+        return &scalarTable;
+#ifdef COLORKERNELS_X86
+    case ColorKernelIsa::SSE2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse2") ? &sse2Table : nullptr;
+    case ColorKernelIsa::AVX2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? &avx2Table : nullptr;
+#endif
+    default:
+        return nullptr;
+    }
+}
+
+static const ColorKernelTable *selectColorKernelTable()
+{
+    if (const ColorKernelTable *table = colorKernelTable(ColorKernelIsa::AVX2))
+        return table;
+    if (const ColorKernelTable *table = colorKernelTable(ColorKernelIsa::SSE2))
+        return table;
+    return &scalarTable;
+}
+
+const ColorKernelTable *activeColorKernelTable()
+{
+    static const ColorKernelTable *table = selectColorKernelTable();
+    return table;
+}
+
+void fillRgb(uchar *dst, int pixels, RGBval color)
+{
+    activeColorKernelTable()->fill(dst, pixels, color);
+}
+
+void fillRgbGradient(uchar *dst, int pixels, RGBval from, RGBval to)
+{
+    activeColorKernelTable()->gradient(dst, pixels, from, to);
+}
+
+void hsvToRgb(uchar *dst, const uchar *hsv, int pixels)
+{
+    activeColorKernelTable()->hsvToRgb(dst, hsv, pixels);
+}
+
+void blendRgb(uchar *dst, const uchar *src, int pixels, uchar alpha)
+{
+    activeColorKernelTable()->blend(dst, src, pixels, alpha);
+}
+
+void scaleRgb(uchar *dst, int pixels, uchar factor)
+{
+    activeColorKernelTable()->scale(dst, pixels, factor);
+}
+
+void scaleRgbChannels(uchar *dst, int pixels, RGBval factors)
+{
+    activeColorKernelTable()->scaleChannels(dst, pixels, factors);
+}
+
+void compositeRgb(uchar *dst, const uchar *src, const uchar *mask, int pixels, BlendMode mode, uchar opacity)
+{
+    activeColorKernelTable()->composite(dst, src, mask, pixels, mode, opacity);
+}
+
+bool isUniformRgb(const uchar *data, int pixels)
+{
+    // Every pixel equals the one before it, memcmp is vectorized already
+    return pixels <= 1 || memcmp(data, data + 3, (pixels - 1) * 3) == 0;
+}
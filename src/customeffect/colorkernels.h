@@ -0,0 +1,117 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLORKERNELS_H
+#define COLORKERNELS_H
+
+#include <QtGlobal>
+
+struct RGBval {
+    uchar red;
+    uchar green;
+    uchar blue;
+};
+
+enum class BlendMode {
+    Normal,
+    Add,
+    Multiply,
+    Screen
+};
+
+/*
+ * Kernels for rendering packed RGB24 data, as used by CustomFrame.
+ * "pixels" is always the number of RGB triplets, not bytes. dst and src may
+ * have any alignment. The best implementation for the running CPU is picked
+ * the first time a kernel is called.
+ */
+
+// Set all pixels to the same color
+void fillRgb(uchar *dst, int pixels, RGBval color);
+// Linear gradient from the first to the last pixel, both ends inclusive
+void fillRgbGradient(uchar *dst, int pixels, RGBval from, RGBval to);
+// Convert packed HSV (hue 0-255 for the full circle, saturation, value) to RGB
+void hsvToRgb(uchar *dst, const uchar *hsv, int pixels);
+// dst = src * alpha + dst * (255 - alpha), per channel and rounded
+void blendRgb(uchar *dst, const uchar *src, int pixels, uchar alpha);
+// dst = dst * factor / 255, per channel and rounded
+void scaleRgb(uchar *dst, int pixels, uchar factor);
+// Like scaleRgb, with a separate factor for each channel
+void scaleRgbChannels(uchar *dst, int pixels, RGBval factors);
+// Composite src over dst with the blend mode, weighted by opacity and the optional per-channel mask.
+// mask has the same layout as src, nullptr means fully opaque.
+void compositeRgb(uchar *dst, const uchar *src, const uchar *mask, int pixels, BlendMode mode, uchar opacity);
+// Whether all pixels have the same color
+bool isUniformRgb(const uchar *data, int pixels);
+
+enum class ColorKernelIsa {
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+struct ColorKernelTable {
+    const char *name;
+    void (*fill)(uchar *dst, int pixels, RGBval color);
+    void (*gradient)(uchar *dst, int pixels, RGBval from, RGBval to);
+    void (*hsvToRgb)(uchar *dst, const uchar *hsv, int pixels);
+    void (*blend)(uchar *dst, const uchar *src, int pixels, uchar alpha);
+    void (*scale)(uchar *dst, int pixels, uchar factor);
+    void (*scaleChannels)(uchar *dst, int pixels, RGBval factors);
+    void (*composite)(uchar *dst, const uchar *src, const uchar *mask, int pixels, BlendMode mode, uchar opacity);
+};
+
+// Returns nullptr if the implementation is not available on this CPU or build.
+const ColorKernelTable *colorKernelTable(ColorKernelIsa isa);
+// The implementation used by the functions above.
+const ColorKernelTable *activeColorKernelTable();
+
+// Number of steps for one full cycle through the spectrum with the given step size
+inline int spectrumCycleLength(uchar stepSize)
+{
+    // Each of the six transitions takes ceil(0xFF / stepSize) steps
+    return 6 * ((0xFF + stepSize - 1) / stepSize);
+}
+
+// Color at the given step of the spectrum cycle, starting at red.
+// FF0000 Red -> FFFF00 Yellow -> 00FF00 Green -> 00FFFF Cyan -> 0000FF Blue -> FF00FF Magenta -> FF0000 Red
+inline RGBval spectrumColor(int position, uchar stepSize)
+{
+    int stepsPerTransition = (0xFF + stepSize - 1) / stepSize;
+    int transition = (position / stepsPerTransition) % 6;
+    int offset = (position % stepsPerTransition) * stepSize;
+    uchar rising = offset > 0xFF ? 0xFF : offset;
+    uchar falling = offset > 0xFF ? 0x00 : 0xFF - offset;
+
+    switch (transition) {
+    case 0:
+        return {0xFF, rising, 0x00};
+    case 1:
+        return {falling, 0xFF, 0x00};
+    case 2:
+        return {0x00, 0xFF, rising};
+    case 3:
+        return {0x00, falling, 0xFF};
+    case 4:
+        return {rising, 0x00, 0xFF};
+    default:
+        return {0xFF, 0x00, falling};
+    }
+}
+
+#endif // COLORKERNELS_H
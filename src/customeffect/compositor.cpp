@@ -0,0 +1,111 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+
+#include "compositor.h"
+
+Compositor::Compositor(uchar width, uchar height) : width(width), height(height)
+{
+}
+
+Compositor::Layer *Compositor::layerForWriting(uchar layer)
+{
+    auto it = layers.find(layer);
+    if (it == layers.end()) {
+        if (layers.size() >= maxLayers) {
+            qWarning("Only %d layers are supported.", maxLayers);
+            return nullptr;
+        }
+        it = layers.insert(layer, Layer());
+        it->rgb.resize(width, height);
+        it->mask.resize(width, height);
+    }
+    it->dirty = true;
+    dirty = true;
+    return &it.value();
+}
+
+bool Compositor::defineLayerRow(uchar layer, uchar row, uchar startColumn, uchar endColumn, const QByteArray &rgbData)
+{
+    if (row >= height || startColumn > endColumn || endColumn >= width || rgbData.size() != (endColumn - startColumn + 1) * 3) {
+        qWarning("Layer row definition out of bounds.");
+        return false;
+    }
+    Layer *l = layerForWriting(layer);
+    if (l == nullptr)
+        return false;
+
+    memcpy(l->rgb.row(row) + startColumn * 3, rgbData.constData(), rgbData.size());
+    memset(l->mask.row(row) + startColumn * 3, 0xFF, rgbData.size());
+    return true;
+}
+
+bool Compositor::setLayerProperties(uchar layer, BlendMode mode, uchar opacity)
+{
+    Layer *l = layerForWriting(layer);
+    if (l == nullptr)
+        return false;
+
+    l->mode = mode;
+    l->opacity = opacity;
+    return true;
+}
+
+bool Compositor::removeLayer(uchar layer)
+{
+    auto it = layers.find(layer);
+    if (it == layers.end())
+        return false;
+
+    // The layer above now sits on what was below the removed one
+    it = layers.erase(it);
+    if (it != layers.end())
+        it->dirty = true;
+    dirty = true;
+    return true;
+}
+
+bool Compositor::isEmpty() const
+{
+    return layers.isEmpty();
+}
+
+bool Compositor::isDirty() const
+{
+    return dirty;
+}
+
+void Compositor::compose(const CustomFrame &background, bool backgroundChanged, CustomFrame &output)
+{
+    const CustomFrame *below = &background;
+    bool recompose = backgroundChanged;
+    for (Layer &l : layers) {
+        recompose = recompose || l.dirty;
+        if (recompose) {
+            l.composed = *below;
+            if (l.opacity > 0)
+                compositeRgb(l.composed.data(), l.rgb.constData(), l.mask.constData(), width * height, l.mode, l.opacity);
+            l.dirty = false;
+        }
+        below = &l.composed;
+    }
+    // Implicitly shared, the output is only copied once someone writes to it
+    output = *below;
+    dirty = false;
+}
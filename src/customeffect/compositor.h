@@ -0,0 +1,77 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include <QByteArray>
+#include <QMap>
+
+#include "colorkernels.h"
+#include "customframe.h"
+
+/**
+ * Stacks software layers on top of a background frame.
+ *
+ * Layers are ordered by their id, the lowest id sits directly on the
+ * background. Only the parts of a layer that were defined are drawn, the
+ * rest of it is transparent. The result after each layer is kept, so when
+ * only an upper layer changes the layers below it are not composited again.
+ *
+ * Not thread-safe, CustomEffectThread guards it with its mutex.
+ */
+class Compositor
+{
+public:
+    static const int maxLayers = 8;
+
+    Compositor(uchar width, uchar height);
+
+    bool defineLayerRow(uchar layer, uchar row, uchar startColumn, uchar endColumn, const QByteArray &rgbData);
+    bool setLayerProperties(uchar layer, BlendMode mode, uchar opacity);
+    bool removeLayer(uchar layer);
+
+    bool isEmpty() const;
+    // True if the output changed since the last compose() because of layer changes
+    bool isDirty() const;
+
+    // Composes all layers over the background into output.
+    // backgroundChanged can be false if background is the same as on the previous call.
+    void compose(const CustomFrame &background, bool backgroundChanged, CustomFrame &output);
+
+private:
+    struct Layer {
+        CustomFrame rgb;
+        // Coverage of each byte in rgb, 0xFF where the layer was defined
+        CustomFrame mask;
+        BlendMode mode = BlendMode::Normal;
+        uchar opacity = 0xFF;
+        bool dirty = true;
+        // Background with this and all lower layers composited
+        CustomFrame composed;
+    };
+
+    Layer *layerForWriting(uchar layer);
+
+    const uchar width;
+    const uchar height;
+    QMap<uchar, Layer> layers;
+    bool dirty = false;
+};
+
+#endif // COMPOSITOR_H
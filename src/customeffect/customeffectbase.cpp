@@ -20,12 +20,14 @@
 
 CustomEffectBase::CustomEffectBase(uchar width, uchar height) : width(width), height(height)
 {
-    this->rgbData = rgbData;
+}
 
-    // We need height times QByteArrays
-    rgbData.resize(height);
-    foreach (QByteArray arr, rgbData) {
-        // And each needs space for width * 3 bytes of data (RGB)
-        arr.resize(width * 3);
-    }
+int CustomEffectBase::period() const
+{
+    return 0;
+}
+
+bool CustomEffectBase::isStatic() const
+{
+    return false;
 }
@@ -20,31 +20,9 @@
 #define CUSTOMEFFECTBASE_H
 
 #include <QObject>
-#include <QVector>
 
-struct RGBval {
-    uchar red;
-    uchar green;
-    uchar blue;
-};
-
-enum class SpectrumColor {
-    Red, Yellow, Green, Cyan, Blue, Magenta
-};
-
-inline uchar increaseByNoOverflow(uchar num, uchar incBy)
-{
-    if ((num + incBy) > 0xFF)
-        return 0xFF;
-    return num + incBy;
-}
-
-inline uchar decreaseByNoUnderflow(uchar num, uchar decBy)
-{
-    if ((num - decBy) < 0x00)
-        return 0x00;
-    return num - decBy;
-}
+#include "colorkernels.h"
+#include "customframe.h"
 
 /**
  * @todo write docs
@@ -55,18 +33,21 @@ class CustomEffectBase : public QObject
 public:
     CustomEffectBase(uchar width, uchar height);
 
-    virtual void initialize() = 0;
-    virtual void prepareRgbData() = 0;
+    // Start the effect from its first frame. Returns false if the effect can't run.
+    virtual bool initialize() = 0;
+    // Render the next frame into the given buffer. It has width x height pixels.
+    virtual void prepareRgbData(CustomFrame &frame) = 0;
+    // Number of frames after which the effect repeats itself exactly, 0 if it never does.
+    // Periodic effects are rendered once and then played back from the FrameCache.
+    virtual int period() const;
+    // Static effects always render the same frame, it is rendered once and not animated.
+    virtual bool isStatic() const;
 
     ulong msleep;
 
-signals:
-    void rgbDataReady(const uchar row, const QByteArray &rgbData);
-
 protected:
     const uchar width;
     const uchar height;
-    QVector<QByteArray> rgbData;
 };
 
 #endif // CUSTOMEFFECTBASE_H
@@ -16,31 +16,40 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <QVector>
-
 #include "customeffectthread.h"
 
-#include "spectrumeffect.h"
-#include "waveeffect.h"
+#include "effectfactory.h"
+#include "framecache.h"
+
+// Frame interval used when only layers are shown
+static const ulong layerFrameInterval = 33;
 
-CustomEffectThread::CustomEffectThread(const uchar width, const uchar height, QObject *parent) : QThread(parent), width(width), height(height)
+CustomEffectThread::CustomEffectThread(const uchar width, const uchar height, QObject *parent) : QThread(parent), width(width), height(height), compositor(width, height)
 {
     pause = false;
     abort = false;
+
+    background.resize(width, height);
+    frameBuffer.reset(CustomFrame(width, height));
 }
 
 CustomEffectThread::~CustomEffectThread()
 {
     mutex.lock();
     abort = true;
+    condition.wakeOne();
     mutex.unlock();
 
     wait();
+
+    delete customEffect;
 }
 
 bool CustomEffectThread::startThread(QString effectName)
 {
-    if (isRunning() && !pause) {
+    QMutexLocker locker(&mutex);
+
+    if (animating && !pause) {
         qWarning("Effect thread is already running. Pause it first");
         return false;
     }
@@ -49,59 +58,152 @@ bool CustomEffectThread::startThread(QString effectName)
     if (currentEffect != effectName) {
         // Delete previous effect class
         delete customEffect;
+        customEffect = nullptr;
         currentEffect = effectName;
-        if (effectName == "spectrum") {
-            customEffect = new SpectrumEffect(width, height);
-        } else if (effectName == "wave") {
-            customEffect = new WaveEffect(width, height);
-        } else {
+        customEffect = EffectFactory::create(effectName, width, height);
+        if (customEffect == nullptr)
             qWarning("Effect %s unknown.", qUtf8Printable(effectName));
+        if (customEffect == nullptr || !customEffect->initialize()) {
+            delete customEffect;
+            customEffect = nullptr;
+            currentEffect.clear();
+            cycleFrames.clear();
+            animating = false;
             return false;
         }
-        connect(customEffect, &CustomEffectBase::rgbDataReady, this, &CustomEffectThread::customEffectRgbDataReady);
-        customEffect->initialize();
+
+        cycleFrames = FrameCache::cycle(effectName, customEffect, width, height);
+        cyclePosition = 0;
     }
 
+    animating = true;
+    pause = false;
     if (!isRunning()) {
         qDebug("Starting custom effect thread.");
         start(LowPriority);
     } else {
         qDebug("Resuming custom effect thread.");
-        pause = false;
         condition.wakeOne();
     }
     return true;
 }
 
+void CustomEffectThread::startEffect(CustomEffectBase *effect)
+{
+    QMutexLocker locker(&mutex);
+
+    delete customEffect;
+    customEffect = effect;
+    // Not created by name, so startThread() has to create its effect again
+    currentEffect.clear();
+    cycleFrames.clear();
+    customEffect->initialize();
+
+    animating = true;
+    pause = false;
+    if (!isRunning())
+        start(LowPriority);
+    else
+        condition.wakeOne();
+}
+
 void CustomEffectThread::pauseThread()
 {
-    mutex.lock();
     pause = true;
-    mutex.unlock();
 }
 
-void CustomEffectThread::run()
+ulong CustomEffectThread::frameInterval()
 {
-    forever {
-        if (abort)
-            return;
+    QMutexLocker locker(&mutex);
+    if (customEffect == nullptr || !animating || pause)
+        return layerFrameInterval;
+    return customEffect->msleep;
+}
 
-        customEffect->prepareRgbData();
+bool CustomEffectThread::defineLayerRow(uchar layer, uchar row, uchar startColumn, uchar endColumn, const QByteArray &rgbData)
+{
+    QMutexLocker locker(&mutex);
+    if (!compositor.defineLayerRow(layer, row, startColumn, endColumn, rgbData))
+        return false;
+    wakeForLayers();
+    return true;
+}
 
-        // Show the frame
-        emit frameReady();
+bool CustomEffectThread::setLayerProperties(uchar layer, BlendMode mode, uchar opacity)
+{
+    QMutexLocker locker(&mutex);
+    if (!compositor.setLayerProperties(layer, mode, opacity))
+        return false;
+    wakeForLayers();
+    return true;
+}
 
-        QThread::msleep(customEffect->msleep);
+bool CustomEffectThread::removeLayer(uchar layer)
+{
+    QMutexLocker locker(&mutex);
+    if (!compositor.removeLayer(layer))
+        return false;
+    wakeForLayers();
+    return true;
+}
+
+bool CustomEffectThread::hasLayers()
+{
+    QMutexLocker locker(&mutex);
+    return !compositor.isEmpty();
+}
+
+// Has to be called with the mutex held
+void CustomEffectThread::wakeForLayers()
+{
+    if (!isRunning())
+        start(LowPriority);
+    else
+        condition.wakeOne();
+}
+
+TripleBuffer<CustomFrame> &CustomEffectThread::frames()
+{
+    return frameBuffer;
+}
 
+void CustomEffectThread::run()
+{
+    forever {
+        // The mutex only guards against the effect or the layers being changed, frames are handed over lock-free
         mutex.lock();
-        if (pause)
+        while (!abort && !((animating && !pause) || compositor.isDirty()))
             condition.wait(&mutex);
-        pause = false;
+        if (abort) {
+            mutex.unlock();
+            return;
+        }
+
+        bool renderEffect = animating && !pause;
+        if (renderEffect) {
+            if (!cycleFrames.isEmpty()) {
+                // Periodic effects are played back from their precomputed cycle, sharing the frame is a pointer bump
+                background = cycleFrames.at(cyclePosition);
+                cyclePosition = (cyclePosition + 1) % cycleFrames.size();
+            } else {
+                customEffect->prepareRgbData(background);
+            }
+            // A static effect is done after its first frame
+            if (customEffect->isStatic())
+                animating = false;
+        }
+        // The effect output is kept as background so layers can be added on top of a paused or static effect
+        if (!compositor.isEmpty() || compositor.isDirty())
+            compositor.compose(background, renderEffect, frameBuffer.writeBuffer());
+        else
+            frameBuffer.writeBuffer() = background;
+
+        ulong interval = animating && !pause ? customEffect->msleep : 0;
         mutex.unlock();
-    }
-}
 
-void CustomEffectThread::customEffectRgbDataReady(const uchar row, const QByteArray &rgbData)
-{
-    emit rgbDataReady(row, 0, width - 1, rgbData);
+        // Show the frame
+        frameBuffer.publish();
+
+        QThread::msleep(interval);
+    }
 }
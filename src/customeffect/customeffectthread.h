@@ -22,11 +22,21 @@
 #include <QThread>
 #include <QMutex>
 #include <QWaitCondition>
+#include <QVector>
 
+#include <atomic>
+
+#include "compositor.h"
 #include "customeffectbase.h"
+#include "customframe.h"
+#include "triplebuffer.h"
 
 /**
- * @todo write docs
+ * Runs a CustomEffectBase on its own thread and hands the finished frames over
+ * to the device through a lock-free triple buffer.
+ *
+ * The effect is the background, layers defined by clients are composited on top
+ * of it. Layers are shown even while no effect is running or it is paused.
  */
 class CustomEffectThread : public QThread
 {
@@ -36,29 +46,48 @@ public:
     ~CustomEffectThread() override;
 
     bool startThread(QString effectName);
+    // Replaces the current effect, even if it is running, and takes ownership of it
+    void startEffect(CustomEffectBase *effect);
     void pauseThread();
 
-signals:
-    void rgbDataReady(uchar row, uchar startColumn, uchar endColumn, const QByteArray &rgbData);
-    void frameReady();
+    ulong frameInterval();
+
+    bool defineLayerRow(uchar layer, uchar row, uchar startColumn, uchar endColumn, const QByteArray &rgbData);
+    bool setLayerProperties(uchar layer, BlendMode mode, uchar opacity);
+    bool removeLayer(uchar layer);
+    bool hasLayers();
+
+    // Consumer side of the frame hand-off, only to be used from the device's thread.
+    TripleBuffer<CustomFrame> &frames();
 
 protected:
     void run() override;
 
 private:
+    void wakeForLayers();
+
     QMutex mutex;
     QWaitCondition condition;
-    bool pause;
-    bool abort;
+    std::atomic<bool> pause;
+    std::atomic<bool> abort;
 
     const uchar width;
     const uchar height;
 
     CustomEffectBase *customEffect = nullptr;
     QString currentEffect;
+    // The effect still has frames to render, false once a static effect rendered its frame
+    bool animating = false;
+
+    // Precomputed frames of a periodic effect, played back instead of rendering
+    QVector<CustomFrame> cycleFrames;
+    int cyclePosition = 0;
+
+    Compositor compositor;
+    // Last frame rendered by the effect
+    CustomFrame background;
 
-private slots:
-    void customEffectRgbDataReady(const uchar row, const QByteArray &rgbData);
+    TripleBuffer<CustomFrame> frameBuffer;
 };
 
 #endif // CUSTOMEFFECTTHREAD_H
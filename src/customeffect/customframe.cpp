@@ -0,0 +1,91 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "customframe.h"
+
+CustomFrame::CustomFrame(uchar width, uchar height)
+{
+    resize(width, height);
+}
+
+void CustomFrame::resize(uchar width, uchar height)
+{
+    frameWidth = width;
+    frameHeight = height;
+    rgbData.fill(0x00, width * height * 3);
+}
+
+void CustomFrame::clear()
+{
+    rgbData.fill(0x00);
+}
+
+uchar CustomFrame::width() const
+{
+    return frameWidth;
+}
+
+uchar CustomFrame::height() const
+{
+    return frameHeight;
+}
+
+int CustomFrame::rowSize() const
+{
+    return frameWidth * 3;
+}
+
+int CustomFrame::size() const
+{
+    return rgbData.size();
+}
+
+uchar *CustomFrame::data()
+{
+    return reinterpret_cast<uchar *>(rgbData.data());
+}
+
+const uchar *CustomFrame::constData() const
+{
+    return reinterpret_cast<const uchar *>(rgbData.constData());
+}
+
+uchar *CustomFrame::row(uchar row)
+{
+    return data() + row * rowSize();
+}
+
+const uchar *CustomFrame::constRow(uchar row) const
+{
+    return constData() + row * rowSize();
+}
+
+QByteArray CustomFrame::rowArray(uchar row) const
+{
+    return QByteArray::fromRawData(rgbData.constData() + row * rowSize(), rowSize());
+}
+
+bool CustomFrame::operator==(const CustomFrame &other) const
+{
+    return frameWidth == other.frameWidth && frameHeight == other.frameHeight && rgbData == other.rgbData;
+}
+
+bool CustomFrame::operator!=(const CustomFrame &other) const
+{
+    return !(*this == other);
+}
@@ -0,0 +1,58 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CUSTOMFRAME_H
+#define CUSTOMFRAME_H
+
+#include <QByteArray>
+
+/**
+ * One full frame of packed RGB24 data for a LED matrix, stored row by row.
+ */
+class CustomFrame
+{
+public:
+    CustomFrame() = default;
+    CustomFrame(uchar width, uchar height);
+
+    void resize(uchar width, uchar height);
+    void clear();
+
+    uchar width() const;
+    uchar height() const;
+    int rowSize() const;
+    int size() const;
+
+    uchar *data();
+    const uchar *constData() const;
+    uchar *row(uchar row);
+    const uchar *constRow(uchar row) const;
+
+    // Returns a view of the row without copying. Only valid while the frame is alive and unchanged.
+    QByteArray rowArray(uchar row) const;
+
+    bool operator==(const CustomFrame &other) const;
+    bool operator!=(const CustomFrame &other) const;
+
+private:
+    uchar frameWidth = 0;
+    uchar frameHeight = 0;
+    QByteArray rgbData;
+};
+
+#endif // CUSTOMFRAME_H
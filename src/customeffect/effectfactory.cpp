@@ -0,0 +1,105 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QDir>
+
+#include "effectfactory.h"
+
+#include "plugineffect.h"
+#include "spectrumeffect.h"
+#include "waveeffect.h"
+
+QHash<QString, const razer_test_effect *> EffectFactory::pluginEffects;
+QList<QLibrary *> EffectFactory::plugins;
+
+static const QStringList builtinEffects = {"spectrum", "wave"};
+
+CustomEffectBase *EffectFactory::create(const QString &name, uchar width, uchar height)
+{
+    if (name == "spectrum")
+        return new SpectrumEffect(width, height);
+    if (name == "wave")
+        return new WaveEffect(width, height);
+    if (pluginEffects.contains(name))
+        return new PluginEffect(pluginEffects.value(name), width, height);
+    return nullptr;
+}
+
+QStringList EffectFactory::effectNames()
+{
+    return builtinEffects + pluginEffects.keys();
+}
+
+int EffectFactory::loadPlugins(const QString &directory)
+{
+    QDir dir(directory);
+    if (!dir.exists())
+        return 0;
+
+    int effectCount = 0;
+    foreach (const QFileInfo &fileInfo, dir.entryInfoList(QDir::Files)) {
+        if (!QLibrary::isLibrary(fileInfo.fileName()))
+            continue;
+        if (!loadPlugin(fileInfo.absoluteFilePath(), &effectCount))
+            qWarning("Failed to load effect plugin %s.", qUtf8Printable(fileInfo.fileName()));
+    }
+    return effectCount;
+}
+
+bool EffectFactory::loadPlugin(const QString &path, int *effectCount)
+{
+    auto *library = new QLibrary(path);
+    auto entry = reinterpret_cast<razer_test_effect_entry_func>(library->resolve(RAZER_TEST_EFFECT_ENTRY));
+    if (entry == nullptr) {
+        qWarning("%s", qUtf8Printable(library->errorString()));
+        delete library;
+        return false;
+    }
+
+    unsigned int count = 0;
+    const razer_test_effect *effects = entry(&count);
+    int loaded = 0;
+    for (unsigned int i = 0; i < count; i++) {
+        const razer_test_effect *effect = &effects[i];
+        if (effect->abi_version != RAZER_TEST_EFFECT_ABI_VERSION) {
+            qWarning("Effect plugin %s uses ABI version %u, expected %u.", qUtf8Printable(path), effect->abi_version, RAZER_TEST_EFFECT_ABI_VERSION);
+            continue;
+        }
+        QString name = QString::fromUtf8(effect->name);
+        if (builtinEffects.contains(name) || pluginEffects.contains(name)) {
+            qWarning("Effect %s from %s is already defined, skipping it.", qUtf8Printable(name), qUtf8Printable(path));
+            continue;
+        }
+        if (effect->create == nullptr || effect->destroy == nullptr || effect->render == nullptr) {
+            qWarning("Effect %s from %s is missing functions, skipping it.", qUtf8Printable(name), qUtf8Printable(path));
+            continue;
+        }
+        qInfo("Loaded effect %s from %s.", qUtf8Printable(name), qUtf8Printable(path));
+        pluginEffects.insert(name, effect);
+        loaded++;
+    }
+
+    if (loaded == 0) {
+        library->unload();
+        delete library;
+        return count == 0;
+    }
+    plugins.append(library);
+    *effectCount += loaded;
+    return true;
+}
@@ -0,0 +1,52 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EFFECTFACTORY_H
+#define EFFECTFACTORY_H
+
+#include <QHash>
+#include <QLibrary>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include "customeffectbase.h"
+#include "../razer_test_effect.h"
+
+/**
+ * Creates custom effects by name, either built-in ones or ones loaded from plugins.
+ */
+class EffectFactory
+{
+public:
+    // Returns nullptr if no effect with that name exists.
+    static CustomEffectBase *create(const QString &name, uchar width, uchar height);
+    static QStringList effectNames();
+
+    // Loads all effect plugins in the directory, returns the number of effects found.
+    static int loadPlugins(const QString &directory);
+
+private:
+    static bool loadPlugin(const QString &path, int *effectCount);
+
+    static QHash<QString, const razer_test_effect *> pluginEffects;
+    // Plugins are never unloaded, their effects may be running at any time
+    static QList<QLibrary *> plugins;
+};
+
+#endif // EFFECTFACTORY_H
@@ -0,0 +1,46 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "effectkernels.h"
+
+#define RAZER_INSTANTIATE_EFFECT_KERNELS(w, h) \
+    template void uniformKernel<w, h>(CustomFrame &, RGBval); \
+    template void waveKernel<w, h>(CustomFrame &, int, uchar);
+RAZER_MATRIX_SHAPES(RAZER_INSTANTIATE_EFFECT_KERNELS)
+RAZER_INSTANTIATE_EFFECT_KERNELS(0, 0)
+#undef RAZER_INSTANTIATE_EFFECT_KERNELS
+
+UniformKernel selectUniformKernel(uchar width, uchar height)
+{
+#define RAZER_SELECT_KERNEL(w, h) \
+    if (width == w && height == h) \
+        return &uniformKernel<w, h>;
+    RAZER_MATRIX_SHAPES(RAZER_SELECT_KERNEL)
+#undef RAZER_SELECT_KERNEL
+    return &uniformKernel<0, 0>;
+}
+
+WaveKernel selectWaveKernel(uchar width, uchar height)
+{
+#define RAZER_SELECT_KERNEL(w, h) \
+    if (width == w && height == h) \
+        return &waveKernel<w, h>;
+    RAZER_MATRIX_SHAPES(RAZER_SELECT_KERNEL)
+#undef RAZER_SELECT_KERNEL
+    return &waveKernel<0, 0>;
+}
@@ -0,0 +1,89 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EFFECTKERNELS_H
+#define EFFECTKERNELS_H
+
+#include <cstring>
+
+#include "colorkernels.h"
+#include "customframe.h"
+
+/*
+ * Effect kernels templated on the matrix dimensions. With the dimensions known
+ * at compile time the loops are fully unrolled and vectorized by the compiler.
+ * Width and Height of 0 is the generic version that reads the dimensions from
+ * the frame. Kernels are picked once per effect through the select functions.
+ */
+
+// Matrix shapes (width, height) of the devices in data/devices
+#define RAZER_MATRIX_SHAPES(X) \
+    X(22, 6) /* Keyboards */ \
+    X(15, 1) /* Mousepads */
+
+// Fill the whole matrix with one color
+template<uchar Width, uchar Height>
+void uniformKernel(CustomFrame &frame, RGBval color)
+{
+    if (Width == 0 || Height == 0) {
+        fillRgb(frame.data(), frame.width() * frame.height(), color);
+        return;
+    }
+    uchar *data = frame.data();
+    for (int i = 0; i < Width * Height; i++) {
+        data[i * 3] = color.red;
+        data[i * 3 + 1] = color.green;
+        data[i * 3 + 2] = color.blue;
+    }
+}
+
+// Spectrum running through the columns, every column is one step further than the previous one
+template<uchar Width, uchar Height>
+void waveKernel(CustomFrame &frame, int startPosition, uchar stepSize)
+{
+    const int width = Width ? Width : frame.width();
+    const int height = Height ? Height : frame.height();
+    if (width == 0 || height == 0)
+        return;
+
+    uchar *data = frame.data();
+    for (int j = 0; j < width; j++) {
+        RGBval color = spectrumColor(startPosition + j, stepSize);
+        data[j * 3] = color.red;
+        data[j * 3 + 1] = color.green;
+        data[j * 3 + 2] = color.blue;
+    }
+    // All rows look the same
+    for (int i = 1; i < height; i++)
+        memcpy(data + i * width * 3, data, width * 3);
+}
+
+#define RAZER_DECLARE_EFFECT_KERNELS(w, h) \
+    extern template void uniformKernel<w, h>(CustomFrame &, RGBval); \
+    extern template void waveKernel<w, h>(CustomFrame &, int, uchar);
+RAZER_MATRIX_SHAPES(RAZER_DECLARE_EFFECT_KERNELS)
+RAZER_DECLARE_EFFECT_KERNELS(0, 0)
+#undef RAZER_DECLARE_EFFECT_KERNELS
+
+typedef void (*UniformKernel)(CustomFrame &frame, RGBval color);
+typedef void (*WaveKernel)(CustomFrame &frame, int startPosition, uchar stepSize);
+
+UniformKernel selectUniformKernel(uchar width, uchar height);
+WaveKernel selectWaveKernel(uchar width, uchar height);
+
+#endif // EFFECTKERNELS_H
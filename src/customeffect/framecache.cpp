@@ -0,0 +1,49 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "framecache.h"
+
+QMutex FrameCache::mutex;
+QHash<QString, QVector<CustomFrame>> FrameCache::cycles;
+
+QVector<CustomFrame> FrameCache::cycle(const QString &effectName, CustomEffectBase *effect, uchar width, uchar height)
+{
+    int period = effect->period();
+    if (period <= 0 || period > maxCycleLength)
+        return {};
+
+    QString key = QString("%1/%2x%3").arg(effectName).arg(width).arg(height);
+
+    QMutexLocker locker(&mutex);
+    if (cycles.contains(key))
+        return cycles.value(key);
+
+    qDebug("Precomputing %i frames for effect %s.", period, qUtf8Printable(key));
+    QVector<CustomFrame> frames;
+    frames.reserve(period);
+    for (int i = 0; i < period; i++) {
+        CustomFrame frame(width, height);
+        effect->prepareRgbData(frame);
+        frames.append(frame);
+    }
+    // Rendering the cycle advanced the effect, start over so it stays in sync with the cache
+    effect->initialize();
+
+    cycles.insert(key, frames);
+    return frames;
+}
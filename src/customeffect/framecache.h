@@ -0,0 +1,50 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAMECACHE_H
+#define FRAMECACHE_H
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+#include "customeffectbase.h"
+#include "customframe.h"
+
+/**
+ * Process-wide cache of the full cycle of periodic effects.
+ *
+ * A cycle is rendered once per effect and matrix size and then shared between
+ * all devices with the same dimensions. The frames are implicitly shared, so
+ * handing one to a device is just a reference count bump.
+ */
+class FrameCache
+{
+public:
+    // Returns an empty vector if the effect is not periodic or its cycle is too long to cache.
+    static QVector<CustomFrame> cycle(const QString &effectName, CustomEffectBase *effect, uchar width, uchar height);
+
+private:
+    static const int maxCycleLength = 4096;
+
+    static QMutex mutex;
+    static QHash<QString, QVector<CustomFrame>> cycles;
+};
+
+#endif // FRAMECACHE_H
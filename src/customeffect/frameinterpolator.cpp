@@ -0,0 +1,87 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "frameinterpolator.h"
+
+#include "colorkernels.h"
+
+const qint64 FrameInterpolator::maxDuration;
+
+void FrameInterpolator::setMode(Mode mode)
+{
+    interpolationMode = mode;
+    lastPushTime = -1;
+    animating = false;
+}
+
+FrameInterpolator::Mode FrameInterpolator::mode() const
+{
+    return interpolationMode;
+}
+
+void FrameInterpolator::pushFrame(const CustomFrame &frame, qint64 now)
+{
+    if (lastPushTime < 0 || from.size() != frame.size()) {
+        // Nothing to blend from yet
+        from = frame;
+        duration = 0;
+    } else {
+        // Continue from what is on screen right now, so a frame that arrives early doesn't cause a jump
+        if (!frameAt(now, from))
+            from = to;
+        duration = qMin(now - lastPushTime, maxDuration);
+    }
+    to = frame;
+    startTime = now;
+    lastPushTime = now;
+    animating = true;
+}
+
+bool FrameInterpolator::frameAt(qint64 now, CustomFrame &out)
+{
+    if (!animating)
+        return false;
+
+    uchar alpha = alphaAt(now);
+    if (alpha == 0xFF) {
+        out = to;
+        animating = false;
+        return true;
+    }
+    out = from;
+    blendRgb(out.data(), to.constData(), to.size() / 3, alpha);
+    return true;
+}
+
+bool FrameInterpolator::isAnimating() const
+{
+    return animating;
+}
+
+uchar FrameInterpolator::alphaAt(qint64 now) const
+{
+    if (duration <= 0 || now >= startTime + duration)
+        return 0xFF;
+    if (now <= startTime)
+        return 0x00;
+
+    double t = static_cast<double>(now - startTime) / duration;
+    if (interpolationMode == Mode::Eased)
+        t = t * t * (3 - 2 * t);
+    return static_cast<uchar>(t * 0xFF + 0.5);
+}
@@ -0,0 +1,64 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAMEINTERPOLATOR_H
+#define FRAMEINTERPOLATOR_H
+
+#include "customframe.h"
+
+/**
+ * Blends between the last two frames of a client that sends frames at a low rate.
+ *
+ * Each new frame is faded in over the time that passed since the frame before
+ * it, so the output trails the client by one frame but moves smoothly. Times
+ * are in microseconds.
+ */
+class FrameInterpolator
+{
+public:
+    enum class Mode {
+        None,
+        Linear,
+        // Smoothstep, slow at the start and the end of each transition
+        Eased
+    };
+
+    // Longest transition, a client that pauses shouldn't turn its next frame into a slow fade
+    static const qint64 maxDuration = 250000;
+
+    void setMode(Mode mode);
+    Mode mode() const;
+
+    void pushFrame(const CustomFrame &frame, qint64 now);
+    // Renders the frame for now into out. Returns false if it's the same as on the previous call.
+    bool frameAt(qint64 now, CustomFrame &out);
+    bool isAnimating() const;
+
+private:
+    uchar alphaAt(qint64 now) const;
+
+    Mode interpolationMode = Mode::None;
+    CustomFrame from;
+    CustomFrame to;
+    qint64 startTime = 0;
+    qint64 duration = 0;
+    qint64 lastPushTime = -1;
+    bool animating = false;
+};
+
+#endif // FRAMEINTERPOLATOR_H
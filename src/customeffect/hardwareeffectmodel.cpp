@@ -0,0 +1,101 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+
+#include "hardwareeffectmodel.h"
+
+const qint64 HardwareEffectModel::breathingPeriod;
+const qint64 HardwareEffectModel::spectrumPeriod;
+const qint64 HardwareEffectModel::wavePeriod;
+
+HardwareEffectModel::HardwareEffectModel(uchar width, uchar height)
+    : width(width)
+    , height(height)
+    , uniformKernel(selectUniformKernel(width, height))
+    , waveKernel(selectWaveKernel(width, height))
+{
+}
+
+bool HardwareEffectModel::canModel(RazerEffect effect)
+{
+    switch (effect) {
+    case RazerEffect::Off:
+    case RazerEffect::Static:
+    case RazerEffect::Breathing:
+    case RazerEffect::BreathingDual:
+    case RazerEffect::Spectrum:
+    case RazerEffect::Wave:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void HardwareEffectModel::setState(const State &state, qint64 startTime)
+{
+    currentState = state;
+    this->startTime = startTime;
+}
+
+const HardwareEffectModel::State &HardwareEffectModel::state() const
+{
+    return currentState;
+}
+
+void HardwareEffectModel::render(qint64 now, CustomFrame &frame) const
+{
+    frame.resize(width, height);
+    qint64 elapsed = qMax(now - startTime, static_cast<qint64>(0));
+
+    switch (currentState.effect) {
+    case RazerEffect::Static:
+        uniformKernel(frame, currentState.color1);
+        break;
+    case RazerEffect::Breathing:
+    case RazerEffect::BreathingDual: {
+        // Fades in from dark and out again, dual breathing alternates the colors every breath
+        qint64 breath = elapsed / breathingPeriod;
+        double phase = static_cast<double>(elapsed % breathingPeriod) / breathingPeriod;
+        bool second = currentState.effect == RazerEffect::BreathingDual && breath % 2 == 1;
+        uniformKernel(frame, second ? currentState.color2 : currentState.color1);
+        scaleRgb(frame.data(), frame.size() / 3, static_cast<uchar>((1 - std::cos(2 * M_PI * phase)) / 2 * 0xFF + 0.5));
+        break;
+    }
+    case RazerEffect::Spectrum: {
+        // The whole device runs through the spectrum, starting at red
+        int cycleLength = spectrumCycleLength(1);
+        uniformKernel(frame, spectrumColor(elapsed % spectrumPeriod * cycleLength / spectrumPeriod, 1));
+        break;
+    }
+    case RazerEffect::Wave: {
+        // One full spectrum over the width of the device that moves across it once per period
+        uchar stepSize = qBound(1, 0xFF * 6 / qMax(static_cast<int>(width), 1), 0xFF);
+        int cycleLength = spectrumCycleLength(stepSize);
+        int position = static_cast<int>(elapsed % wavePeriod * cycleLength / wavePeriod);
+        // Moving the start color backwards makes the colors travel to the right
+        if (currentState.direction == WaveDirection::LEFT_TO_RIGHT)
+            position = cycleLength - position;
+        waveKernel(frame, position % cycleLength, stepSize);
+        break;
+    }
+    default:
+        uniformKernel(frame, {0x00, 0x00, 0x00});
+        break;
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HARDWAREEFFECTMODEL_H
+#define HARDWAREEFFECTMODEL_H
+
+#include "../razer_test.h"
+#include "colorkernels.h"
+#include "customframe.h"
+#include "effectkernels.h"
+
+using namespace razer_test;
+
+/**
+ * Software rendering of the effects that the device firmware runs itself.
+ *
+ * Used to blend into a hardware effect before handing off to the device, so
+ * the timings only have to be close to what the firmware does, the frames
+ * are replaced by the real effect at the end of the transition anyway.
+ * Times are in microseconds.
+ */
+class HardwareEffectModel
+{
+public:
+    struct State {
+        RazerEffect effect = RazerEffect::Off;
+        RGBval color1 = {0x00, 0x00, 0x00};
+        RGBval color2 = {0x00, 0x00, 0x00};
+        WaveDirection direction = WaveDirection::LEFT_TO_RIGHT;
+    };
+
+    // Approximate timings of the firmware effects
+    static const qint64 breathingPeriod = 4000000;
+    static const qint64 spectrumPeriod = 12000000;
+    static const qint64 wavePeriod = 3000000;
+
+    HardwareEffectModel(uchar width, uchar height);
+
+    // Whether the effect can be rendered in software, e.g. reactive depends on key presses
+    static bool canModel(RazerEffect effect);
+
+    // The effect starts at startTime, like the firmware which starts over on every effect command
+    void setState(const State &state, qint64 startTime);
+    const State &state() const;
+
+    void render(qint64 now, CustomFrame &frame) const;
+
+private:
+    uchar width;
+    uchar height;
+    State currentState;
+    qint64 startTime = 0;
+    UniformKernel uniformKernel;
+    WaveKernel waveKernel;
+};
+
+#endif // HARDWAREEFFECTMODEL_H
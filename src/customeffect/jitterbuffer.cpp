@@ -0,0 +1,83 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "jitterbuffer.h"
+
+const qint64 JitterBuffer::horizon;
+
+bool JitterBuffer::push(qint64 presentationTime, const CustomFrame &frame, qint64 now)
+{
+    if (presentationTime - now > horizon)
+        return false;
+    if (frames.size() >= capacity && !frames.contains(presentationTime))
+        return false;
+    frames.insert(presentationTime, frame);
+    return true;
+}
+
+bool JitterBuffer::push(qint64 presentationTime, const CustomFrame &frame)
+{
+    return push(presentationTime, frame, monotonicTime());
+}
+
+bool JitterBuffer::isEmpty() const
+{
+    return frames.isEmpty();
+}
+
+void JitterBuffer::clear()
+{
+    frames.clear();
+}
+
+qint64 JitterBuffer::nextSendTime() const
+{
+    return frames.firstKey() - latency();
+}
+
+bool JitterBuffer::takeDue(qint64 now, qint64 *presentationTime, CustomFrame *frame, QVector<qint64> *dropped)
+{
+    if (frames.isEmpty() || nextSendTime() > now)
+        return false;
+
+    // Newest frame that is due
+    auto due = frames.upperBound(now + latency());
+    --due;
+    while (frames.begin() != due) {
+        dropped->append(frames.firstKey());
+        frames.erase(frames.begin());
+    }
+    *presentationTime = due.key();
+    *frame = due.value();
+    frames.erase(due);
+    return true;
+}
+
+void JitterBuffer::addLatencySample(qint64 latency)
+{
+    // Exponential moving average, a single slow report shouldn't shift all following frames
+    if (latencyEstimate < 0)
+        latencyEstimate = latency;
+    else
+        latencyEstimate += (latency - latencyEstimate) / 8;
+}
+
+qint64 JitterBuffer::latency() const
+{
+    return latencyEstimate < 0 ? 0 : latencyEstimate;
+}
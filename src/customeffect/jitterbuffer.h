@@ -0,0 +1,70 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JITTERBUFFER_H
+#define JITTERBUFFER_H
+
+#include <QMap>
+#include <QVector>
+
+#include <chrono>
+
+#include "customframe.h"
+
+// Microseconds on the monotonic clock (CLOCK_MONOTONIC on Linux), the time base of presentation timestamps
+inline qint64 monotonicTime()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Holds frames submitted by a client until their presentation time.
+ *
+ * A frame is due once its presentation time minus the latency of the device
+ * has been reached, so it is fully shown on the device at its timestamp.
+ * If several frames are due at once only the newest one is shown.
+ */
+class JitterBuffer
+{
+public:
+    static const int capacity = 8;
+    // How far ahead of now frames are accepted, so far-future frames can't fill the buffer for good
+    static const qint64 horizon = 5000000;
+
+    // Returns false if the buffer is full or the frame is due more than horizon after now.
+    // A frame with the same timestamp is replaced.
+    bool push(qint64 presentationTime, const CustomFrame &frame, qint64 now);
+    bool push(qint64 presentationTime, const CustomFrame &frame);
+    bool isEmpty() const;
+    void clear();
+
+    // Time at which the next frame has to be sent to the device
+    qint64 nextSendTime() const;
+    // Takes the newest frame that is due at now, the timestamps of older due frames are appended to dropped
+    bool takeDue(qint64 now, qint64 *presentationTime, CustomFrame *frame, QVector<qint64> *dropped);
+
+    // Time it took to send a frame to the device, in microseconds
+    void addLatencySample(qint64 latency);
+    qint64 latency() const;
+
+private:
+    QMap<qint64, CustomFrame> frames;
+    qint64 latencyEstimate = -1;
+};
+
+#endif // JITTERBUFFER_H
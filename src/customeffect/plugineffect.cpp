@@ -0,0 +1,68 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "plugineffect.h"
+
+PluginEffect::PluginEffect(const razer_test_effect *effect, uchar width, uchar height) : CustomEffectBase(width, height), effect(effect)
+{
+}
+
+PluginEffect::~PluginEffect()
+{
+    if (instance != nullptr)
+        effect->destroy(instance);
+}
+
+bool PluginEffect::initialize()
+{
+    // Start from a fresh instance, the plugin keeps its animation state in there
+    if (instance != nullptr)
+        effect->destroy(instance);
+    msleep = effect->fps > 0 ? 1000 / effect->fps : 1000;
+    instance = effect->create(width, height);
+    if (instance == nullptr) {
+        qWarning("Plugin effect %s failed to create an instance.", effect->name);
+        return false;
+    }
+    return true;
+}
+
+void PluginEffect::prepareRgbData(CustomFrame &frame)
+{
+    if (instance == nullptr)
+        return;
+
+    razer_test_effect_frame pluginFrame;
+    pluginFrame.width = frame.width();
+    pluginFrame.height = frame.height();
+    pluginFrame.stride = frame.rowSize();
+    pluginFrame.rgb_data = frame.data();
+    effect->render(instance, &pluginFrame);
+}
+
+int PluginEffect::period() const
+{
+    if (effect->flags & RAZER_TEST_EFFECT_PERIODIC)
+        return effect->period;
+    return 0;
+}
+
+bool PluginEffect::isStatic() const
+{
+    return effect->flags & RAZER_TEST_EFFECT_STATIC;
+}
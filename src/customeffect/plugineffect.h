@@ -0,0 +1,44 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PLUGINEFFECT_H
+#define PLUGINEFFECT_H
+
+#include "customeffectbase.h"
+#include "../razer_test_effect.h"
+
+/**
+ * Adapter between CustomEffectBase and an effect loaded from a plugin.
+ */
+class PluginEffect : public CustomEffectBase
+{
+public:
+    PluginEffect(const razer_test_effect *effect, uchar width, uchar height);
+    ~PluginEffect() override;
+
+    bool initialize() override;
+    void prepareRgbData(CustomFrame &frame) override;
+    int period() const override;
+    bool isStatic() const override;
+
+private:
+    const razer_test_effect *effect;
+    void *instance = nullptr;
+};
+
+#endif // PLUGINEFFECT_H
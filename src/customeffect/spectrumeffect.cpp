@@ -18,65 +18,24 @@
 
 #include "spectrumeffect.h"
 
-void SpectrumEffect::initialize()
+bool SpectrumEffect::initialize()
 {
-    rgbVal = {0xFF, 0x00, 0x00}; // Red
-    nextColor = SpectrumColor::Yellow;
+    position = 0; // Red
     msleep = 100;
+    kernel = selectUniformKernel(width, height);
+    return true;
 }
 
-void SpectrumEffect::prepareRgbData()
+int SpectrumEffect::period() const
 {
-    // Iterate through rows
-    for (uchar i = 0; i < height; i++) {
-        // Iterate through columns
-        for (int j = 0; j < width * 3; j++) {
-            rgbData[i][j++] = rgbVal.red;
-            rgbData[i][j++] = rgbVal.green;
-            rgbData[i][j] = rgbVal.blue;
-        }
+    // Every frame advances the color by one step
+    return spectrumCycleLength(0x10);
+}
 
-        // Send data to keyboard
-        emit rgbDataReady(i, rgbData[i]);
-    }
+void SpectrumEffect::prepareRgbData(CustomFrame &frame)
+{
+    // The whole matrix shows the same color
+    kernel(frame, spectrumColor(position, 0x10));
 
-    // FF0000 Red
-    // Increase Green until
-    // FFFF00 Yellow
-    // Decrease Red until
-    // 00FF00 Green
-    // Increase Blue until
-    // 00FFFF Cyan
-    // Decrease Green until
-    // 0000FF Blue
-    // Increase Red until
-    // FF00FF Magenta
-    // Decrease Blue until
-    // FF0000 Red
-    // REPEAT
-    if (nextColor == SpectrumColor::Yellow) {
-        rgbVal.green = increaseByNoOverflow(rgbVal.green, 0x10);
-        if (rgbVal.green == 0xFF)
-            nextColor = SpectrumColor::Green;
-    } else if (nextColor == SpectrumColor::Green) {
-        rgbVal.red = decreaseByNoUnderflow(rgbVal.red, 0x10);
-        if (rgbVal.red == 0x00)
-            nextColor = SpectrumColor::Cyan;
-    } else if (nextColor == SpectrumColor::Cyan) {
-        rgbVal.blue = increaseByNoOverflow(rgbVal.blue, 0x10);
-        if (rgbVal.blue == 0xFF)
-            nextColor = SpectrumColor::Blue;
-    } else if (nextColor == SpectrumColor::Blue) {
-        rgbVal.green = decreaseByNoUnderflow(rgbVal.green, 0x10);
-        if (rgbVal.green == 0x00)
-            nextColor = SpectrumColor::Magenta;
-    } else if (nextColor == SpectrumColor::Magenta) {
-        rgbVal.red = increaseByNoOverflow(rgbVal.red, 0x10);
-        if (rgbVal.red == 0xFF)
-            nextColor = SpectrumColor::Red;
-    } else if (nextColor == SpectrumColor::Red) {
-        rgbVal.blue = decreaseByNoUnderflow(rgbVal.blue, 0x10);
-        if (rgbVal.blue == 0x00)
-            nextColor = SpectrumColor::Yellow;
-    }
+    position = (position + 1) % spectrumCycleLength(0x10);
 }
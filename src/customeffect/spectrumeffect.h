@@ -20,6 +20,7 @@
 #define SPECTRUMEFFECT_H
 
 #include "customeffectbase.h"
+#include "effectkernels.h"
 
 /**
  * @todo write docs
@@ -29,12 +30,13 @@ class SpectrumEffect : public CustomEffectBase
 public:
     using CustomEffectBase::CustomEffectBase;
 
-    void initialize() override;
-    void prepareRgbData() override;
+    bool initialize() override;
+    void prepareRgbData(CustomFrame &frame) override;
+    int period() const override;
 
 private:
-    RGBval rgbVal;
-    SpectrumColor nextColor;
+    int position;
+    UniformKernel kernel;
 };
 
 #endif // SPECTRUMEFFECT_H
@@ -0,0 +1,83 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+/**
+ * Lock-free single-producer/single-consumer triple buffer.
+ *
+ * The producer always owns one buffer to write into, the consumer always owns
+ * one buffer to read from and the third one is the hand-off slot. Publishing
+ * and fetching just swap indices, so neither side ever blocks or copies and the
+ * consumer always gets the newest complete value.
+ */
+template<typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    // Not thread safe, only call this while neither side is active.
+    void reset(const T &value)
+    {
+        for (T &buffer : buffers)
+            buffer = value;
+        writeIndex = 0;
+        readIndex = 1;
+        middle.store(2, std::memory_order_relaxed);
+    }
+
+    // Producer side
+    T &writeBuffer()
+    {
+        return buffers[writeIndex];
+    }
+
+    void publish()
+    {
+        writeIndex = middle.exchange(writeIndex | FreshBit, std::memory_order_acq_rel) & IndexMask;
+    }
+
+    // Consumer side
+    bool fetch()
+    {
+        if (!(middle.load(std::memory_order_relaxed) & FreshBit))
+            return false;
+        readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & IndexMask;
+        return true;
+    }
+
+    const T &readBuffer() const
+    {
+        return buffers[readIndex];
+    }
+
+private:
+    static constexpr int IndexMask = 0x03;
+    static constexpr int FreshBit = 0x04;
+
+    T buffers[3];
+    int writeIndex = 0;
+    int readIndex = 1;
+    std::atomic<int> middle {2};
+};
+
+#endif // TRIPLEBUFFER_H
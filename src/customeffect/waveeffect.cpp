@@ -18,73 +18,32 @@
 
 #include "waveeffect.h"
 
-void WaveEffect::initialize()
+bool WaveEffect::initialize()
 {
-    startVal = {0xFF, 0x00, 0x00}; // Red
-    startNextColor = SpectrumColor::Yellow;
+    startPosition = 0; // Red
     msleep = 100;
+    kernel = selectWaveKernel(width, height);
+    return true;
 }
 
-void WaveEffect::prepareRgbData()
+int WaveEffect::period() const
 {
-    // Iterate through rows
-    for (uchar i = 0; i < height; i++) {
-        RGBval rowVal = startVal;
-        SpectrumColor nextColor = startNextColor;
-        // Iterate through columns
-        for (int j = 0; j < width * 3; j++) {
-            rgbData[i][j++] = rowVal.red;
-            rgbData[i][j++] = rowVal.green;
-            rgbData[i][j] = rowVal.blue;
-
-            // FF0000 Red
-            // Increase Green until
-            // FFFF00 Yellow
-            // Decrease Red until
-            // 00FF00 Green
-            // Increase Blue until
-            // 00FFFF Cyan
-            // Decrease Green until
-            // 0000FF Blue
-            // Increase Red until
-            // FF00FF Magenta
-            // Decrease Blue until
-            // FF0000 Red
-            // REPEAT
-            if (nextColor == SpectrumColor::Yellow) {
-                rowVal.green = increaseByNoOverflow(rowVal.green, 0x40);
-                if (rowVal.green == 0xFF)
-                    nextColor = SpectrumColor::Green;
-            } else if (nextColor == SpectrumColor::Green) {
-                rowVal.red = decreaseByNoUnderflow(rowVal.red, 0x40);
-                if (rowVal.red == 0x00)
-                    nextColor = SpectrumColor::Cyan;
-            } else if (nextColor == SpectrumColor::Cyan) {
-                rowVal.blue = increaseByNoOverflow(rowVal.blue, 0x40);
-                if (rowVal.blue == 0xFF)
-                    nextColor = SpectrumColor::Blue;
-            } else if (nextColor == SpectrumColor::Blue) {
-                rowVal.green = decreaseByNoUnderflow(rowVal.green, 0x40);
-                if (rowVal.green == 0x00)
-                    nextColor = SpectrumColor::Magenta;
-            } else if (nextColor == SpectrumColor::Magenta) {
-                rowVal.red = increaseByNoOverflow(rowVal.red, 0x40);
-                if (rowVal.red == 0xFF)
-                    nextColor = SpectrumColor::Red;
-            } else if (nextColor == SpectrumColor::Red) {
-                rowVal.blue = decreaseByNoUnderflow(rowVal.blue, 0x40);
-                if (rowVal.blue == 0x00)
-                    nextColor = SpectrumColor::Yellow;
-            }
-        }
+    // Every frame advances the start color by one step per column, so the
+    // frames repeat after lcm(cycleLength, width) / width frames
+    int cycleLength = spectrumCycleLength(0x40);
+    int a = cycleLength, b = width;
+    while (b != 0) {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    return cycleLength / a;
+}
 
-        // Send data to keyboard
-        emit rgbDataReady(i, rgbData[i]);
+void WaveEffect::prepareRgbData(CustomFrame &frame)
+{
+    kernel(frame, startPosition, 0x40);
 
-        // Last row - keep current data for next frame
-        if (i == height - 1) {
-            startVal = rowVal;
-            startNextColor = nextColor;
-        }
-    }
+    // The next frame continues where the last column left off
+    startPosition = (startPosition + width) % spectrumCycleLength(0x40);
 }
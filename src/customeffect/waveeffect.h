@@ -20,6 +20,7 @@
 #define WAVEEFFECT_H
 
 #include "customeffectbase.h"
+#include "effectkernels.h"
 
 /**
  * @todo write docs
@@ -29,12 +30,13 @@ class WaveEffect : public CustomEffectBase
 public:
     using CustomEffectBase::CustomEffectBase;
 
-    void initialize() override;
-    void prepareRgbData() override;
+    bool initialize() override;
+    void prepareRgbData(CustomFrame &frame) override;
+    int period() const override;
 
 private:
-    RGBval startVal;
-    SpectrumColor startNextColor;
+    int startPosition;
+    WaveKernel kernel;
 };
 
 #endif // WAVEEFFECT_H
@@ -0,0 +1,85 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "clientqos.h"
+#include "../customeffect/jitterbuffer.h"
+
+// A few commands in a row, e.g. setting every LED of a device, then a steady rate
+const ClientQos::Limit ClientQos::defaultControlLimit = {30, 60};
+// A keyboard sends 7 rows per frame with defineCustomFrame, that's 144 fps
+const ClientQos::Limit ClientQos::defaultBulkLimit = {1000, 200};
+
+// Buckets are dropped once there are that many clients and they are full again
+static const int maxIdleClients = 64;
+
+ClientQos::ClientQos()
+    : limits {defaultControlLimit, defaultBulkLimit}
+{
+}
+
+void ClientQos::setLimit(TrafficClass trafficClass, Limit limit)
+{
+    limits[index(trafficClass)] = limit;
+}
+
+ClientQos::Limit ClientQos::limit(TrafficClass trafficClass) const
+{
+    return limits[index(trafficClass)];
+}
+
+bool ClientQos::admit(const QString &client, TrafficClass trafficClass, qint64 now)
+{
+    int lane = index(trafficClass);
+    const Limit &limit = limits[lane];
+    auto it = buckets[lane].find(client);
+    if (it == buckets[lane].end()) {
+        if (buckets[lane].size() >= maxIdleClients)
+            forgetIdleClients(lane, now);
+        it = buckets[lane].insert(client, {limit.burst, now});
+    }
+
+    Bucket &bucket = it.value();
+    bucket.tokens = qMin(limit.burst, bucket.tokens + (now - bucket.updated) * limit.rate / 1000000.0);
+    bucket.updated = now;
+    if (bucket.tokens < 1.0)
+        return false;
+    bucket.tokens -= 1.0;
+    return true;
+}
+
+bool ClientQos::admit(const QString &client, TrafficClass trafficClass)
+{
+    return admit(client, trafficClass, monotonicTime());
+}
+
+int ClientQos::index(TrafficClass trafficClass)
+{
+    return trafficClass == TrafficClass::Control ? 0 : 1;
+}
+
+void ClientQos::forgetIdleClients(int lane, qint64 now)
+{
+    const Limit &limit = limits[lane];
+    for (auto it = buckets[lane].begin(); it != buckets[lane].end();) {
+        // A full bucket behaves the same as a new one
+        if (it->tokens + (now - it->updated) * limit.rate / 1000000.0 >= limit.burst)
+            it = buckets[lane].erase(it);
+        else
+            ++it;
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CLIENTQOS_H
+#define CLIENTQOS_H
+
+#include <QHash>
+#include <QString>
+
+/**
+ * Rate limits of the D-Bus clients of a device.
+ *
+ * Every client, identified by its unique bus name or its peer connection, has a token
+ * bucket per traffic class. Interactive commands and frame streaming are limited
+ * separately, so a visualizer streaming frames doesn't use up the budget of its own
+ * control commands and one misbehaving client can't starve the others.
+ */
+class ClientQos
+{
+public:
+    enum class TrafficClass {
+        // Commands a user waits for, e.g. setStatic or setDPI
+        Control,
+        // Frames and frame rows, sent at the frame rate of the client
+        Bulk
+    };
+
+    struct Limit {
+        // Tokens per second
+        double rate;
+        double burst;
+    };
+
+    static const Limit defaultControlLimit;
+    static const Limit defaultBulkLimit;
+
+    ClientQos();
+
+    void setLimit(TrafficClass trafficClass, Limit limit);
+    Limit limit(TrafficClass trafficClass) const;
+
+    // Takes a token from the bucket of the client, false if the client is over its limit.
+    // now is in microseconds of the monotonic clock.
+    bool admit(const QString &client, TrafficClass trafficClass, qint64 now);
+    bool admit(const QString &client, TrafficClass trafficClass);
+
+private:
+    struct Bucket {
+        double tokens;
+        qint64 updated;
+    };
+
+    static int index(TrafficClass trafficClass);
+    void forgetIdleClients(int lane, qint64 now);
+
+    Limit limits[2];
+    QHash<QString, Bucket> buckets[2];
+};
+
+#endif // CLIENTQOS_H
@@ -0,0 +1,81 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dbuscallcontext.h"
+
+DBusCallContext::DBusCallContext(QDBusContext *fallback)
+    : fallback(fallback)
+{
+}
+
+bool DBusCallContext::calledFromDBus() const
+{
+    if (call != nullptr)
+        return true;
+    return fallback->calledFromDBus();
+}
+
+QDBusConnection DBusCallContext::connection() const
+{
+    if (call != nullptr)
+        return call->connection;
+    return fallback->connection();
+}
+
+const QDBusMessage &DBusCallContext::message() const
+{
+    if (call != nullptr)
+        return call->message;
+    return fallback->message();
+}
+
+void DBusCallContext::sendErrorReply(const QString &name, const QString &msg) const
+{
+    if (call != nullptr)
+        call->errorReply = call->message.createErrorReply(name, msg);
+    else
+        fallback->sendErrorReply(name, msg);
+}
+
+void DBusCallContext::sendErrorReply(QDBusError::ErrorType type, const QString &msg) const
+{
+    if (call != nullptr)
+        call->errorReply = call->message.createErrorReply(type, msg);
+    else
+        fallback->sendErrorReply(type, msg);
+}
+
+QString DBusCallContext::clientId() const
+{
+    return clientId(message(), connection());
+}
+
+QString DBusCallContext::clientId(const QDBusMessage &message, const QDBusConnection &connection)
+{
+    // Messages on peer connections have no sender, every peer has its own connection though
+    if (message.service().isEmpty())
+        return connection.name();
+    return message.service();
+}
+
+DBusCallContext::Call *DBusCallContext::swapCall(Call *call)
+{
+    Call *previous = this->call;
+    this->call = call;
+    return previous;
+}
@@ -0,0 +1,61 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DBUSCALLCONTEXT_H
+#define DBUSCALLCONTEXT_H
+
+#include <QDBusConnection>
+#include <QDBusContext>
+#include <QDBusMessage>
+
+/**
+ * QDBusContext for objects that are also called through a DBusDispatcher.
+ *
+ * Qt only sets the context of QDBusContext when it delivers a call to an adaptor or a registered
+ * object. While a DBusDispatcher calls a handler, this class answers with the message of the
+ * dispatcher instead and keeps the error reply, which the dispatcher sends instead of the result.
+ * Classes deriving from both have to pull the functions in with using declarations.
+ */
+class DBusCallContext
+{
+public:
+    explicit DBusCallContext(QDBusContext *fallback);
+
+    bool calledFromDBus() const;
+    QDBusConnection connection() const;
+    const QDBusMessage &message() const;
+    void sendErrorReply(const QString &name, const QString &msg = QString()) const;
+    void sendErrorReply(QDBusError::ErrorType type, const QString &msg = QString()) const;
+    // Identifies the caller across calls, its unique name on a bus or the name of its peer connection
+    QString clientId() const;
+    static QString clientId(const QDBusMessage &message, const QDBusConnection &connection);
+
+    struct Call {
+        const QDBusMessage &message;
+        const QDBusConnection &connection;
+        QDBusMessage errorReply;
+    };
+    // Returns the previous call, to be restored once the handler returned
+    Call *swapCall(Call *call);
+
+private:
+    QDBusContext *fallback;
+    Call *call = nullptr;
+};
+
+#endif // DBUSCALLCONTEXT_H
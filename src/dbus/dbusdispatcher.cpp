@@ -0,0 +1,182 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QDBusVariant>
+
+#include <algorithm>
+
+#include "dbusdispatcher.h"
+
+static const QLatin1String propertiesInterface("org.freedesktop.DBus.Properties");
+static const QLatin1String introspectableInterface("org.freedesktop.DBus.Introspectable");
+static const QLatin1String deviceUnavailableError("io.github.openrazer1.Error.DeviceUnavailable");
+
+DBusDispatcher::DBusDispatcher(const Interface &interface, QObject *target, DBusCallContext *context)
+    : QDBusVirtualObject(target)
+    , interface(interface)
+    , target(target)
+    , context(context)
+{
+}
+
+bool DBusDispatcher::registerOn(QDBusConnection connection, const QString &path)
+{
+    if (!connection.registerVirtualObject(path, this))
+        return false;
+    this->path = path;
+    connections.append(connection);
+    return true;
+}
+
+void DBusDispatcher::setClientQos(ClientQos *qos)
+{
+    this->qos = qos;
+}
+
+void DBusDispatcher::setLeaseArbiter(LeaseArbiter *leases)
+{
+    this->leases = leases;
+}
+
+void DBusDispatcher::setDeviceHealth(const DeviceHealth *health)
+{
+    this->health = health;
+}
+
+QString DBusDispatcher::introspect(const QString &/*path*/) const
+{
+    return QString::fromLatin1(interface.introspection);
+}
+
+bool DBusDispatcher::handleMessage(const QDBusMessage &message, const QDBusConnection &connection)
+{
+    if (message.type() != QDBusMessage::MethodCallMessage)
+        return false;
+
+    const QString interfaceName = message.interface();
+    // Qt answers with introspect() and the standard interfaces
+    if (interfaceName == introspectableInterface)
+        return false;
+    if (interfaceName == propertiesInterface) {
+        handlePropertiesCall(message, connection);
+        return true;
+    }
+
+    QDBusMessage reply;
+    const Method *method = findMethod(message.member());
+    if (!interfaceName.isEmpty() && interfaceName != QLatin1String(interface.name)) {
+        reply = message.createErrorReply(QDBusError::UnknownInterface, QString("No such interface \"%1\".").arg(interfaceName));
+    } else if (method == nullptr) {
+        reply = message.createErrorReply(QDBusError::UnknownMethod, QString("No such method \"%1\".").arg(message.member()));
+    } else if (message.signature() != QLatin1String(method->signature)) {
+        reply = message.createErrorReply(QDBusError::InvalidArgs, QString("Expected signature \"%1\".").arg(method->signature));
+    } else if (qos != nullptr && !qos->admit(DBusCallContext::clientId(message, connection), method->trafficClass)) {
+        reply = message.createErrorReply(QDBusError::LimitsExceeded, "Too many calls, try again later.");
+    } else if (method->usesDevice && health != nullptr && !health->allowRequest()) {
+        reply = message.createErrorReply(deviceUnavailableError, "The device is not responding, try again later.");
+    } else if (method->lighting && leases != nullptr && !leases->mayControl(DBusCallContext::clientId(message, connection))) {
+        // Suspended, the client is told with LightingOwnerChanged and calls again once it owns the lighting
+        if (qstrcmp(method->replySignature, "b") == 0)
+            reply = message.createReply(QVariant(true));
+        else
+            reply = message.createReply();
+    } else {
+        DBusCallContext::Call call {message, connection, QDBusMessage()};
+        DBusCallContext::Call *previous = context->swapCall(&call);
+        QVariant result = method->call(target, message.arguments());
+        context->swapCall(previous);
+
+        if (call.errorReply.type() == QDBusMessage::ErrorMessage)
+            reply = call.errorReply;
+        else if (result.isValid())
+            reply = message.createReply(result);
+        else
+            reply = message.createReply();
+    }
+    if (message.isReplyRequired())
+        connection.send(reply);
+    return true;
+}
+
+void DBusDispatcher::emitSignal(const QString &name, const QList<QVariant> &arguments)
+{
+    QDBusMessage signal = QDBusMessage::createSignal(path, QLatin1String(interface.name), name);
+    signal.setArguments(arguments);
+    for (auto it = connections.begin(); it != connections.end();) {
+        if (it->isConnected()) {
+            it->send(signal);
+            ++it;
+        } else {
+            it = connections.erase(it);
+        }
+    }
+}
+
+const DBusDispatcher::Method *DBusDispatcher::findMethod(const QString &name) const
+{
+    const Method *end = interface.methods + interface.methodCount;
+    const Method *method = std::lower_bound(interface.methods, end, name, [](const Method &method, const QString &name) {
+        return name.compare(QLatin1String(method.name)) > 0;
+    });
+    if (method == end || name != QLatin1String(method->name))
+        return nullptr;
+    return method;
+}
+
+const DBusDispatcher::Property *DBusDispatcher::findProperty(const QString &name) const
+{
+    const Property *end = interface.properties + interface.propertyCount;
+    const Property *property = std::lower_bound(interface.properties, end, name, [](const Property &property, const QString &name) {
+        return name.compare(QLatin1String(property.name)) > 0;
+    });
+    if (property == end || name != QLatin1String(property->name))
+        return nullptr;
+    return property;
+}
+
+void DBusDispatcher::handlePropertiesCall(const QDBusMessage &message, const QDBusConnection &connection)
+{
+    const QList<QVariant> arguments = message.arguments();
+    const QString member = message.member();
+    const QString interfaceName = arguments.value(0).toString();
+    QDBusMessage reply;
+
+    if (!interfaceName.isEmpty() && interfaceName != QLatin1String(interface.name)) {
+        reply = message.createErrorReply(QDBusError::UnknownInterface, QString("No such interface \"%1\".").arg(interfaceName));
+    } else if (member == "Get" && message.signature() == "ss") {
+        const Property *property = findProperty(arguments.at(1).toString());
+        if (property == nullptr)
+            reply = message.createErrorReply(QDBusError::UnknownProperty, QString("No such property \"%1\".").arg(arguments.at(1).toString()));
+        else
+            reply = message.createReply(QVariant::fromValue(QDBusVariant(property->read(target))));
+    } else if (member == "GetAll" && message.signature() == "s") {
+        QVariantMap values;
+        for (int i = 0; i < interface.propertyCount; i++)
+            values.insert(QLatin1String(interface.properties[i].name), interface.properties[i].read(target));
+        reply = message.createReply(values);
+    } else if (member == "Set" && message.signature() == "ssv") {
+        if (findProperty(arguments.at(1).toString()) == nullptr)
+            reply = message.createErrorReply(QDBusError::UnknownProperty, QString("No such property \"%1\".").arg(arguments.at(1).toString()));
+        else
+            reply = message.createErrorReply(QDBusError::PropertyReadOnly, QString("Property \"%1\" is read-only.").arg(arguments.at(1).toString()));
+    } else {
+        reply = message.createErrorReply(QDBusError::UnknownMethod, QString("No such method \"%1\".").arg(member));
+    }
+    if (message.isReplyRequired())
+        connection.send(reply);
+}
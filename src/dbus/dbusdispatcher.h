@@ -0,0 +1,107 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DBUSDISPATCHER_H
+#define DBUSDISPATCHER_H
+
+#include <QDBusVirtualObject>
+#include <QList>
+#include <QVariant>
+
+#include "../device/devicehealth.h"
+#include "clientqos.h"
+#include "dbuscallcontext.h"
+#include "leasearbiter.h"
+
+/**
+ * Exports one D-Bus interface of an object from a table of typed handlers.
+ *
+ * Unlike an adaptor there's no lookup of slots by name and no QMetaObject::invokeMethod():
+ * a call is looked up by member name in the sorted method table, its signature is compared
+ * with the one of the method and the handler decodes the arguments and calls the object.
+ * The tables are generated from the introspection XML by scripts/generate_dbus_dispatch.py.
+ */
+class DBusDispatcher : public QDBusVirtualObject
+{
+    Q_OBJECT
+
+public:
+    typedef QVariant (*MethodHandler)(QObject *target, const QList<QVariant> &arguments);
+    typedef QVariant (*PropertyReader)(QObject *target);
+
+    struct Method {
+        const char *name;
+        const char *signature;
+        // "b" or empty, what a suspended lighting call replies with
+        const char *replySignature;
+        ClientQos::TrafficClass trafficClass;
+        // Changes the lighting, only the owner of the lighting lease is let through
+        bool lighting;
+        // Talks to the device, fails right away while the device doesn't respond
+        bool usesDevice;
+        // Returns an invalid QVariant for methods without a result
+        MethodHandler call;
+    };
+    struct Property {
+        const char *name;
+        PropertyReader read;
+    };
+    // Methods and properties are sorted by name
+    struct Interface {
+        const char *name;
+        const char *introspection;
+        const Method *methods;
+        int methodCount;
+        const Property *properties;
+        int propertyCount;
+    };
+
+    DBusDispatcher(const Interface &interface, QObject *target, DBusCallContext *context);
+
+    // Can be called for several connections with the same path
+    bool registerOn(QDBusConnection connection, const QString &path);
+    // Calls of clients over their limit are rejected with LimitsExceeded
+    void setClientQos(ClientQos *qos);
+    // Lighting calls of clients that don't own the lighting succeed without being called
+    void setLeaseArbiter(LeaseArbiter *leases);
+    // Calls that use the device fail with DeviceUnavailable while its circuit breaker is open
+    void setDeviceHealth(const DeviceHealth *health);
+
+    QString introspect(const QString &path) const override;
+    bool handleMessage(const QDBusMessage &message, const QDBusConnection &connection) override;
+
+protected:
+    // Sends a signal of the interface on every connection the object is registered on
+    void emitSignal(const QString &name, const QList<QVariant> &arguments);
+
+private:
+    const Method *findMethod(const QString &name) const;
+    const Property *findProperty(const QString &name) const;
+    void handlePropertiesCall(const QDBusMessage &message, const QDBusConnection &connection);
+
+    const Interface &interface;
+    QObject *target;
+    DBusCallContext *context;
+    ClientQos *qos = nullptr;
+    LeaseArbiter *leases = nullptr;
+    const DeviceHealth *health = nullptr;
+    QString path;
+    QList<QDBusConnection> connections;
+};
+
+#endif // DBUSDISPATCHER_H
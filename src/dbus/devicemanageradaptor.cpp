@@ -45,3 +45,50 @@ QString DeviceManagerAdaptor::version() const
     return qvariant_cast< QString >(parent()->property("Version"));
 }
 
+QList<razer_test::RazerOperationResult> DeviceManagerAdaptor::applyBatch(const QList<razer_test::RazerOperation> &operations)
+{
+    // handle method call io.github.openrazer1.Manager.applyBatch
+    QList<razer_test::RazerOperationResult> out0;
+    QMetaObject::invokeMethod(parent(), "applyBatch", Q_RETURN_ARG(QList<razer_test::RazerOperationResult>, out0), Q_ARG(QList<razer_test::RazerOperation>, operations));
+    return out0;
+}
+
+bool DeviceManagerAdaptor::applyScene(const QString &name)
+{
+    // handle method call io.github.openrazer1.Manager.applyScene
+    bool out0;
+    QMetaObject::invokeMethod(parent(), "applyScene", Q_RETURN_ARG(bool, out0), Q_ARG(QString, name));
+    return out0;
+}
+
+bool DeviceManagerAdaptor::defineScene(const QString &name, const QList<razer_test::RazerOperation> &operations)
+{
+    // handle method call io.github.openrazer1.Manager.defineScene
+    bool out0;
+    QMetaObject::invokeMethod(parent(), "defineScene", Q_RETURN_ARG(bool, out0), Q_ARG(QString, name), Q_ARG(QList<razer_test::RazerOperation>, operations));
+    return out0;
+}
+
+QVariantMap DeviceManagerAdaptor::getBusUtilization()
+{
+    // handle method call io.github.openrazer1.Manager.getBusUtilization
+    QVariantMap out0;
+    QMetaObject::invokeMethod(parent(), "getBusUtilization", Q_RETURN_ARG(QVariantMap, out0));
+    return out0;
+}
+
+QString DeviceManagerAdaptor::getPeerAddress()
+{
+    // handle method call io.github.openrazer1.Manager.getPeerAddress
+    QString out0;
+    QMetaObject::invokeMethod(parent(), "getPeerAddress", Q_RETURN_ARG(QString, out0));
+    return out0;
+}
+
+bool DeviceManagerAdaptor::removeScene(const QString &name)
+{
+    // handle method call io.github.openrazer1.Manager.removeScene
+    bool out0;
+    QMetaObject::invokeMethod(parent(), "removeScene", Q_RETURN_ARG(bool, out0), Q_ARG(QString, name));
+    return out0;
+}
@@ -11,6 +11,8 @@
 
 #ifndef DEVICEMANAGERADAPTOR_H
 #define DEVICEMANAGERADAPTOR_H
+#include "../razer_test.h"
+using namespace razer_test;
 
 #include <QtCore/QObject>
 #include <QtDBus/QtDBus>
@@ -34,6 +36,33 @@ class DeviceManagerAdaptor: public QDBusAbstractAdaptor
                 "  <interface name=\"io.github.openrazer1.Manager\">\n"
                 "    <property access=\"read\" type=\"ao\" name=\"Devices\"/>\n"
                 "    <property access=\"read\" type=\"s\" name=\"Version\"/>\n"
+                "    <method name=\"applyScene\">\n"
+                "      <arg direction=\"out\" type=\"b\"/>\n"
+                "      <arg direction=\"in\" type=\"s\" name=\"name\"/>\n"
+                "    </method>\n"
+                "    <method name=\"defineScene\">\n"
+                "      <arg direction=\"out\" type=\"b\"/>\n"
+                "      <arg direction=\"in\" type=\"s\" name=\"name\"/>\n"
+                "      <arg direction=\"in\" type=\"a(osav)\" name=\"operations\"/>\n"
+                "      <annotation value=\"QList&lt;razer_test::RazerOperation&gt;\" name=\"org.qtproject.QtDBus.QtTypeName.In1\"/>\n"
+                "    </method>\n"
+                "    <method name=\"removeScene\">\n"
+                "      <arg direction=\"out\" type=\"b\"/>\n"
+                "      <arg direction=\"in\" type=\"s\" name=\"name\"/>\n"
+                "    </method>\n"
+                "    <method name=\"applyBatch\">\n"
+                "      <arg direction=\"out\" type=\"a(bs)\"/>\n"
+                "      <arg direction=\"in\" type=\"a(osav)\" name=\"operations\"/>\n"
+                "      <annotation value=\"QList&lt;razer_test::RazerOperationResult&gt;\" name=\"org.qtproject.QtDBus.QtTypeName.Out0\"/>\n"
+                "      <annotation value=\"QList&lt;razer_test::RazerOperation&gt;\" name=\"org.qtproject.QtDBus.QtTypeName.In0\"/>\n"
+                "    </method>\n"
+                "    <method name=\"getPeerAddress\">\n"
+                "      <arg direction=\"out\" type=\"s\"/>\n"
+                "    </method>\n"
+                "    <method name=\"getBusUtilization\">\n"
+                "      <arg direction=\"out\" type=\"a{sv}\"/>\n"
+                "      <annotation value=\"QVariantMap\" name=\"org.qtproject.QtDBus.QtTypeName.Out0\"/>\n"
+                "    </method>\n"
                 "  </interface>\n"
                 "")
 public:
@@ -48,6 +77,12 @@ public: // PROPERTIES
     QString version() const;
 
 public Q_SLOTS: // METHODS
+    QList<razer_test::RazerOperationResult> applyBatch(const QList<razer_test::RazerOperation> &operations);
+    bool applyScene(const QString &name);
+    bool defineScene(const QString &name, const QList<razer_test::RazerOperation> &operations);
+    QVariantMap getBusUtilization();
+    QString getPeerAddress();
+    bool removeScene(const QString &name);
 Q_SIGNALS: // SIGNALS
 };
 
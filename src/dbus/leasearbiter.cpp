@@ -0,0 +1,142 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QDBusConnectionInterface>
+#include <QDBusReply>
+#include <QDBusServiceWatcher>
+#include <QTimer>
+
+#include <algorithm>
+
+#include "leasearbiter.h"
+
+// Peer connections don't tell when they are closed, so they are polled
+static const int peerCheckInterval = 1000;
+
+LeaseArbiter::LeaseArbiter(QObject *parent)
+    : QObject(parent)
+{
+    peerTimer = new QTimer(this);
+    peerTimer->setInterval(peerCheckInterval);
+    connect(peerTimer, &QTimer::timeout, this, &LeaseArbiter::checkPeers);
+}
+
+void LeaseArbiter::acquire(const QString &client, uchar priority)
+{
+    auto it = std::find_if(leases.begin(), leases.end(), [&client](const Lease &lease) {
+        return lease.client == client;
+    });
+    if (it != leases.end()) {
+        it->priority = priority;
+    } else {
+        leases.append({client, priority, nextSequence++});
+    }
+    update();
+}
+
+bool LeaseArbiter::release(const QString &client)
+{
+    auto it = std::find_if(leases.begin(), leases.end(), [&client](const Lease &lease) {
+        return lease.client == client;
+    });
+    if (it == leases.end())
+        return false;
+    leases.erase(it);
+
+    if (watcher != nullptr)
+        watcher->removeWatchedService(client);
+    peers.remove(client);
+    if (peers.isEmpty())
+        peerTimer->stop();
+    update();
+    return true;
+}
+
+void LeaseArbiter::watch(const QString &client, const QDBusConnection &connection)
+{
+    if (!holds(client))
+        return;
+
+    // Only bus connections have the interface of the bus daemon
+    if (connection.interface() == nullptr) {
+        if (!connection.isConnected()) {
+            release(client);
+            return;
+        }
+        peers.insert(client, connection);
+        if (!peerTimer->isActive())
+            peerTimer->start();
+        return;
+    }
+
+    if (watcher == nullptr) {
+        watcher = new QDBusServiceWatcher(QString(), connection, QDBusServiceWatcher::WatchForUnregistration, this);
+        connect(watcher, &QDBusServiceWatcher::serviceUnregistered, this, [this](const QString &service) {
+            release(service);
+        });
+    }
+    watcher->addWatchedService(client);
+    // A client that exited before its call was handled is already gone, its NameOwnerChanged won't come again
+    QDBusReply<bool> registered = connection.interface()->isServiceRegistered(client);
+    if (registered.isValid() && !registered.value())
+        release(client);
+}
+
+bool LeaseArbiter::holds(const QString &client) const
+{
+    return std::any_of(leases.begin(), leases.end(), [&client](const Lease &lease) {
+        return lease.client == client;
+    });
+}
+
+QString LeaseArbiter::owner() const
+{
+    return currentOwner;
+}
+
+bool LeaseArbiter::mayControl(const QString &client) const
+{
+    return currentOwner.isEmpty() || currentOwner == client;
+}
+
+void LeaseArbiter::checkPeers()
+{
+    QStringList gone;
+    for (auto it = peers.constBegin(); it != peers.constEnd(); ++it) {
+        if (!it.value().isConnected())
+            gone.append(it.key());
+    }
+    foreach (const QString &client, gone)
+        release(client);
+}
+
+void LeaseArbiter::update()
+{
+    std::stable_sort(leases.begin(), leases.end(), [](const Lease &a, const Lease &b) {
+        if (a.priority != b.priority)
+            return a.priority > b.priority;
+        return a.sequence > b.sequence;
+    });
+
+    QString owner = leases.isEmpty() ? QString() : leases.first().client;
+    if (owner == currentOwner)
+        return;
+    QString previous = currentOwner;
+    currentOwner = owner;
+    emit ownerChanged(previous, owner);
+}
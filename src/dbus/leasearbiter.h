@@ -0,0 +1,82 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LEASEARBITER_H
+#define LEASEARBITER_H
+
+#include <QDBusConnection>
+#include <QHash>
+#include <QObject>
+#include <QVector>
+
+class QDBusServiceWatcher;
+class QTimer;
+
+/**
+ * Decides which D-Bus client controls the lighting of a device.
+ *
+ * Clients acquire a lease with a priority. The highest priority lease owns the lighting,
+ * of equal priorities the most recent one. The other clients are suspended until the leases
+ * above them end, which happens when they are released or the client goes away. Without any
+ * lease every client is in control, like before leases existed.
+ */
+class LeaseArbiter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LeaseArbiter(QObject *parent = nullptr);
+
+    // Acquiring again changes the priority of the lease, but keeps its place among equal priorities
+    void acquire(const QString &client, uchar priority);
+    bool release(const QString &client);
+    // Releases the lease once the client disconnects from connection
+    void watch(const QString &client, const QDBusConnection &connection);
+
+    bool holds(const QString &client) const;
+    // Empty if there is no lease
+    QString owner() const;
+    bool mayControl(const QString &client) const;
+
+Q_SIGNALS:
+    void ownerChanged(const QString &previous, const QString &owner);
+
+private slots:
+    void checkPeers();
+
+private:
+    struct Lease {
+        QString client;
+        uchar priority;
+        quint64 sequence;
+    };
+
+    void update();
+
+    // Sorted by priority and sequence, the owner comes first
+    QVector<Lease> leases;
+    quint64 nextSequence = 0;
+    QString currentOwner;
+
+    // Bus clients are released on NameOwnerChanged, peers when their connection is gone
+    QDBusServiceWatcher *watcher = nullptr;
+    QHash<QString, QDBusConnection> peers;
+    QTimer *peerTimer;
+};
+
+#endif // LEASEARBITER_H
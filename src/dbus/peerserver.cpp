@@ -0,0 +1,112 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <dbus/dbus.h>
+
+#include "dbusdispatcher.h"
+#include "peerserver.h"
+
+QList<QDBusConnection> PeerServer::peers;
+
+// Same as the bus policy in io.github.openrazer1.conf, every local user may talk to the daemon
+static dbus_bool_t allowUnixUser(DBusConnection */*connection*/, unsigned long /*uid*/, void */*data*/)
+{
+    return TRUE;
+}
+
+PeerServer::PeerServer(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void PeerServer::registerObject(const QString &path, QObject *object)
+{
+    objects.insert(path, object);
+}
+
+bool PeerServer::listen(const QString &address)
+{
+    server = new QDBusServer(address, this);
+    if (!server->isConnected()) {
+        qWarning("Failed to listen on \"%s\": %s", qUtf8Printable(address), qUtf8Printable(server->lastError().message()));
+        delete server;
+        server = nullptr;
+        return false;
+    }
+    // Qt only hands out the connection once libdbus may already be authenticating it, so the policy
+    // is installed in newConnection(). Anonymous clients get that far and are refused there.
+    server->setAnonymousAuthenticationAllowed(true);
+    connect(server, &QDBusServer::newConnection, this, &PeerServer::newConnection);
+    qInfo("Listening for peer connections on \"%s\".", qUtf8Printable(server->address()));
+    return true;
+}
+
+QString PeerServer::address() const
+{
+    if (server == nullptr)
+        return QString();
+    return server->address();
+}
+
+QList<QDBusConnection> PeerServer::connections()
+{
+    for (auto it = peers.begin(); it != peers.end();) {
+        if (it->isConnected())
+            ++it;
+        else
+            it = peers.erase(it);
+    }
+    return peers;
+}
+
+bool PeerServer::peerUid(const QDBusConnection &connection, uint *uid)
+{
+    auto *dbusConnection = static_cast<DBusConnection *>(connection.internalPointer());
+    unsigned long peerUid;
+    if (dbusConnection == nullptr || !dbus_connection_get_unix_user(dbusConnection, &peerUid))
+        return false;
+    *uid = static_cast<uint>(peerUid);
+    return true;
+}
+
+void PeerServer::newConnection(const QDBusConnection &connection)
+{
+    QDBusConnection peer(connection);
+    // Without a unix user function libdbus only accepts root and the user of the daemon
+    auto *dbusConnection = static_cast<DBusConnection *>(peer.internalPointer());
+    dbus_connection_set_unix_user_function(dbusConnection, allowUnixUser, nullptr, nullptr);
+    dbus_connection_set_allow_anonymous(dbusConnection, FALSE);
+    // Clients that authenticated before the policy was installed are checked here
+    uint uid;
+    if (dbus_connection_get_is_authenticated(dbusConnection)
+            && !(peerUid(peer, &uid) && allowUnixUser(dbusConnection, uid, nullptr))) {
+        qWarning("Refused an anonymous peer connection.");
+        QDBusConnection::disconnectFromPeer(peer.name());
+        return;
+    }
+
+    for (auto it = objects.constBegin(); it != objects.constEnd(); ++it) {
+        auto *dispatcher = qobject_cast<DBusDispatcher *>(it.value());
+        bool ok = dispatcher != nullptr ? dispatcher->registerOn(peer, it.key()) : peer.registerObject(it.key(), it.value());
+        if (!ok)
+            qWarning("Failed to register D-Bus object at \"%s\" on a peer connection.", qUtf8Printable(it.key()));
+    }
+    // Forgets the peers that went away in the meantime
+    connections();
+    peers.append(peer);
+}
@@ -0,0 +1,60 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PEERSERVER_H
+#define PEERSERVER_H
+
+#include <QDBusConnection>
+#include <QDBusServer>
+#include <QHash>
+#include <QObject>
+
+/**
+ * Private D-Bus endpoint that exports the same objects as the system bus.
+ *
+ * Clients connect with QDBusConnection::connectToPeer() to the address returned by
+ * io.github.openrazer1.Manager.getPeerAddress, messages then don't go through the bus daemon.
+ */
+class PeerServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PeerServer(QObject *parent = nullptr);
+
+    // Objects have to be registered before listen() to be available on every connection.
+    // A DBusDispatcher is registered as virtual object.
+    void registerObject(const QString &path, QObject *object);
+    bool listen(const QString &address = "unix:tmpdir=/tmp");
+    QString address() const;
+
+    // Connected peers, to send signals that aren't relayed by adaptors
+    static QList<QDBusConnection> connections();
+    // Unix user of the client on a peer connection, false if it hasn't authenticated yet
+    static bool peerUid(const QDBusConnection &connection, uint *uid);
+
+private slots:
+    void newConnection(const QDBusConnection &connection);
+
+private:
+    QDBusServer *server = nullptr;
+    QHash<QString, QObject *> objects;
+    static QList<QDBusConnection> peers;
+};
+
+#endif // PEERSERVER_H
@@ -0,0 +1,58 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QStringList>
+
+#include "peerserver.h"
+#include "propertiesnotifier.h"
+
+const int PropertiesNotifier::coalesceInterval;
+
+PropertiesNotifier::PropertiesNotifier(QObject *parent)
+    : QObject(parent)
+{
+    timer = new QTimer(this);
+    timer->setSingleShot(true);
+    connect(timer, &QTimer::timeout, this, &PropertiesNotifier::flush);
+}
+
+void PropertiesNotifier::propertyChanged(const PropertyChange &change)
+{
+    Changes &changes = pending[change.path.path()];
+    changes.interface = change.interface;
+    // Only the latest value is sent
+    changes.properties.insert(change.name, change.value);
+    // Not restarted on every change, a continuous stream of changes is still sent every interval
+    if (!timer->isActive())
+        timer->start(coalesceInterval);
+}
+
+void PropertiesNotifier::flush()
+{
+    timer->stop();
+    for (auto it = pending.constBegin(); it != pending.constEnd(); ++it) {
+        QDBusMessage signal = QDBusMessage::createSignal(it.key(), "org.freedesktop.DBus.Properties", "PropertiesChanged");
+        signal << it.value().interface << it.value().properties << QStringList();
+        QDBusConnection::systemBus().send(signal);
+        foreach (QDBusConnection peer, PeerServer::connections())
+            peer.send(signal);
+    }
+    pending.clear();
+}
@@ -0,0 +1,67 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROPERTIESNOTIFIER_H
+#define PROPERTIESNOTIFIER_H
+
+#include <QDBusObjectPath>
+#include <QHash>
+#include <QObject>
+#include <QTimer>
+#include <QVariantMap>
+
+struct PropertyChange {
+    QDBusObjectPath path;
+    QString interface;
+    QString name;
+    QVariant value;
+};
+
+/**
+ * Emits org.freedesktop.DBus.Properties.PropertiesChanged for the properties of an object.
+ *
+ * Changes are collected for a short time and sent as one signal per object,
+ * so dragging a brightness slider doesn't flood the bus.
+ */
+class PropertiesNotifier : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Longest time a change waits before it is sent, in milliseconds
+    static const int coalesceInterval = 50;
+
+    explicit PropertiesNotifier(QObject *parent = nullptr);
+
+    void propertyChanged(const PropertyChange &change);
+
+public slots:
+    void flush();
+
+private:
+    struct Changes {
+        QString interface;
+        QVariantMap properties;
+    };
+
+    // By object path
+    QHash<QString, Changes> pending;
+    QTimer *timer;
+};
+
+#endif // PROPERTIESNOTIFIER_H
@@ -33,6 +33,12 @@ RazerDeviceAdaptor::~RazerDeviceAdaptor()
     // destructor
 }
 
+RazerDPI RazerDeviceAdaptor::dPI() const
+{
+    // get the value of property DPI
+    return qvariant_cast< RazerDPI >(parent()->property("DPI"));
+}
+
 QList<QDBusObjectPath> RazerDeviceAdaptor::leds() const
 {
     // get the value of property Leds
@@ -51,6 +57,12 @@ QString RazerDeviceAdaptor::name() const
     return qvariant_cast< QString >(parent()->property("Name"));
 }
 
+ushort RazerDeviceAdaptor::pollRate() const
+{
+    // get the value of property PollRate
+    return qvariant_cast< ushort >(parent()->property("PollRate"));
+}
+
 QStringList RazerDeviceAdaptor::supportedFeatures() const
 {
     // get the value of property SupportedFeatures
@@ -69,6 +81,22 @@ QString RazerDeviceAdaptor::type() const
     return qvariant_cast< QString >(parent()->property("Type"));
 }
 
+bool RazerDeviceAdaptor::acquireLighting(uchar priority)
+{
+    // handle method call io.github.openrazer1.Device.acquireLighting
+    bool out0;
+    QMetaObject::invokeMethod(parent(), "acquireLighting", Q_RETURN_ARG(bool, out0), Q_ARG(uchar, priority));
+    return out0;
+}
+
+bool RazerDeviceAdaptor::commit()
+{
+    // handle method call io.github.openrazer1.Device.commit
+    bool out0;
+    QMetaObject::invokeMethod(parent(), "commit", Q_RETURN_ARG(bool, out0));
+    return out0;
+}
+
 bool RazerDeviceAdaptor::defineCustomFrame(uchar row, uchar startColumn, uchar endColumn, const QByteArray &rgbData)
 {
     // handle method call io.github.openrazer1.Device.defineCustomFrame
@@ -77,6 +105,14 @@ bool RazerDeviceAdaptor::defineCustomFrame(uchar row, uchar startColumn, uchar e
     return out0;
 }
 
+bool RazerDeviceAdaptor::defineLayerFrame(uchar layer, uchar row, uchar startColumn, uchar endColumn, const QByteArray &rgbData)
+{
+    // handle method call io.github.openrazer1.Device.defineLayerFrame
+    bool out0;
+    QMetaObject::invokeMethod(parent(), "defineLayerFrame", Q_RETURN_ARG(bool, out0), Q_ARG(uchar, layer), Q_ARG(uchar, row), Q_ARG(uchar, startColumn), Q_ARG(uchar, endColumn), Q_ARG(QByteArray, rgbData));
+    return out0;
+}
+
 bool RazerDeviceAdaptor::displayCustomFrame()
 {
     // handle method call io.github.openrazer1.Device.displayCustomFrame
@@ -109,6 +145,14 @@ QString RazerDeviceAdaptor::getKeyboardLayout()
     return out0;
 }
 
+QString RazerDeviceAdaptor::getLightingOwner()
+{
+    // handle method call io.github.openrazer1.Device.getLightingOwner
+    QString out0;
+    QMetaObject::invokeMethod(parent(), "getLightingOwner", Q_RETURN_ARG(QString, out0));
+    return out0;
+}
+
 ushort RazerDeviceAdaptor::getMaxDPI()
 {
     // handle method call io.github.openrazer1.Device.getMaxDPI
@@ -117,6 +161,14 @@ ushort RazerDeviceAdaptor::getMaxDPI()
     return out0;
 }
 
+qlonglong RazerDeviceAdaptor::getMonotonicTime()
+{
+    // handle method call io.github.openrazer1.Device.getMonotonicTime
+    qlonglong out0;
+    QMetaObject::invokeMethod(parent(), "getMonotonicTime", Q_RETURN_ARG(qlonglong, out0));
+    return out0;
+}
+
 ushort RazerDeviceAdaptor::getPollRate()
 {
     // handle method call io.github.openrazer1.Device.getPollRate
@@ -139,6 +191,46 @@ void RazerDeviceAdaptor::pauseCustomEffectThread()
     QMetaObject::invokeMethod(parent(), "pauseCustomEffectThread");
 }
 
+bool RazerDeviceAdaptor::playAnimation(const QDBusUnixFileDescriptor &file, bool loop)
+{
+    // handle method call io.github.openrazer1.Device.playAnimation
+    bool out0;
+    QMetaObject::invokeMethod(parent(), "playAnimation", Q_RETURN_ARG(bool, out0), Q_ARG(QDBusUnixFileDescriptor, file), Q_ARG(bool, loop));
+    return out0;
+}
+
+bool RazerDeviceAdaptor::releaseLighting()
+{
+    // handle method call io.github.openrazer1.Device.releaseLighting
+    bool out0;
+    QMetaObject::invokeMethod(parent(), "releaseLighting", Q_RETURN_ARG(bool, out0));
+    return out0;
+}
+
+bool RazerDeviceAdaptor::removeLayer(uchar layer)
+{
+    // handle method call io.github.openrazer1.Device.removeLayer
+    bool out0;
+    QMetaObject::invokeMethod(parent(), "removeLayer", Q_RETURN_ARG(bool, out0), Q_ARG(uchar, layer));
+    return out0;
+}
+
+bool RazerDeviceAdaptor::setColorCorrection(double gamma, double redGain, double greenGain, double blueGain)
+{
+    // handle method call io.github.openrazer1.Device.setColorCorrection
+    bool out0;
+    QMetaObject::invokeMethod(parent(), "setColorCorrection", Q_RETURN_ARG(bool, out0), Q_ARG(double, gamma), Q_ARG(double, redGain), Q_ARG(double, greenGain), Q_ARG(double, blueGain));
+    return out0;
+}
+
+bool RazerDeviceAdaptor::setCommitDelay(ushort milliseconds)
+{
+    // handle method call io.github.openrazer1.Device.setCommitDelay
+    bool out0;
+    QMetaObject::invokeMethod(parent(), "setCommitDelay", Q_RETURN_ARG(bool, out0), Q_ARG(ushort, milliseconds));
+    return out0;
+}
+
 bool RazerDeviceAdaptor::setDPI(razer_test::RazerDPI dpi)
 {
     // handle method call io.github.openrazer1.Device.setDPI
@@ -147,6 +239,22 @@ bool RazerDeviceAdaptor::setDPI(razer_test::RazerDPI dpi)
     return out0;
 }
 
+bool RazerDeviceAdaptor::setFrameInterpolation(const QString &mode)
+{
+    // handle method call io.github.openrazer1.Device.setFrameInterpolation
+    bool out0;
+    QMetaObject::invokeMethod(parent(), "setFrameInterpolation", Q_RETURN_ARG(bool, out0), Q_ARG(QString, mode));
+    return out0;
+}
+
+bool RazerDeviceAdaptor::setLayerProperties(uchar layer, const QString &blendMode, uchar opacity)
+{
+    // handle method call io.github.openrazer1.Device.setLayerProperties
+    bool out0;
+    QMetaObject::invokeMethod(parent(), "setLayerProperties", Q_RETURN_ARG(bool, out0), Q_ARG(uchar, layer), Q_ARG(QString, blendMode), Q_ARG(uchar, opacity));
+    return out0;
+}
+
 bool RazerDeviceAdaptor::setPollRate(ushort poll_rate)
 {
     // handle method call io.github.openrazer1.Device.setPollRate
@@ -155,6 +263,22 @@ bool RazerDeviceAdaptor::setPollRate(ushort poll_rate)
     return out0;
 }
 
+bool RazerDeviceAdaptor::setSoftwareBrightness(uchar brightness)
+{
+    // handle method call io.github.openrazer1.Device.setSoftwareBrightness
+    bool out0;
+    QMetaObject::invokeMethod(parent(), "setSoftwareBrightness", Q_RETURN_ARG(bool, out0), Q_ARG(uchar, brightness));
+    return out0;
+}
+
+bool RazerDeviceAdaptor::setTransitionDuration(ushort milliseconds)
+{
+    // handle method call io.github.openrazer1.Device.setTransitionDuration
+    bool out0;
+    QMetaObject::invokeMethod(parent(), "setTransitionDuration", Q_RETURN_ARG(bool, out0), Q_ARG(ushort, milliseconds));
+    return out0;
+}
+
 bool RazerDeviceAdaptor::startCustomEffectThread(const QString &effectName)
 {
     // handle method call io.github.openrazer1.Device.startCustomEffectThread
@@ -163,3 +287,10 @@ bool RazerDeviceAdaptor::startCustomEffectThread(const QString &effectName)
     return out0;
 }
 
+bool RazerDeviceAdaptor::submitFrame(qlonglong presentationTime, const QByteArray &rgbData)
+{
+    // handle method call io.github.openrazer1.Device.submitFrame
+    bool out0;
+    QMetaObject::invokeMethod(parent(), "submitFrame", Q_RETURN_ARG(bool, out0), Q_ARG(qlonglong, presentationTime), Q_ARG(QByteArray, rgbData));
+    return out0;
+}
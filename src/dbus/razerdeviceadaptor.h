@@ -39,6 +39,10 @@ class RazerDeviceAdaptor: public QDBusAbstractAdaptor
                 "    <property access=\"read\" type=\"ao\" name=\"Leds\"/>\n"
                 "    <property access=\"read\" type=\"as\" name=\"SupportedFx\"/>\n"
                 "    <property access=\"read\" type=\"as\" name=\"SupportedFeatures\"/>\n"
+                "    <property access=\"read\" type=\"(qq)\" name=\"DPI\">\n"
+                "      <annotation value=\"RazerDPI\" name=\"org.qtproject.QtDBus.QtTypeName\"/>\n"
+                "    </property>\n"
+                "    <property access=\"read\" type=\"q\" name=\"PollRate\"/>\n"
                 "    <property access=\"read\" type=\"(yy)\" name=\"MatrixDimensions\">\n"
                 "      <annotation value=\"MatrixDimensions\" name=\"org.qtproject.QtDBus.QtTypeName\"/>\n"
                 "    </property>\n"
@@ -85,6 +89,83 @@ class RazerDeviceAdaptor: public QDBusAbstractAdaptor
                 "      <arg direction=\"in\" type=\"s\" name=\"effectName\"/>\n"
                 "    </method>\n"
                 "    <method name=\"pauseCustomEffectThread\"/>\n"
+                "    <method name=\"defineLayerFrame\">\n"
+                "      <arg direction=\"out\" type=\"b\"/>\n"
+                "      <arg direction=\"in\" type=\"y\" name=\"layer\"/>\n"
+                "      <arg direction=\"in\" type=\"y\" name=\"row\"/>\n"
+                "      <arg direction=\"in\" type=\"y\" name=\"startColumn\"/>\n"
+                "      <arg direction=\"in\" type=\"y\" name=\"endColumn\"/>\n"
+                "      <arg direction=\"in\" type=\"ay\" name=\"rgbData\"/>\n"
+                "    </method>\n"
+                "    <method name=\"setLayerProperties\">\n"
+                "      <arg direction=\"out\" type=\"b\"/>\n"
+                "      <arg direction=\"in\" type=\"y\" name=\"layer\"/>\n"
+                "      <arg direction=\"in\" type=\"s\" name=\"blendMode\"/>\n"
+                "      <arg direction=\"in\" type=\"y\" name=\"opacity\"/>\n"
+                "    </method>\n"
+                "    <method name=\"removeLayer\">\n"
+                "      <arg direction=\"out\" type=\"b\"/>\n"
+                "      <arg direction=\"in\" type=\"y\" name=\"layer\"/>\n"
+                "    </method>\n"
+                "    <method name=\"playAnimation\">\n"
+                "      <arg direction=\"out\" type=\"b\"/>\n"
+                "      <arg direction=\"in\" type=\"h\" name=\"file\"/>\n"
+                "      <arg direction=\"in\" type=\"b\" name=\"loop\"/>\n"
+                "    </method>\n"
+                "    <method name=\"getMonotonicTime\">\n"
+                "      <arg direction=\"out\" type=\"x\"/>\n"
+                "    </method>\n"
+                "    <method name=\"submitFrame\">\n"
+                "      <arg direction=\"out\" type=\"b\"/>\n"
+                "      <arg direction=\"in\" type=\"x\" name=\"presentationTime\"/>\n"
+                "      <arg direction=\"in\" type=\"ay\" name=\"rgbData\"/>\n"
+                "    </method>\n"
+                "    <method name=\"setFrameInterpolation\">\n"
+                "      <arg direction=\"out\" type=\"b\"/>\n"
+                "      <arg direction=\"in\" type=\"s\" name=\"mode\"/>\n"
+                "    </method>\n"
+                "    <method name=\"setColorCorrection\">\n"
+                "      <arg direction=\"out\" type=\"b\"/>\n"
+                "      <arg direction=\"in\" type=\"d\" name=\"gamma\"/>\n"
+                "      <arg direction=\"in\" type=\"d\" name=\"redGain\"/>\n"
+                "      <arg direction=\"in\" type=\"d\" name=\"greenGain\"/>\n"
+                "      <arg direction=\"in\" type=\"d\" name=\"blueGain\"/>\n"
+                "    </method>\n"
+                "    <method name=\"setSoftwareBrightness\">\n"
+                "      <arg direction=\"out\" type=\"b\"/>\n"
+                "      <arg direction=\"in\" type=\"y\" name=\"brightness\"/>\n"
+                "    </method>\n"
+                "    <method name=\"setTransitionDuration\">\n"
+                "      <arg direction=\"out\" type=\"b\"/>\n"
+                "      <arg direction=\"in\" type=\"q\" name=\"milliseconds\"/>\n"
+                "    </method>\n"
+                "    <method name=\"commit\">\n"
+                "      <arg direction=\"out\" type=\"b\"/>\n"
+                "    </method>\n"
+                "    <method name=\"setCommitDelay\">\n"
+                "      <arg direction=\"out\" type=\"b\"/>\n"
+                "      <arg direction=\"in\" type=\"q\" name=\"milliseconds\"/>\n"
+                "    </method>\n"
+                "    <method name=\"acquireLighting\">\n"
+                "      <arg direction=\"out\" type=\"b\"/>\n"
+                "      <arg direction=\"in\" type=\"y\" name=\"priority\"/>\n"
+                "    </method>\n"
+                "    <method name=\"releaseLighting\">\n"
+                "      <arg direction=\"out\" type=\"b\"/>\n"
+                "    </method>\n"
+                "    <method name=\"getLightingOwner\">\n"
+                "      <arg direction=\"out\" type=\"s\"/>\n"
+                "    </method>\n"
+                "    <signal name=\"FramePresented\">\n"
+                "      <arg type=\"x\" name=\"presentationTime\"/>\n"
+                "      <arg type=\"x\" name=\"lateness\"/>\n"
+                "    </signal>\n"
+                "    <signal name=\"FrameDropped\">\n"
+                "      <arg type=\"x\" name=\"presentationTime\"/>\n"
+                "    </signal>\n"
+                "    <signal name=\"LightingOwnerChanged\">\n"
+                "      <arg type=\"s\" name=\"owner\"/>\n"
+                "    </signal>\n"
                 "  </interface>\n"
                 "")
 public:
@@ -92,6 +173,9 @@ public:
     virtual ~RazerDeviceAdaptor();
 
 public: // PROPERTIES
+    Q_PROPERTY(RazerDPI DPI READ dPI)
+    RazerDPI dPI() const;
+
     Q_PROPERTY(QList<QDBusObjectPath> Leds READ leds)
     QList<QDBusObjectPath> leds() const;
 
@@ -101,6 +185,9 @@ public: // PROPERTIES
     Q_PROPERTY(QString Name READ name)
     QString name() const;
 
+    Q_PROPERTY(ushort PollRate READ pollRate)
+    ushort pollRate() const;
+
     Q_PROPERTY(QStringList SupportedFeatures READ supportedFeatures)
     QStringList supportedFeatures() const;
 
@@ -111,19 +198,37 @@ public: // PROPERTIES
     QString type() const;
 
 public Q_SLOTS: // METHODS
+    bool acquireLighting(uchar priority);
+    bool commit();
     bool defineCustomFrame(uchar row, uchar startColumn, uchar endColumn, const QByteArray &rgbData);
+    bool defineLayerFrame(uchar layer, uchar row, uchar startColumn, uchar endColumn, const QByteArray &rgbData);
     bool displayCustomFrame();
     RazerDPI getDPI();
     QString getFirmwareVersion();
     QString getKeyboardLayout();
+    QString getLightingOwner();
     ushort getMaxDPI();
+    qlonglong getMonotonicTime();
     ushort getPollRate();
     QString getSerial();
     void pauseCustomEffectThread();
+    bool playAnimation(const QDBusUnixFileDescriptor &file, bool loop);
+    bool releaseLighting();
+    bool removeLayer(uchar layer);
+    bool setColorCorrection(double gamma, double redGain, double greenGain, double blueGain);
+    bool setCommitDelay(ushort milliseconds);
     bool setDPI(razer_test::RazerDPI dpi);
+    bool setFrameInterpolation(const QString &mode);
+    bool setLayerProperties(uchar layer, const QString &blendMode, uchar opacity);
     bool setPollRate(ushort poll_rate);
+    bool setSoftwareBrightness(uchar brightness);
+    bool setTransitionDuration(ushort milliseconds);
     bool startCustomEffectThread(const QString &effectName);
+    bool submitFrame(qlonglong presentationTime, const QByteArray &rgbData);
 Q_SIGNALS: // SIGNALS
+    void FrameDropped(qlonglong presentationTime);
+    void FramePresented(qlonglong presentationTime, qlonglong lateness);
+    void LightingOwnerChanged(const QString &owner);
 };
 
 #endif
@@ -0,0 +1,463 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "razerdevicedispatcher.h"
+#include "../device/razerdevice.h"
+
+/*
+ * Implementation of dispatcher class RazerDeviceDispatcher
+ */
+
+namespace {
+
+QVariant method_acquireLighting(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Device.acquireLighting
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->acquireLighting(qdbus_cast<uchar>(arguments.at(0))));
+}
+
+QVariant method_commit(QObject *target, const QList<QVariant> &/*arguments*/)
+{
+    // handle method call io.github.openrazer1.Device.commit
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->commit());
+}
+
+QVariant method_defineCustomFrame(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Device.defineCustomFrame
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->defineCustomFrame(qdbus_cast<uchar>(arguments.at(0)), qdbus_cast<uchar>(arguments.at(1)), qdbus_cast<uchar>(arguments.at(2)), qdbus_cast<QByteArray>(arguments.at(3))));
+}
+
+QVariant method_defineLayerFrame(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Device.defineLayerFrame
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->defineLayerFrame(qdbus_cast<uchar>(arguments.at(0)), qdbus_cast<uchar>(arguments.at(1)), qdbus_cast<uchar>(arguments.at(2)), qdbus_cast<uchar>(arguments.at(3)), qdbus_cast<QByteArray>(arguments.at(4))));
+}
+
+QVariant method_displayCustomFrame(QObject *target, const QList<QVariant> &/*arguments*/)
+{
+    // handle method call io.github.openrazer1.Device.displayCustomFrame
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->displayCustomFrame());
+}
+
+QVariant method_getDPI(QObject *target, const QList<QVariant> &/*arguments*/)
+{
+    // handle method call io.github.openrazer1.Device.getDPI
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->getDPI());
+}
+
+QVariant method_getFirmwareVersion(QObject *target, const QList<QVariant> &/*arguments*/)
+{
+    // handle method call io.github.openrazer1.Device.getFirmwareVersion
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->getFirmwareVersion());
+}
+
+QVariant method_getKeyboardLayout(QObject *target, const QList<QVariant> &/*arguments*/)
+{
+    // handle method call io.github.openrazer1.Device.getKeyboardLayout
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->getKeyboardLayout());
+}
+
+QVariant method_getLightingOwner(QObject *target, const QList<QVariant> &/*arguments*/)
+{
+    // handle method call io.github.openrazer1.Device.getLightingOwner
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->getLightingOwner());
+}
+
+QVariant method_getMaxDPI(QObject *target, const QList<QVariant> &/*arguments*/)
+{
+    // handle method call io.github.openrazer1.Device.getMaxDPI
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->getMaxDPI());
+}
+
+QVariant method_getMonotonicTime(QObject *target, const QList<QVariant> &/*arguments*/)
+{
+    // handle method call io.github.openrazer1.Device.getMonotonicTime
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->getMonotonicTime());
+}
+
+QVariant method_getPollRate(QObject *target, const QList<QVariant> &/*arguments*/)
+{
+    // handle method call io.github.openrazer1.Device.getPollRate
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->getPollRate());
+}
+
+QVariant method_getSerial(QObject *target, const QList<QVariant> &/*arguments*/)
+{
+    // handle method call io.github.openrazer1.Device.getSerial
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->getSerial());
+}
+
+QVariant method_pauseCustomEffectThread(QObject *target, const QList<QVariant> &/*arguments*/)
+{
+    // handle method call io.github.openrazer1.Device.pauseCustomEffectThread
+    auto *device = static_cast<RazerDevice *>(target);
+    device->pauseCustomEffectThread();
+    return QVariant();
+}
+
+QVariant method_playAnimation(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Device.playAnimation
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->playAnimation(qdbus_cast<QDBusUnixFileDescriptor>(arguments.at(0)), qdbus_cast<bool>(arguments.at(1))));
+}
+
+QVariant method_releaseLighting(QObject *target, const QList<QVariant> &/*arguments*/)
+{
+    // handle method call io.github.openrazer1.Device.releaseLighting
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->releaseLighting());
+}
+
+QVariant method_removeLayer(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Device.removeLayer
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->removeLayer(qdbus_cast<uchar>(arguments.at(0))));
+}
+
+QVariant method_setColorCorrection(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Device.setColorCorrection
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->setColorCorrection(qdbus_cast<double>(arguments.at(0)), qdbus_cast<double>(arguments.at(1)), qdbus_cast<double>(arguments.at(2)), qdbus_cast<double>(arguments.at(3))));
+}
+
+QVariant method_setCommitDelay(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Device.setCommitDelay
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->setCommitDelay(qdbus_cast<ushort>(arguments.at(0))));
+}
+
+QVariant method_setDPI(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Device.setDPI
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->setDPI(qdbus_cast<razer_test::RazerDPI>(arguments.at(0))));
+}
+
+QVariant method_setFrameInterpolation(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Device.setFrameInterpolation
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->setFrameInterpolation(qdbus_cast<QString>(arguments.at(0))));
+}
+
+QVariant method_setLayerProperties(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Device.setLayerProperties
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->setLayerProperties(qdbus_cast<uchar>(arguments.at(0)), qdbus_cast<QString>(arguments.at(1)), qdbus_cast<uchar>(arguments.at(2))));
+}
+
+QVariant method_setPollRate(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Device.setPollRate
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->setPollRate(qdbus_cast<ushort>(arguments.at(0))));
+}
+
+QVariant method_setSoftwareBrightness(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Device.setSoftwareBrightness
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->setSoftwareBrightness(qdbus_cast<uchar>(arguments.at(0))));
+}
+
+QVariant method_setTransitionDuration(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Device.setTransitionDuration
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->setTransitionDuration(qdbus_cast<ushort>(arguments.at(0))));
+}
+
+QVariant method_startCustomEffectThread(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Device.startCustomEffectThread
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->startCustomEffectThread(qdbus_cast<QString>(arguments.at(0))));
+}
+
+QVariant method_submitFrame(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Device.submitFrame
+    auto *device = static_cast<RazerDevice *>(target);
+    return QVariant::fromValue(device->submitFrame(qdbus_cast<qlonglong>(arguments.at(0)), qdbus_cast<QByteArray>(arguments.at(1))));
+}
+
+QVariant property_DPI(QObject *target)
+{
+    // get the value of property DPI
+    return QVariant::fromValue(static_cast<RazerDevice *>(target)->getDPI());
+}
+
+QVariant property_Leds(QObject *target)
+{
+    // get the value of property Leds
+    return QVariant::fromValue(static_cast<RazerDevice *>(target)->getLedObjectPaths());
+}
+
+QVariant property_MatrixDimensions(QObject *target)
+{
+    // get the value of property MatrixDimensions
+    return QVariant::fromValue(static_cast<RazerDevice *>(target)->getMatrixDimensions());
+}
+
+QVariant property_Name(QObject *target)
+{
+    // get the value of property Name
+    return QVariant::fromValue(static_cast<RazerDevice *>(target)->getName());
+}
+
+QVariant property_PollRate(QObject *target)
+{
+    // get the value of property PollRate
+    return QVariant::fromValue(static_cast<RazerDevice *>(target)->getPollRate());
+}
+
+QVariant property_SupportedFeatures(QObject *target)
+{
+    // get the value of property SupportedFeatures
+    return QVariant::fromValue(static_cast<RazerDevice *>(target)->getSupportedFeatures());
+}
+
+QVariant property_SupportedFx(QObject *target)
+{
+    // get the value of property SupportedFx
+    return QVariant::fromValue(static_cast<RazerDevice *>(target)->getSupportedFx());
+}
+
+QVariant property_Type(QObject *target)
+{
+    // get the value of property Type
+    return QVariant::fromValue(static_cast<RazerDevice *>(target)->getType());
+}
+
+const DBusDispatcher::Method methods[] = {
+    {"acquireLighting", "y", "b", ClientQos::TrafficClass::Control, false, false, method_acquireLighting},
+    {"commit", "", "b", ClientQos::TrafficClass::Control, false, true, method_commit},
+    {"defineCustomFrame", "yyyay", "b", ClientQos::TrafficClass::Bulk, true, true, method_defineCustomFrame},
+    {"defineLayerFrame", "yyyyay", "b", ClientQos::TrafficClass::Bulk, true, true, method_defineLayerFrame},
+    {"displayCustomFrame", "", "b", ClientQos::TrafficClass::Bulk, true, true, method_displayCustomFrame},
+    {"getDPI", "", "(qq)", ClientQos::TrafficClass::Control, false, true, method_getDPI},
+    {"getFirmwareVersion", "", "s", ClientQos::TrafficClass::Control, false, true, method_getFirmwareVersion},
+    {"getKeyboardLayout", "", "s", ClientQos::TrafficClass::Control, false, true, method_getKeyboardLayout},
+    {"getLightingOwner", "", "s", ClientQos::TrafficClass::Control, false, false, method_getLightingOwner},
+    {"getMaxDPI", "", "q", ClientQos::TrafficClass::Control, false, false, method_getMaxDPI},
+    {"getMonotonicTime", "", "x", ClientQos::TrafficClass::Control, false, false, method_getMonotonicTime},
+    {"getPollRate", "", "q", ClientQos::TrafficClass::Control, false, true, method_getPollRate},
+    {"getSerial", "", "s", ClientQos::TrafficClass::Control, false, true, method_getSerial},
+    {"pauseCustomEffectThread", "", "", ClientQos::TrafficClass::Control, true, true, method_pauseCustomEffectThread},
+    {"playAnimation", "hb", "b", ClientQos::TrafficClass::Control, true, true, method_playAnimation},
+    {"releaseLighting", "", "b", ClientQos::TrafficClass::Control, false, false, method_releaseLighting},
+    {"removeLayer", "y", "b", ClientQos::TrafficClass::Control, true, true, method_removeLayer},
+    {"setColorCorrection", "dddd", "b", ClientQos::TrafficClass::Control, true, true, method_setColorCorrection},
+    {"setCommitDelay", "q", "b", ClientQos::TrafficClass::Control, false, false, method_setCommitDelay},
+    {"setDPI", "(qq)", "b", ClientQos::TrafficClass::Control, false, true, method_setDPI},
+    {"setFrameInterpolation", "s", "b", ClientQos::TrafficClass::Control, true, false, method_setFrameInterpolation},
+    {"setLayerProperties", "ysy", "b", ClientQos::TrafficClass::Control, true, true, method_setLayerProperties},
+    {"setPollRate", "q", "b", ClientQos::TrafficClass::Control, false, true, method_setPollRate},
+    {"setSoftwareBrightness", "y", "b", ClientQos::TrafficClass::Control, true, true, method_setSoftwareBrightness},
+    {"setTransitionDuration", "q", "b", ClientQos::TrafficClass::Control, true, false, method_setTransitionDuration},
+    {"startCustomEffectThread", "s", "b", ClientQos::TrafficClass::Control, true, true, method_startCustomEffectThread},
+    {"submitFrame", "xay", "b", ClientQos::TrafficClass::Bulk, true, true, method_submitFrame}
+};
+
+const DBusDispatcher::Property properties[] = {
+    {"DPI", property_DPI},
+    {"Leds", property_Leds},
+    {"MatrixDimensions", property_MatrixDimensions},
+    {"Name", property_Name},
+    {"PollRate", property_PollRate},
+    {"SupportedFeatures", property_SupportedFeatures},
+    {"SupportedFx", property_SupportedFx},
+    {"Type", property_Type}
+};
+
+const DBusDispatcher::Interface dispatchInterface = {
+    "io.github.openrazer1.Device",
+    "  <interface name=\"io.github.openrazer1.Device\">\n"
+    "    <property name=\"Name\" type=\"s\" access=\"read\"/>\n"
+    "    <property name=\"Type\" type=\"s\" access=\"read\"/>\n"
+    "    <property name=\"Leds\" type=\"ao\" access=\"read\"/>\n"
+    "    <property name=\"SupportedFx\" type=\"as\" access=\"read\"/>\n"
+    "    <property name=\"SupportedFeatures\" type=\"as\" access=\"read\"/>\n"
+    "    <property name=\"DPI\" type=\"(qq)\" access=\"read\">\n"
+    "      <annotation name=\"org.qtproject.QtDBus.QtTypeName\" value=\"RazerDPI\"/>\n"
+    "    </property>\n"
+    "    <property name=\"PollRate\" type=\"q\" access=\"read\"/>\n"
+    "    <property name=\"MatrixDimensions\" type=\"(yy)\" access=\"read\">\n"
+    "      <annotation name=\"org.qtproject.QtDBus.QtTypeName\" value=\"MatrixDimensions\"/>\n"
+    "    </property>\n"
+    "    <method name=\"getSerial\">\n"
+    "      <arg type=\"s\" direction=\"out\"/>\n"
+    "    </method>\n"
+    "    <method name=\"getFirmwareVersion\">\n"
+    "      <arg type=\"s\" direction=\"out\"/>\n"
+    "    </method>\n"
+    "    <method name=\"getKeyboardLayout\">\n"
+    "      <arg type=\"s\" direction=\"out\"/>\n"
+    "    </method>\n"
+    "    <method name=\"getDPI\">\n"
+    "      <arg type=\"(qq)\" direction=\"out\"/>\n"
+    "      <annotation name=\"org.qtproject.QtDBus.QtTypeName.Out0\" value=\"RazerDPI\"/>\n"
+    "    </method>\n"
+    "    <method name=\"setDPI\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"dpi\" type=\"(qq)\" direction=\"in\"/>\n"
+    "      <annotation name=\"org.qtproject.QtDBus.QtTypeName.In0\" value=\"razer_test::RazerDPI\"/>\n"
+    "    </method>\n"
+    "    <method name=\"getMaxDPI\">\n"
+    "      <arg type=\"q\" direction=\"out\"/>\n"
+    "    </method>\n"
+    "    <method name=\"getPollRate\">\n"
+    "      <arg type=\"q\" direction=\"out\"/>\n"
+    "    </method>\n"
+    "    <method name=\"setPollRate\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"poll_rate\" type=\"q\" direction=\"in\"/>\n"
+    "    </method>\n"
+    "    <method name=\"displayCustomFrame\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "    </method>\n"
+    "    <method name=\"defineCustomFrame\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"row\" type=\"y\" direction=\"in\"/>\n"
+    "      <arg name=\"startColumn\" type=\"y\" direction=\"in\"/>\n"
+    "      <arg name=\"endColumn\" type=\"y\" direction=\"in\"/>\n"
+    "      <arg name=\"rgbData\" type=\"ay\" direction=\"in\"/>\n"
+    "    </method>\n"
+    "    <method name=\"startCustomEffectThread\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"effectName\" type=\"s\" direction=\"in\"/>\n"
+    "    </method>\n"
+    "    <method name=\"pauseCustomEffectThread\">\n"
+    "    </method>\n"
+    "    <method name=\"defineLayerFrame\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"layer\" type=\"y\" direction=\"in\"/>\n"
+    "      <arg name=\"row\" type=\"y\" direction=\"in\"/>\n"
+    "      <arg name=\"startColumn\" type=\"y\" direction=\"in\"/>\n"
+    "      <arg name=\"endColumn\" type=\"y\" direction=\"in\"/>\n"
+    "      <arg name=\"rgbData\" type=\"ay\" direction=\"in\"/>\n"
+    "    </method>\n"
+    "    <method name=\"setLayerProperties\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"layer\" type=\"y\" direction=\"in\"/>\n"
+    "      <arg name=\"blendMode\" type=\"s\" direction=\"in\"/>\n"
+    "      <arg name=\"opacity\" type=\"y\" direction=\"in\"/>\n"
+    "    </method>\n"
+    "    <method name=\"removeLayer\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"layer\" type=\"y\" direction=\"in\"/>\n"
+    "    </method>\n"
+    "    <method name=\"playAnimation\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"file\" type=\"h\" direction=\"in\"/>\n"
+    "      <arg name=\"loop\" type=\"b\" direction=\"in\"/>\n"
+    "    </method>\n"
+    "    <method name=\"getMonotonicTime\">\n"
+    "      <arg type=\"x\" direction=\"out\"/>\n"
+    "    </method>\n"
+    "    <method name=\"submitFrame\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"presentationTime\" type=\"x\" direction=\"in\"/>\n"
+    "      <arg name=\"rgbData\" type=\"ay\" direction=\"in\"/>\n"
+    "    </method>\n"
+    "    <method name=\"setFrameInterpolation\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"mode\" type=\"s\" direction=\"in\"/>\n"
+    "    </method>\n"
+    "    <method name=\"setColorCorrection\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"gamma\" type=\"d\" direction=\"in\"/>\n"
+    "      <arg name=\"redGain\" type=\"d\" direction=\"in\"/>\n"
+    "      <arg name=\"greenGain\" type=\"d\" direction=\"in\"/>\n"
+    "      <arg name=\"blueGain\" type=\"d\" direction=\"in\"/>\n"
+    "    </method>\n"
+    "    <method name=\"setSoftwareBrightness\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"brightness\" type=\"y\" direction=\"in\"/>\n"
+    "    </method>\n"
+    "    <method name=\"setTransitionDuration\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"milliseconds\" type=\"q\" direction=\"in\"/>\n"
+    "    </method>\n"
+    "    <method name=\"commit\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "    </method>\n"
+    "    <method name=\"setCommitDelay\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"milliseconds\" type=\"q\" direction=\"in\"/>\n"
+    "    </method>\n"
+    "    <method name=\"acquireLighting\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"priority\" type=\"y\" direction=\"in\"/>\n"
+    "    </method>\n"
+    "    <method name=\"releaseLighting\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "    </method>\n"
+    "    <method name=\"getLightingOwner\">\n"
+    "      <arg type=\"s\" direction=\"out\"/>\n"
+    "    </method>\n"
+    "    <signal name=\"FramePresented\">\n"
+    "      <arg name=\"presentationTime\" type=\"x\"/>\n"
+    "      <arg name=\"lateness\" type=\"x\"/>\n"
+    "    </signal>\n"
+    "    <signal name=\"FrameDropped\">\n"
+    "      <arg name=\"presentationTime\" type=\"x\"/>\n"
+    "    </signal>\n"
+    "    <signal name=\"LightingOwnerChanged\">\n"
+    "      <arg name=\"owner\" type=\"s\"/>\n"
+    "    </signal>\n"
+    "  </interface>\n",
+    methods, sizeof(methods) / sizeof(methods[0]),
+    properties, sizeof(properties) / sizeof(properties[0])
+};
+
+}
+
+RazerDeviceDispatcher::RazerDeviceDispatcher(RazerDevice *parent)
+    : DBusDispatcher(dispatchInterface, parent, parent)
+{
+    // relay signals
+    connect(parent, &RazerDevice::FramePresented, this, [this](qlonglong presentationTime, qlonglong lateness) {
+        emitSignal(QStringLiteral("FramePresented"), {QVariant::fromValue(presentationTime), QVariant::fromValue(lateness)});
+    });
+    connect(parent, &RazerDevice::FrameDropped, this, [this](qlonglong presentationTime) {
+        emitSignal(QStringLiteral("FrameDropped"), {QVariant::fromValue(presentationTime)});
+    });
+    connect(parent, &RazerDevice::LightingOwnerChanged, this, [this](QString owner) {
+        emitSignal(QStringLiteral("LightingOwnerChanged"), {QVariant::fromValue(owner)});
+    });
+}
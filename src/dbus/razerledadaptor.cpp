@@ -33,6 +33,12 @@ RazerLEDAdaptor::~RazerLEDAdaptor()
     // destructor
 }
 
+uchar RazerLEDAdaptor::brightness() const
+{
+    // get the value of property Brightness
+    return qvariant_cast< uchar >(parent()->property("Brightness"));
+}
+
 QList<RGB> RazerLEDAdaptor::currentColors() const
 {
     // get the value of property CurrentColors
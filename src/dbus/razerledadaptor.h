@@ -34,6 +34,7 @@ class RazerLEDAdaptor: public QDBusAbstractAdaptor
     Q_CLASSINFO("D-Bus Interface", "io.github.openrazer1.Led")
     Q_CLASSINFO("D-Bus Introspection", ""
                 "  <interface name=\"io.github.openrazer1.Led\">\n"
+                "    <property access=\"read\" type=\"y\" name=\"Brightness\"/>\n"
                 "    <property access=\"read\" type=\"a(yyy)\" name=\"CurrentColors\">\n"
                 "      <annotation value=\"QList&lt;RGB&gt;\" name=\"org.qtproject.QtDBus.QtTypeName\"/>\n"
                 "    </property>\n"
@@ -100,6 +101,9 @@ public:
     virtual ~RazerLEDAdaptor();
 
 public: // PROPERTIES
+    Q_PROPERTY(uchar Brightness READ brightness)
+    uchar brightness() const;
+
     Q_PROPERTY(QList<RGB> CurrentColors READ currentColors)
     QList<RGB> currentColors() const;
 
@@ -0,0 +1,223 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "razerleddispatcher.h"
+#include "../led/razerled.h"
+
+/*
+ * Implementation of dispatcher class RazerLEDDispatcher
+ */
+
+namespace {
+
+QVariant method_getBrightness(QObject *target, const QList<QVariant> &/*arguments*/)
+{
+    // handle method call io.github.openrazer1.Led.getBrightness
+    auto *led = static_cast<RazerLED *>(target);
+    return QVariant::fromValue(led->getBrightness());
+}
+
+QVariant method_setBlinking(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Led.setBlinking
+    auto *led = static_cast<RazerLED *>(target);
+    return QVariant::fromValue(led->setBlinking(qdbus_cast<razer_test::RGB>(arguments.at(0))));
+}
+
+QVariant method_setBreathing(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Led.setBreathing
+    auto *led = static_cast<RazerLED *>(target);
+    return QVariant::fromValue(led->setBreathing(qdbus_cast<razer_test::RGB>(arguments.at(0))));
+}
+
+QVariant method_setBreathingDual(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Led.setBreathingDual
+    auto *led = static_cast<RazerLED *>(target);
+    return QVariant::fromValue(led->setBreathingDual(qdbus_cast<razer_test::RGB>(arguments.at(0)), qdbus_cast<razer_test::RGB>(arguments.at(1))));
+}
+
+QVariant method_setBreathingRandom(QObject *target, const QList<QVariant> &/*arguments*/)
+{
+    // handle method call io.github.openrazer1.Led.setBreathingRandom
+    auto *led = static_cast<RazerLED *>(target);
+    return QVariant::fromValue(led->setBreathingRandom());
+}
+
+QVariant method_setBrightness(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Led.setBrightness
+    auto *led = static_cast<RazerLED *>(target);
+    return QVariant::fromValue(led->setBrightness(qdbus_cast<uchar>(arguments.at(0))));
+}
+
+QVariant method_setNone(QObject *target, const QList<QVariant> &/*arguments*/)
+{
+    // handle method call io.github.openrazer1.Led.setNone
+    auto *led = static_cast<RazerLED *>(target);
+    return QVariant::fromValue(led->setNone());
+}
+
+QVariant method_setReactive(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Led.setReactive
+    auto *led = static_cast<RazerLED *>(target);
+    return QVariant::fromValue(led->setReactive(qdbus_cast<razer_test::ReactiveSpeed>(arguments.at(0)), qdbus_cast<razer_test::RGB>(arguments.at(1))));
+}
+
+QVariant method_setSpectrum(QObject *target, const QList<QVariant> &/*arguments*/)
+{
+    // handle method call io.github.openrazer1.Led.setSpectrum
+    auto *led = static_cast<RazerLED *>(target);
+    return QVariant::fromValue(led->setSpectrum());
+}
+
+QVariant method_setStatic(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Led.setStatic
+    auto *led = static_cast<RazerLED *>(target);
+    return QVariant::fromValue(led->setStatic(qdbus_cast<razer_test::RGB>(arguments.at(0))));
+}
+
+QVariant method_setWave(QObject *target, const QList<QVariant> &arguments)
+{
+    // handle method call io.github.openrazer1.Led.setWave
+    auto *led = static_cast<RazerLED *>(target);
+    return QVariant::fromValue(led->setWave(qdbus_cast<razer_test::WaveDirection>(arguments.at(0))));
+}
+
+QVariant property_Brightness(QObject *target)
+{
+    // get the value of property Brightness
+    return QVariant::fromValue(static_cast<RazerLED *>(target)->getBrightness());
+}
+
+QVariant property_CurrentColors(QObject *target)
+{
+    // get the value of property CurrentColors
+    return QVariant::fromValue(static_cast<RazerLED *>(target)->getCurrentColors());
+}
+
+QVariant property_CurrentEffect(QObject *target)
+{
+    // get the value of property CurrentEffect
+    return QVariant::fromValue(static_cast<RazerLED *>(target)->getCurrentEffect());
+}
+
+QVariant property_LedId(QObject *target)
+{
+    // get the value of property LedId
+    return QVariant::fromValue(static_cast<RazerLED *>(target)->getLedId());
+}
+
+const DBusDispatcher::Method methods[] = {
+    {"getBrightness", "", "y", ClientQos::TrafficClass::Control, false, true, method_getBrightness},
+    {"setBlinking", "(yyy)", "b", ClientQos::TrafficClass::Control, true, true, method_setBlinking},
+    {"setBreathing", "(yyy)", "b", ClientQos::TrafficClass::Control, true, true, method_setBreathing},
+    {"setBreathingDual", "(yyy)(yyy)", "b", ClientQos::TrafficClass::Control, true, true, method_setBreathingDual},
+    {"setBreathingRandom", "", "b", ClientQos::TrafficClass::Control, true, true, method_setBreathingRandom},
+    {"setBrightness", "y", "b", ClientQos::TrafficClass::Control, true, true, method_setBrightness},
+    {"setNone", "", "b", ClientQos::TrafficClass::Control, true, true, method_setNone},
+    {"setReactive", "(i)(yyy)", "b", ClientQos::TrafficClass::Control, true, true, method_setReactive},
+    {"setSpectrum", "", "b", ClientQos::TrafficClass::Control, true, true, method_setSpectrum},
+    {"setStatic", "(yyy)", "b", ClientQos::TrafficClass::Control, true, true, method_setStatic},
+    {"setWave", "(i)", "b", ClientQos::TrafficClass::Control, true, true, method_setWave}
+};
+
+const DBusDispatcher::Property properties[] = {
+    {"Brightness", property_Brightness},
+    {"CurrentColors", property_CurrentColors},
+    {"CurrentEffect", property_CurrentEffect},
+    {"LedId", property_LedId}
+};
+
+const DBusDispatcher::Interface dispatchInterface = {
+    "io.github.openrazer1.Led",
+    "  <interface name=\"io.github.openrazer1.Led\">\n"
+    "    <property name=\"Brightness\" type=\"y\" access=\"read\"/>\n"
+    "    <property name=\"CurrentColors\" type=\"a(yyy)\" access=\"read\">\n"
+    "      <annotation name=\"org.qtproject.QtDBus.QtTypeName\" value=\"QList&lt;RGB&gt;\"/>\n"
+    "    </property>\n"
+    "    <property name=\"CurrentEffect\" type=\"(i)\" access=\"read\">\n"
+    "      <annotation name=\"org.qtproject.QtDBus.QtTypeName\" value=\"RazerEffect\"/>\n"
+    "    </property>\n"
+    "    <property name=\"LedId\" type=\"(i)\" access=\"read\">\n"
+    "      <annotation name=\"org.qtproject.QtDBus.QtTypeName\" value=\"RazerLedId\"/>\n"
+    "    </property>\n"
+    "    <method name=\"setNone\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "    </method>\n"
+    "    <method name=\"setStatic\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"color\" type=\"(yyy)\" direction=\"in\"/>\n"
+    "      <annotation name=\"org.qtproject.QtDBus.QtTypeName.In0\" value=\"razer_test::RGB\"/>\n"
+    "    </method>\n"
+    "    <method name=\"setBreathing\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"color\" type=\"(yyy)\" direction=\"in\"/>\n"
+    "      <annotation name=\"org.qtproject.QtDBus.QtTypeName.In0\" value=\"razer_test::RGB\"/>\n"
+    "    </method>\n"
+    "    <method name=\"setBreathingDual\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"color\" type=\"(yyy)\" direction=\"in\"/>\n"
+    "      <annotation name=\"org.qtproject.QtDBus.QtTypeName.In0\" value=\"razer_test::RGB\"/>\n"
+    "      <arg name=\"color2\" type=\"(yyy)\" direction=\"in\"/>\n"
+    "      <annotation name=\"org.qtproject.QtDBus.QtTypeName.In1\" value=\"razer_test::RGB\"/>\n"
+    "    </method>\n"
+    "    <method name=\"setBreathingRandom\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "    </method>\n"
+    "    <method name=\"setBlinking\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"color\" type=\"(yyy)\" direction=\"in\"/>\n"
+    "      <annotation name=\"org.qtproject.QtDBus.QtTypeName.In0\" value=\"razer_test::RGB\"/>\n"
+    "    </method>\n"
+    "    <method name=\"setSpectrum\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "    </method>\n"
+    "    <method name=\"setWave\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"direction\" type=\"(i)\" direction=\"in\"/>\n"
+    "      <annotation name=\"org.qtproject.QtDBus.QtTypeName.In0\" value=\"razer_test::WaveDirection\"/>\n"
+    "    </method>\n"
+    "    <method name=\"setReactive\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"speed\" type=\"(i)\" direction=\"in\"/>\n"
+    "      <annotation name=\"org.qtproject.QtDBus.QtTypeName.In0\" value=\"razer_test::ReactiveSpeed\"/>\n"
+    "      <arg name=\"color\" type=\"(yyy)\" direction=\"in\"/>\n"
+    "      <annotation name=\"org.qtproject.QtDBus.QtTypeName.In1\" value=\"razer_test::RGB\"/>\n"
+    "    </method>\n"
+    "    <method name=\"setBrightness\">\n"
+    "      <arg type=\"b\" direction=\"out\"/>\n"
+    "      <arg name=\"brightness\" type=\"y\" direction=\"in\"/>\n"
+    "    </method>\n"
+    "    <method name=\"getBrightness\">\n"
+    "      <arg type=\"y\" direction=\"out\"/>\n"
+    "    </method>\n"
+    "  </interface>\n",
+    methods, sizeof(methods) / sizeof(methods[0]),
+    properties, sizeof(properties) / sizeof(properties[0])
+};
+
+}
+
+RazerLEDDispatcher::RazerLEDDispatcher(RazerLED *parent)
+    : DBusDispatcher(dispatchInterface, parent, parent)
+{
+}
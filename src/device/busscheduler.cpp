@@ -0,0 +1,121 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include "busscheduler.h"
+#include "reportscheduler.h"
+#include "../customeffect/jitterbuffer.h"
+
+const qint64 BusScheduler::utilizationWindow;
+
+BusScheduler::BusScheduler(QObject *parent)
+    : QObject(parent)
+{
+    // Lets the event loop handle D-Bus calls between two reports, like ReportScheduler on its own
+    timer = new QTimer(this);
+    timer->setInterval(0);
+    connect(timer, &QTimer::timeout, this, &BusScheduler::sendNextReport);
+}
+
+BusScheduler::~BusScheduler()
+{
+    // The schedulers go back to sending on their own
+    while (!members.isEmpty())
+        detach(members.first().scheduler);
+}
+
+void BusScheduler::attach(ReportScheduler *scheduler, bool inputCritical)
+{
+    members.append({scheduler, inputCritical});
+    scheduler->setBusScheduler(this);
+}
+
+void BusScheduler::detach(ReportScheduler *scheduler)
+{
+    auto it = std::find_if(members.begin(), members.end(), [scheduler](const Member &member) {
+        return member.scheduler == scheduler;
+    });
+    if (it == members.end())
+        return;
+    members.erase(it);
+    position = 0;
+    scheduler->setBusScheduler(nullptr);
+}
+
+void BusScheduler::wake()
+{
+    if (!timer->isActive())
+        timer->start();
+}
+
+void BusScheduler::recordTransaction(qint64 start, qint64 end)
+{
+    QMutexLocker locker(&mutex);
+    rotateWindow(end);
+    busy += end - start;
+}
+
+double BusScheduler::utilization(qint64 now)
+{
+    QMutexLocker locker(&mutex);
+    rotateWindow(now);
+    return qMin(static_cast<double>(previousBusy) / utilizationWindow, 1.0);
+}
+
+double BusScheduler::utilization()
+{
+    return utilization(monotonicTime());
+}
+
+void BusScheduler::sendNextReport()
+{
+    ReportScheduler *scheduler = nextScheduler(true);
+    if (scheduler == nullptr)
+        scheduler = nextScheduler(false);
+    if (scheduler == nullptr) {
+        timer->stop();
+        return;
+    }
+    scheduler->sendNextBulkReport();
+}
+
+ReportScheduler *BusScheduler::nextScheduler(bool inputCritical)
+{
+    for (int i = 0; i < members.size(); i++) {
+        int index = (position + i) % members.size();
+        const Member &member = members.at(index);
+        if (member.inputCritical == inputCritical && member.scheduler->isBulkPending()) {
+            position = (index + 1) % members.size();
+            return member.scheduler;
+        }
+    }
+    return nullptr;
+}
+
+void BusScheduler::rotateWindow(qint64 now)
+{
+    if (windowStart == 0)
+        windowStart = now;
+    if (now - windowStart < utilizationWindow)
+        return;
+    // Nothing was sent in the last full window if more than one has passed
+    previousBusy = now - windowStart < 2 * utilizationWindow ? busy : 0;
+    busy = 0;
+    windowStart = now - (now - windowStart) % utilizationWindow;
+}
@@ -0,0 +1,83 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BUSSCHEDULER_H
+#define BUSSCHEDULER_H
+
+#include <QMutex>
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+
+class ReportScheduler;
+
+/**
+ * Interleaves the bulk lanes of the devices on one USB bus.
+ *
+ * Devices behind the same root hub share its bandwidth and control transfers, so frames of
+ * several devices are sent one report per event loop iteration for the whole bus instead of
+ * per device. Input-critical devices like mice are served first, the others take turns.
+ * Every transaction on the bus is also timed for the utilization, control commands included.
+ */
+class BusScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Utilization is measured over windows of that many microseconds
+    static const qint64 utilizationWindow = 1000000;
+
+    explicit BusScheduler(QObject *parent = nullptr);
+    ~BusScheduler() override;
+
+    void attach(ReportScheduler *scheduler, bool inputCritical);
+    void detach(ReportScheduler *scheduler);
+    // Called by an attached scheduler when it has bulk reports
+    void wake();
+
+    // Can be called from any thread, devices send scenes from a thread pool. Times are in
+    // microseconds of the monotonic clock.
+    void recordTransaction(qint64 start, qint64 end);
+    // Fraction of the last full window the bus was busy with transactions
+    double utilization(qint64 now);
+    double utilization();
+
+private slots:
+    void sendNextReport();
+
+private:
+    struct Member {
+        ReportScheduler *scheduler;
+        bool inputCritical;
+    };
+
+    ReportScheduler *nextScheduler(bool inputCritical);
+    void rotateWindow(qint64 now);
+
+    QVector<Member> members;
+    // Where the round robin continues
+    int position = 0;
+    QTimer *timer;
+
+    QMutex mutex;
+    qint64 windowStart = 0;
+    qint64 busy = 0;
+    qint64 previousBusy = 0;
+};
+
+#endif // BUSSCHEDULER_H
@@ -0,0 +1,76 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtGlobal>
+
+#include "devicehealth.h"
+
+const int DeviceHealth::failureThreshold;
+const int DeviceHealth::initialBackoff;
+const int DeviceHealth::maxBackoff;
+
+DeviceHealth::State DeviceHealth::state() const
+{
+    return currentState;
+}
+
+bool DeviceHealth::allowRequest() const
+{
+    return currentState != State::Open;
+}
+
+void DeviceHealth::recordSuccess()
+{
+    if (currentState == State::Closed)
+        consecutiveFailures = 0;
+}
+
+bool DeviceHealth::recordFailure()
+{
+    if (currentState != State::Closed)
+        return false;
+    if (++consecutiveFailures < failureThreshold)
+        return false;
+    currentState = State::Open;
+    nextBackoff = initialBackoff;
+    return true;
+}
+
+void DeviceHealth::startProbe()
+{
+    currentState = State::HalfOpen;
+}
+
+void DeviceHealth::probeSucceeded()
+{
+    currentState = State::Closed;
+    consecutiveFailures = 0;
+    nextBackoff = initialBackoff;
+}
+
+int DeviceHealth::probeFailed()
+{
+    currentState = State::Open;
+    nextBackoff = qMin(nextBackoff * 2, static_cast<int>(maxBackoff));
+    return nextBackoff;
+}
+
+int DeviceHealth::backoff() const
+{
+    return nextBackoff;
+}
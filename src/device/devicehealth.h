@@ -0,0 +1,66 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DEVICEHEALTH_H
+#define DEVICEHEALTH_H
+
+/**
+ * Circuit breaker of a device that stopped answering.
+ *
+ * Every failed report already took the whole retry loop, so after a few of them in a row the
+ * breaker opens and requests fail right away instead of blocking the event loop again. While
+ * open the device is probed with an exponential backoff, the breaker is half open during a
+ * probe and closes once a probe succeeded.
+ */
+class DeviceHealth
+{
+public:
+    enum class State {
+        Closed,
+        Open,
+        HalfOpen
+    };
+
+    // Reports that failed after all retries
+    static const int failureThreshold = 3;
+    // Delays between the probes in milliseconds
+    static const int initialBackoff = 250;
+    static const int maxBackoff = 30000;
+
+    State state() const;
+    bool allowRequest() const;
+
+    // Only count while closed, probes are judged by whoever probes. recordFailure() returns true
+    // if the failure opened the breaker.
+    void recordSuccess();
+    bool recordFailure();
+
+    void startProbe();
+    void probeSucceeded();
+    // Returns the delay until the next probe, twice the previous one
+    int probeFailed();
+    // Delay until the first probe after the breaker opened
+    int backoff() const;
+
+private:
+    State currentState = State::Closed;
+    int consecutiveFailures = 0;
+    int nextBackoff = initialBackoff;
+};
+
+#endif // DEVICEHEALTH_H
@@ -36,20 +36,22 @@ bool RazerClassicDevice::initialize()
 
 /* --------------------- DBUS METHODS --------------------- */
 
-bool RazerClassicDevice::displayCustomFrame()
+bool RazerClassicDevice::activateCustomFrame()
 {
     qDebug("Called %s", Q_FUNC_INFO);
     if (!checkFx("custom_frame"))
         return false;
-    sendErrorReply(QDBusError::NotSupported);
+    if (calledFromDBus())
+        sendErrorReply(QDBusError::NotSupported);
     return false;
 }
 
-bool RazerClassicDevice::defineCustomFrame(uchar row, uchar startColumn, uchar endColumn, QByteArray rgbData)
+bool RazerClassicDevice::uploadCustomFrameRow(uchar row, uchar startColumn, uchar endColumn, QByteArray rgbData)
 {
     qDebug("Called %s with param %i, %i, %i, %s", Q_FUNC_INFO, row, startColumn, endColumn, rgbData.toHex().constData());
     if (!checkFx("custom_frame"))
         return false;
-    sendErrorReply(QDBusError::NotSupported);
+    if (calledFromDBus())
+        sendErrorReply(QDBusError::NotSupported);
     return false;
 }
@@ -31,8 +31,8 @@ public:
 
     bool initialize() override;
 
-    bool displayCustomFrame() override;
-    bool defineCustomFrame(uchar row, uchar startColumn, uchar endColumn, QByteArray rgbData) override;
+    bool activateCustomFrame() override;
+    bool uploadCustomFrameRow(uchar row, uchar startColumn, uchar endColumn, QByteArray rgbData) override;
 };
 
 #endif // RAZERCLASSICDEVICE_H
@@ -22,8 +22,16 @@
 #include <QThread>
 
 #include "razerdevice.h"
+#include "../customeffect/animationeffect.h"
+
+// Shortest time between two interpolated frames in milliseconds, about 60 fps
+static const int minInterpolationInterval = 16;
 
 RazerDevice::RazerDevice(QString dev_path, ushort vendor_id, ushort product_id, QString name, QString type, QString pclass, QVector<RazerLedId> ledIds, QStringList fx, QStringList features, QVector<RazerDeviceQuirks> quirks, MatrixDimensions matrixDimensions, ushort maxDPI)
+    : DBusCallContext(this)
+    , matrixDimensions(matrixDimensions)
+    , hardwareEffect(frameWidth(), frameHeight())
+    , transitionTarget(frameWidth(), frameHeight())
 {
     this->dev_path = dev_path;
     this->vendor_id = vendor_id;
@@ -35,18 +43,50 @@ RazerDevice::RazerDevice(QString dev_path, ushort vendor_id, ushort product_id,
     this->fx = fx;
     this->features = features;
     this->quirks = quirks;
-    this->matrixDimensions = matrixDimensions;
     this->maxDPI = maxDPI;
 
-    this->thread = new CustomEffectThread(matrixDimensions.x, matrixDimensions.y);
+    this->thread = new CustomEffectThread(frameWidth(), frameHeight());
+
+    // The effect thread never calls into the device, frames are picked up from its triple buffer instead
+    this->frameTimer = new QTimer(this);
+    connect(frameTimer, &QTimer::timeout, this, &RazerDevice::customFrameTick);
+
+    this->interpolationTimer = new QTimer(this);
+    interpolationTimer->setTimerType(Qt::PreciseTimer);
+    connect(interpolationTimer, &QTimer::timeout, this, &RazerDevice::interpolationTick);
+
+    this->presentTimer = new QTimer(this);
+    presentTimer->setSingleShot(true);
+    presentTimer->setTimerType(Qt::PreciseTimer);
+    connect(presentTimer, &QTimer::timeout, this, &RazerDevice::presentTimerTick);
+
+    this->transitionTimer = new QTimer(this);
+    transitionTimer->setTimerType(Qt::PreciseTimer);
+    connect(transitionTimer, &QTimer::timeout, this, &RazerDevice::transitionTick);
+
+    this->commitTimer = new QTimer(this);
+    commitTimer->setSingleShot(true);
+    connect(commitTimer, &QTimer::timeout, this, &RazerDevice::commit);
 
-    // Connect CustomEffectThread with the device
-    connect(thread, &CustomEffectThread::rgbDataReady, this, &RazerDevice::customRgbDataReady);
-    connect(thread, &CustomEffectThread::frameReady, this, &RazerDevice::customFrameReady);
+    this->notifier = new PropertiesNotifier(this);
+
+    this->scheduler = new ReportScheduler([this](const razer_report &request_report, razer_report *response_report) {
+        return sendPreparedReport(request_report, response_report);
+    }, this);
+
+    this->probeTimer = new QTimer(this);
+    probeTimer->setSingleShot(true);
+    connect(probeTimer, &QTimer::timeout, this, &RazerDevice::probeTick);
+
+    this->leases = new LeaseArbiter(this);
+    connect(leases, &LeaseArbiter::ownerChanged, this, &RazerDevice::lightingOwnerChanged);
 }
 
 RazerDevice::~RazerDevice()
 {
+    // Store the settled settings before the handle goes away
+    if (handle != nullptr)
+        commit();
     // Destroy LEDs
     foreach (RazerLED *led, leds) {
         delete led;
@@ -69,22 +109,57 @@ bool RazerDevice::openDeviceHandle()
         qCritical("unable to open device");
         return false;
     }
+    location = UsbTopology::locate(dev_path);
     return true;
 }
 
 int RazerDevice::sendReport(razer_report request_report, razer_report *response_report)
+{
+    // Calculate the crc
+    request_report.crc = razer_calculate_crc(&request_report);
+
+    if (capturing) {
+        recorded.reports.append(request_report);
+        memset(response_report, 0, sizeof(razer_report));
+        response_report->status = RazerStatus::SUCCESSFUL;
+        return 0;
+    }
+    return sendPreparedReport(request_report, response_report);
+}
+
+int RazerDevice::sendPreparedReport(const razer_report &request_report, razer_report *response_report)
+{
+    // The device didn't answer the last reports, don't block on it again until a probe succeeds
+    if (!health.allowRequest())
+        return 1;
+
+    qint64 start = monotonicTime();
+    int res = exchangeReport(request_report, response_report);
+    if (bus != nullptr)
+        bus->recordTransaction(start, monotonicTime());
+
+    if (res != 1) {
+        health.recordSuccess();
+        return res;
+    }
+    printf("Failed to send report after 3 tries.\n");
+    // Scenes and batches send from a thread pool, the probing is done on the device's thread
+    if (health.recordFailure())
+        QMetaObject::invokeMethod(this, "deviceStoppedResponding", Qt::QueuedConnection);
+    return 1;
+}
+
+int RazerDevice::exchangeReport(const razer_report &request_report, razer_report *response_report)
 {
     if (handle == nullptr) {
         qCritical("sendReport called on an unopened handle. This should not happen!");
         return 1;
     }
+
     int res;
     unsigned char req_buf[sizeof(razer_report) + 1];
     unsigned char res_buf[sizeof(razer_report) + 1];
 
-    // Calculate the crc
-    request_report.crc = razer_calculate_crc(&request_report);
-
     // Copy request_report into req_buf, shifted by 1 byte to the right for the report number
     req_buf[0] = 0x00; // report number
     memcpy(&req_buf[1], &request_report, sizeof(razer_report));
@@ -152,13 +227,97 @@ int RazerDevice::sendReport(razer_report request_report, razer_report *response_
             return 0;
         }
     }
-    printf("Failed to send report after 3 tries.\n");
     return 1;
 }
 
+bool RazerDevice::sendSetting(const QString &key, std::function<razer_report(RazerVarstore)> buildReport)
+{
+    razer_report response_report;
+    if (commitDelay == 0) {
+        if (!capturing)
+            pendingCommits.remove(key);
+        return sendReport(buildReport(RazerVarstore::STORE), &response_report) == 0;
+    }
+
+    if (sendReport(buildReport(RazerVarstore::NOSTORE), &response_report) != 0)
+        return false;
+    if (capturing) {
+        recorded.commits.insert(key, buildReport);
+        return true;
+    }
+    // Only the last value of a setting gets stored, every change restarts the delay
+    pendingCommits.insert(key, buildReport);
+    commitTimer->start(commitDelay);
+    return true;
+}
+
+void RazerDevice::startCapture()
+{
+    capturing = true;
+    recorded = RecordedReports();
+}
+
+RecordedReports RazerDevice::finishCapture()
+{
+    capturing = false;
+    RecordedReports result = recorded;
+    recorded = RecordedReports();
+    return result;
+}
+
+int RazerDevice::capturedReportCount() const
+{
+    return recorded.reports.size();
+}
+
+int RazerDevice::sendPreparedReports(const QVector<razer_report> &reports)
+{
+    razer_report response_report;
+    for (int i = 0; i < reports.size(); i++) {
+        if (sendPreparedReport(reports.at(i), &response_report) != 0)
+            return i;
+    }
+    return reports.size();
+}
+
+void RazerDevice::queueCommits(const QMap<QString, std::function<razer_report(RazerVarstore)>> &commits)
+{
+    if (commits.isEmpty())
+        return;
+    for (auto it = commits.constBegin(); it != commits.constEnd(); ++it)
+        pendingCommits.insert(it.key(), it.value());
+    commitTimer->start(commitDelay);
+}
+
+void RazerDevice::discardPendingSettings(const QString &keyPrefix)
+{
+    for (auto it = pendingCommits.begin(); it != pendingCommits.end();) {
+        if (it.key().startsWith(keyPrefix))
+            it = pendingCommits.erase(it);
+        else
+            ++it;
+    }
+}
+
 QDBusObjectPath RazerDevice::getObjectPath()
 {
-    return QDBusObjectPath(QString("/io/github/openrazer1/devices/%1").arg(getSerial()));
+    if (objectPath.path().isEmpty())
+        objectPath = QDBusObjectPath(QString("/io/github/openrazer1/devices/%1").arg(getSerial()));
+    return objectPath;
+}
+
+void RazerDevice::notifyPropertyChanged(const PropertyChange &change)
+{
+    if (capturing)
+        recorded.notifications.append(change);
+    else
+        notifier->propertyChanged(change);
+}
+
+void RazerDevice::notifyPropertiesChanged(const QVector<PropertyChange> &changes)
+{
+    foreach (const PropertyChange &change, changes)
+        notifyPropertyChanged(change);
 }
 
 /* --------------------- DBUS METHODS --------------------- */
@@ -262,7 +421,8 @@ RazerDPI RazerDevice::getDPI()
         return {0, 0};
     razer_report report, response_report;
 
-    report = razer_chroma_misc_get_dpi_xy(RazerVarstore::STORE);
+    // The stored value is still the old one until a pending change is committed
+    report = razer_chroma_misc_get_dpi_xy(pendingCommits.contains("dpi") ? RazerVarstore::NOSTORE : RazerVarstore::STORE);
     if (sendReport(report, &response_report) != 0) {
         if (calledFromDBus())
             sendErrorReply(QDBusError::Failed);
@@ -278,14 +438,15 @@ bool RazerDevice::setDPI(RazerDPI dpi)
     qDebug("Called %s", Q_FUNC_INFO);
     if (!checkFeature("dpi"))
         return false;
-    razer_report report, response_report;
-
-    report = razer_chroma_misc_set_dpi_xy(RazerVarstore::STORE, dpi.dpi_x, dpi.dpi_y);
-    if (sendReport(report, &response_report) != 0) {
+    bool ok = sendSetting("dpi", [dpi](RazerVarstore varstore) {
+        return razer_chroma_misc_set_dpi_xy(varstore, dpi.dpi_x, dpi.dpi_y);
+    });
+    if (!ok) {
         if (calledFromDBus())
             sendErrorReply(QDBusError::Failed);
         return false;
     }
+    notifyPropertyChanged({getObjectPath(), "io.github.openrazer1.Device", "DPI", QVariant::fromValue(dpi)});
     return true;
 }
 
@@ -359,28 +520,493 @@ bool RazerDevice::setPollRate(ushort poll_rate)
             sendErrorReply(QDBusError::Failed);
         return false;
     }
+    notifyPropertyChanged({getObjectPath(), "io.github.openrazer1.Device", "PollRate", QVariant::fromValue(poll_rate)});
     return true;
 }
 
+uchar RazerDevice::frameWidth() const
+{
+    return matrixDimensions.y;
+}
+
+uchar RazerDevice::frameHeight() const
+{
+    return matrixDimensions.x;
+}
+
 MatrixDimensions RazerDevice::getMatrixDimensions()
 {
     qDebug("Called %s", Q_FUNC_INFO);
     return matrixDimensions;
 }
 
+bool RazerDevice::displayCustomFrame()
+{
+    // The client takes over, a pending hand-off would replace its frame
+    cancelTransition();
+    if (interpolator.mode() == FrameInterpolator::Mode::None && capturing) {
+        // Scenes and batches record the reports of the rows as they were defined
+        if (!activateCustomFrame())
+            return false;
+        showingCustomFrame = true;
+        offloaded = false;
+        return true;
+    }
+    if (interpolator.mode() == FrameInterpolator::Mode::None) {
+        if (!checkFx("custom_frame"))
+            return false;
+        // Like the frames of effects, so a uniform frame is sent as one static effect report
+        resizeLastFrame();
+        presentFrame(lastFrame, [](ReportScheduler::Result result) {
+            if (result == ReportScheduler::Result::Failed)
+                qWarning("Presenting the custom frame went wrong.");
+        });
+        return true;
+    }
+
+    qDebug("Called %s", Q_FUNC_INFO);
+    if (!checkFx("custom_frame"))
+        return false;
+    interpolator.pushFrame(stagedFrame, monotonicTime());
+    if (!interpolationTimer->isActive())
+        interpolationTick();
+    return true;
+}
+
+bool RazerDevice::defineCustomFrame(uchar row, uchar startColumn, uchar endColumn, QByteArray rgbData)
+{
+    if (interpolator.mode() == FrameInterpolator::Mode::None && capturing) {
+        // Keep track of the frame for transitions, rows that don't fit are rejected by the device anyway
+        resizeLastFrame();
+        if (row < lastFrame.height() && startColumn <= endColumn && endColumn < lastFrame.width()
+                && rgbData.size() == (endColumn + 1 - startColumn) * 3)
+            memcpy(lastFrame.row(row) + startColumn * 3, rgbData.constData(), rgbData.size());
+
+        if (!colorCorrection.isIdentity())
+            colorCorrection.apply(reinterpret_cast<uchar *>(rgbData.data()), rgbData.size() / 3);
+        return uploadCustomFrameRow(row, startColumn, endColumn, rgbData);
+    }
+    if (interpolator.mode() == FrameInterpolator::Mode::None) {
+        if (!checkFx("custom_frame"))
+            return false;
+        resizeLastFrame();
+        if (row >= lastFrame.height() || startColumn > endColumn || endColumn >= lastFrame.width()
+                || rgbData.size() != (endColumn + 1 - startColumn) * 3) {
+            qWarning("defineCustomFrame called with invalid parameters");
+            if (calledFromDBus())
+                sendErrorReply(QDBusError::InvalidArgs);
+            return false;
+        }
+        // Staged until displayCustomFrame(), which sends the whole frame
+        memcpy(lastFrame.row(row) + startColumn * 3, rgbData.constData(), rgbData.size());
+        return true;
+    }
+
+    qDebug("Called %s with param %i, %i, %i", Q_FUNC_INFO, row, startColumn, endColumn);
+    if (!checkFx("custom_frame"))
+        return false;
+    if (row >= stagedFrame.height() || startColumn > endColumn || endColumn >= stagedFrame.width()
+            || rgbData.size() != (endColumn + 1 - startColumn) * 3) {
+        qWarning("defineCustomFrame called with invalid parameters");
+        if (calledFromDBus())
+            sendErrorReply(QDBusError::InvalidArgs);
+        return false;
+    }
+    // Staged until displayCustomFrame(), the interpolation then fades over to it
+    memcpy(stagedFrame.row(row) + startColumn * 3, rgbData.constData(), rgbData.size());
+    return true;
+}
+
+bool RazerDevice::setColorCorrection(double gamma, double redGain, double greenGain, double blueGain)
+{
+    qDebug("Called %s with params %f, %f, %f, %f", Q_FUNC_INFO, gamma, redGain, greenGain, blueGain);
+    // Written so NaN is rejected as well
+    if (!(gamma > 0.0 && gamma <= 5.0)) {
+        if (calledFromDBus())
+            sendErrorReply(QDBusError::InvalidArgs, "Gamma has to be between 0 and 5.");
+        return false;
+    }
+    colorCorrection.setGamma(gamma);
+    colorCorrection.setWhiteBalance(redGain, greenGain, blueGain);
+    return true;
+}
+
+bool RazerDevice::setSoftwareBrightness(uchar brightness)
+{
+    qDebug("Called %s with params %i", Q_FUNC_INFO, brightness);
+    colorCorrection.setBrightness(brightness);
+    return true;
+}
+
+bool RazerDevice::setTransitionDuration(ushort milliseconds)
+{
+    qDebug("Called %s with params %i", Q_FUNC_INFO, milliseconds);
+    transitionDuration = milliseconds;
+    return true;
+}
+
+bool RazerDevice::commit()
+{
+    qDebug("Called %s", Q_FUNC_INFO);
+    commitTimer->stop();
+    bool ok = true;
+    razer_report response_report;
+    // Settings that fail to store are dropped, they are still applied until the device loses power
+    foreach (const auto &buildReport, pendingCommits) {
+        if (sendReport(buildReport(RazerVarstore::STORE), &response_report) != 0)
+            ok = false;
+    }
+    pendingCommits.clear();
+    if (!ok) {
+        qWarning("Storing the settings on the device went wrong.");
+        if (calledFromDBus())
+            sendErrorReply(QDBusError::Failed);
+    }
+    return ok;
+}
+
+bool RazerDevice::setCommitDelay(ushort milliseconds)
+{
+    qDebug("Called %s with params %i", Q_FUNC_INFO, milliseconds);
+    commitDelay = milliseconds;
+    if (commitDelay == 0)
+        return commit();
+    if (commitTimer->isActive())
+        commitTimer->start(commitDelay);
+    return true;
+}
+
+bool RazerDevice::activateStaticColor(RGB color)
+{
+    Q_UNUSED(color)
+    return false;
+}
+
+ClientQos *RazerDevice::clientQos()
+{
+    return &qos;
+}
+
+LeaseArbiter *RazerDevice::leaseArbiter()
+{
+    return leases;
+}
+
+const DeviceHealth *RazerDevice::deviceHealth() const
+{
+    return &health;
+}
+
+UsbLocation RazerDevice::usbLocation() const
+{
+    return location;
+}
+
+bool RazerDevice::isInputCritical() const
+{
+    return type == "mouse";
+}
+
+void RazerDevice::setBusScheduler(BusScheduler *bus)
+{
+    this->bus = bus;
+    bus->attach(scheduler, isInputCritical());
+}
+
+RGB RazerDevice::correctColor(RGB color)
+{
+    RGBval corrected = colorCorrection.apply(RGBval{color.r, color.g, color.b});
+    return {corrected.red, corrected.green, corrected.blue};
+}
+
+bool RazerDevice::setFrameInterpolation(QString mode)
+{
+    qDebug("Called %s", Q_FUNC_INFO);
+    if (mode == "none") {
+        interpolator.setMode(FrameInterpolator::Mode::None);
+    } else if (mode == "linear") {
+        interpolator.setMode(FrameInterpolator::Mode::Linear);
+    } else if (mode == "eased") {
+        interpolator.setMode(FrameInterpolator::Mode::Eased);
+    } else {
+        if (calledFromDBus())
+            sendErrorReply(QDBusError::InvalidArgs, "Unknown interpolation mode.");
+        return false;
+    }
+    interpolationTimer->stop();
+    stagedFrame.resize(frameWidth(), frameHeight());
+    return true;
+}
+
+void RazerDevice::interpolationTick()
+{
+    CustomFrame frame;
+    if (!interpolator.frameAt(monotonicTime(), frame)) {
+        interpolationTimer->stop();
+        return;
+    }
+
+    qint64 start = monotonicTime();
+    presentFrame(frame, [this, start](ReportScheduler::Result result) {
+        if (result != ReportScheduler::Result::Sent)
+            return;
+        qint64 duration = monotonicTime() - start;
+        presentDuration = presentDuration == 0 ? duration : presentDuration + (duration - presentDuration) / 8;
+    });
+
+    if (!interpolator.isAnimating()) {
+        interpolationTimer->stop();
+        return;
+    }
+    // As fast as the device takes frames, but leave the event loop at least half of the time for D-Bus calls
+    interpolationTimer->start(qMax(static_cast<int>(2 * presentDuration / 1000), minInterpolationInterval));
+}
+
 bool RazerDevice::startCustomEffectThread(QString effectName)
 {
     if (!thread->startThread(effectName)) {
         if (calledFromDBus())
-            sendErrorReply(QDBusError::Failed);
+            sendErrorReply(QDBusError::Failed, QString("Effect %1 is unknown or failed to start.").arg(effectName));
         return false;
     }
+    customEffectName = effectName;
+    // Pending client frames would fight with the effect
+    jitterBuffer.clear();
+    presentTimer->stop();
+    if (beginTransition())
+        transitionTick();
+    startFrameTimer();
     return true;
 }
 
 void RazerDevice::pauseCustomEffectThread()
 {
     thread->pauseThread();
+    customEffectName.clear();
+    // Layers are still shown while the effect is paused
+    if (!thread->hasLayers())
+        frameTimer->stop();
+}
+
+bool RazerDevice::playAnimation(QDBusUnixFileDescriptor file, bool loop)
+{
+    qDebug("Called %s", Q_FUNC_INFO);
+    // The client opens the file itself, so the daemon never reads files on behalf of others
+    auto *animation = new AnimationFile;
+    if (!file.isValid() || !animation->open(file.fileDescriptor())) {
+        delete animation;
+        if (calledFromDBus())
+            sendErrorReply(QDBusError::InvalidArgs, "Not a valid animation file.");
+        return false;
+    }
+    if (animation->width() != frameWidth() || animation->height() != frameHeight()) {
+        delete animation;
+        if (calledFromDBus())
+            sendErrorReply(QDBusError::InvalidArgs, "Animation dimensions don't match the device.");
+        return false;
+    }
+
+    ushort minFrameDuration = animation->minFrameDuration();
+    thread->startEffect(new AnimationEffect(animation, loop));
+    customEffectName.clear();
+    jitterBuffer.clear();
+    presentTimer->stop();
+    if (beginTransition())
+        transitionTick();
+    // Frame durations vary, poll fast enough for the shortest one
+    frameTimer->start(qMax(minFrameDuration / 2, 1));
+    return true;
+}
+
+qlonglong RazerDevice::getMonotonicTime()
+{
+    qDebug("Called %s", Q_FUNC_INFO);
+    return monotonicTime();
+}
+
+bool RazerDevice::submitFrame(qlonglong presentationTime, QByteArray rgbData)
+{
+    qDebug("Called %s", Q_FUNC_INFO);
+    CustomFrame frame(frameWidth(), frameHeight());
+    if (rgbData.size() != frame.size()) {
+        if (calledFromDBus())
+            sendErrorReply(QDBusError::InvalidArgs, QString("Expected %1 bytes of RGB data.").arg(frame.size()));
+        return false;
+    }
+    memcpy(frame.data(), rgbData.constData(), frame.size());
+
+    qint64 now = monotonicTime();
+    if (!jitterBuffer.push(presentationTime, frame, now)) {
+        if (calledFromDBus() && presentationTime - now > JitterBuffer::horizon)
+            sendErrorReply(QDBusError::InvalidArgs, QString("Presentation time is more than %1 us ahead.").arg(JitterBuffer::horizon));
+        else if (calledFromDBus())
+            sendErrorReply(QDBusError::LimitsExceeded, "Too many frames queued.");
+        return false;
+    }
+    // The effect would overwrite the client's frames
+    pauseCustomEffectThread();
+    cancelTransition();
+    schedulePresent();
+    return true;
+}
+
+void RazerDevice::schedulePresent()
+{
+    if (jitterBuffer.isEmpty()) {
+        presentTimer->stop();
+        return;
+    }
+    qint64 delay = jitterBuffer.nextSendTime() - monotonicTime();
+    presentTimer->start(qMax(delay / 1000, static_cast<qint64>(0)));
+}
+
+void RazerDevice::presentTimerTick()
+{
+    qint64 pts;
+    CustomFrame frame;
+    QVector<qint64> dropped;
+    // Timers only have millisecond precision, rather present a bit early than a whole millisecond late
+    if (jitterBuffer.takeDue(monotonicTime() + 500, &pts, &frame, &dropped)) {
+        foreach (qint64 droppedPts, dropped)
+            emit FrameDropped(droppedPts);
+
+        qint64 start = monotonicTime();
+        presentFrame(frame, [this, start, pts](ReportScheduler::Result result) {
+            if (result != ReportScheduler::Result::Sent) {
+                emit FrameDropped(pts);
+                return;
+            }
+            qint64 end = monotonicTime();
+            jitterBuffer.addLatencySample(end - start);
+            emit FramePresented(pts, end - pts);
+        });
+    }
+    schedulePresent();
+}
+
+bool RazerDevice::defineLayerFrame(uchar layer, uchar row, uchar startColumn, uchar endColumn, QByteArray rgbData)
+{
+    qDebug("Called %s", Q_FUNC_INFO);
+    if (!thread->defineLayerRow(layer, row, startColumn, endColumn, rgbData)) {
+        if (calledFromDBus())
+            sendErrorReply(QDBusError::InvalidArgs);
+        return false;
+    }
+    startFrameTimer();
+    return true;
+}
+
+bool RazerDevice::setLayerProperties(uchar layer, QString blendMode, uchar opacity)
+{
+    qDebug("Called %s", Q_FUNC_INFO);
+    BlendMode mode;
+    if (blendMode == "normal") {
+        mode = BlendMode::Normal;
+    } else if (blendMode == "add") {
+        mode = BlendMode::Add;
+    } else if (blendMode == "multiply") {
+        mode = BlendMode::Multiply;
+    } else if (blendMode == "screen") {
+        mode = BlendMode::Screen;
+    } else {
+        if (calledFromDBus())
+            sendErrorReply(QDBusError::InvalidArgs, "Unknown blend mode.");
+        return false;
+    }
+    if (!thread->setLayerProperties(layer, mode, opacity)) {
+        if (calledFromDBus())
+            sendErrorReply(QDBusError::LimitsExceeded);
+        return false;
+    }
+    startFrameTimer();
+    return true;
+}
+
+bool RazerDevice::removeLayer(uchar layer)
+{
+    qDebug("Called %s", Q_FUNC_INFO);
+    if (!thread->removeLayer(layer)) {
+        if (calledFromDBus())
+            sendErrorReply(QDBusError::InvalidArgs, "Unknown layer.");
+        return false;
+    }
+    return true;
+}
+
+bool RazerDevice::acquireLighting(uchar priority)
+{
+    qDebug("Called %s with params %i", Q_FUNC_INFO, priority);
+    // Leases belong to D-Bus clients
+    if (!calledFromDBus())
+        return false;
+    QString client = clientId();
+    leases->acquire(client, priority);
+    leases->watch(client, connection());
+    return true;
+}
+
+bool RazerDevice::releaseLighting()
+{
+    qDebug("Called %s", Q_FUNC_INFO);
+    if (!calledFromDBus())
+        return false;
+    if (!leases->release(clientId())) {
+        sendErrorReply(QDBusError::InvalidArgs, "No lease to release.");
+        return false;
+    }
+    return true;
+}
+
+QString RazerDevice::getLightingOwner()
+{
+    qDebug("Called %s", Q_FUNC_INFO);
+    return leases->owner();
+}
+
+RazerDevice::LightingSnapshot RazerDevice::saveLighting()
+{
+    LightingSnapshot snapshot;
+    foreach (RazerLED *led, leds)
+        snapshot.leds.insert(led->ledId, led->saveState());
+    snapshot.customFrame = showingCustomFrame;
+    snapshot.frame = lastFrame;
+    snapshot.effectName = customEffectName;
+    return snapshot;
+}
+
+void RazerDevice::restoreLighting(const LightingSnapshot &snapshot)
+{
+    // Frames the previous owner queued would replace the restored lighting
+    jitterBuffer.clear();
+    presentTimer->stop();
+    interpolationTimer->stop();
+    scheduler->discardBulk();
+
+    if (snapshot.customFrame && !snapshot.effectName.isEmpty()) {
+        if (!startCustomEffectThread(snapshot.effectName))
+            qWarning("Restoring the custom effect %s went wrong.", qUtf8Printable(snapshot.effectName));
+        return;
+    }
+    if (snapshot.customFrame) {
+        pauseCustomEffectThread();
+        cancelTransition();
+        presentFrame(snapshot.frame, [](ReportScheduler::Result result) {
+            if (result == ReportScheduler::Result::Failed)
+                qWarning("Restoring the custom frame went wrong.");
+        });
+        return;
+    }
+    for (auto it = snapshot.leds.constBegin(); it != snapshot.leds.constEnd(); ++it) {
+        RazerLED *led = leds.value(it.key());
+        if (led != nullptr && !led->applyState(it.value()))
+            qWarning("Restoring the lighting of LED %i went wrong.", static_cast<uchar>(it.key()));
+    }
+}
+
+void RazerDevice::startFrameTimer()
+{
+    // Poll at twice the frame rate so a finished frame never waits longer than half a frame
+    frameTimer->start(qMax(thread->frameInterval() / 2, static_cast<ulong>(1)));
 }
 
 bool RazerDevice::checkFx(QString fxStr)
@@ -403,16 +1029,283 @@ bool RazerDevice::checkFeature(QString featureStr)
     return true;
 }
 
-void RazerDevice::customRgbDataReady(uchar row, uchar startColumn, uchar endColumn, const QByteArray &rgbData)
+// Resizing clears the frame, so only when it doesn't have the size of the device yet
+void RazerDevice::resizeLastFrame()
+{
+    if (lastFrame.width() != frameWidth() || lastFrame.height() != frameHeight())
+        lastFrame.resize(frameWidth(), frameHeight());
+}
+
+void RazerDevice::presentFrame(const CustomFrame &frame, ReportScheduler::Callback done)
+{
+    // Frames aren't part of scenes, and capturing the frame would replace what was recorded
+    if (capturing) {
+        if (done)
+            done(ReportScheduler::Result::Superseded);
+        return;
+    }
+
+    bool wasOffloaded = showingCustomFrame && offloaded;
+    lastFrame = frame;
+    showingCustomFrame = true;
+    offloaded = false;
+
+    CustomFrame corrected = frame;
+    if (!colorCorrection.isIdentity())
+        colorCorrection.apply(corrected.data(), corrected.size() / 3);
+
+    // The reports are recorded and sent in the bulk lane, control commands can go in between them
+    startCapture();
+    bool ok = true;
+    // A single color is one effect report instead of a report per row, and can be skipped if it didn't change
+    if (corrected.size() > 0 && isUniformRgb(corrected.constData(), corrected.size() / 3)) {
+        const uchar *data = corrected.constData();
+        RGB color = {data[0], data[1], data[2]};
+        if (wasOffloaded && color.r == offloadedColor.r && color.g == offloadedColor.g && color.b == offloadedColor.b) {
+            offloaded = true;
+        } else if (activateStaticColor(color)) {
+            offloaded = true;
+            offloadedColor = color;
+        }
+    }
+    if (!offloaded) {
+        for (uchar row = 0; ok && row < corrected.height(); row++)
+            ok = uploadCustomFrameRow(row, 0, corrected.width() - 1, corrected.rowArray(row));
+        ok = ok && activateCustomFrame();
+    }
+    RecordedReports frameReports = finishCapture();
+
+    if (!ok) {
+        if (done)
+            done(ReportScheduler::Result::Failed);
+        return;
+    }
+    scheduler->submitBulk(frameReports.reports, [this, frameReports, done](ReportScheduler::Result result) {
+        if (result == ReportScheduler::Result::Sent) {
+            queueCommits(frameReports.commits);
+            notifyPropertiesChanged(frameReports.notifications);
+        }
+        if (done)
+            done(result);
+    });
+}
+
+void RazerDevice::customFrameTick()
+{
+    // The transition blends the effect's frames in itself
+    if (transitionTimer->isActive())
+        return;
+
+    // Nothing to do if the effect thread hasn't finished a new frame since the last tick
+    if (!thread->frames().fetch())
+        return;
+
+    presentFrame(thread->frames().readBuffer(), [](ReportScheduler::Result result) {
+        if (result == ReportScheduler::Result::Failed)
+            qWarning("Presenting the custom frame went wrong.");
+    });
+}
+
+bool RazerDevice::applyHardwareEffect(const HardwareEffectModel::State &state, std::function<bool()> command)
+{
+    // Only the reports are recorded, what the device shows doesn't change
+    if (capturing)
+        return command();
+
+    // Frames that are still queued would replace the effect
+    scheduler->discardBulk();
+
+    if (!canTransition() || !HardwareEffectModel::canModel(state.effect)) {
+        cancelTransition();
+        if (!command())
+            return false;
+        hardwareEffect.setState(state, monotonicTime());
+        showingCustomFrame = false;
+        return true;
+    }
+
+    // Custom frames from any other source would fight with the transition
+    thread->pauseThread();
+    customEffectName.clear();
+    frameTimer->stop();
+    jitterBuffer.clear();
+    presentTimer->stop();
+    interpolationTimer->stop();
+
+    beginTransition();
+    // The firmware starts the effect from the beginning when the command is sent, so blend into the
+    // state it will be in at that moment. The first frame is held until then.
+    transitionTarget.setState(state, transitionStart + transitionDuration * 1000);
+    transitionHandOff = command;
+    transitionTick();
+    return true;
+}
+
+bool RazerDevice::canTransition()
+{
+    // The mouse matrix effects only apply to one of the LEDs, the custom frame covers all of them
+    return !capturing && transitionDuration > 0 && hasFx("custom_frame") && !hasQuirk(RazerDeviceQuirks::MouseMatrix)
+           && matrixDimensions.x > 0 && matrixDimensions.y > 0;
+}
+
+bool RazerDevice::beginTransition()
+{
+    if (!canTransition()) {
+        cancelTransition();
+        return false;
+    }
+    qint64 now = monotonicTime();
+    // Starts from what is on the device right now, which might also be a transition that is still running
+    if (showingCustomFrame)
+        transitionFrom = lastFrame;
+    else
+        hardwareEffect.render(now, transitionFrom);
+    transitionStart = now;
+    transitionHandOff = nullptr;
+    return true;
+}
+
+void RazerDevice::cancelTransition()
 {
-    if (!defineCustomFrame(row, startColumn, endColumn, rgbData)) {
-        qWarning("defineCustomFrame went wrong.");
+    transitionTimer->stop();
+    transitionHandOff = nullptr;
+}
+
+void RazerDevice::transitionTick()
+{
+    qint64 now = monotonicTime();
+    qint64 elapsed = now - transitionStart;
+    bool finished = elapsed >= transitionDuration * 1000;
+
+    CustomFrame frame;
+    if (transitionHandOff) {
+        transitionTarget.render(now, frame);
+    } else {
+        thread->frames().fetch();
+        frame = thread->frames().readBuffer();
+        // No frame from the effect yet
+        if (frame.size() != transitionFrom.size())
+            frame = transitionFrom;
+    }
+
+    if (finished) {
+        transitionTimer->stop();
+        if (transitionHandOff) {
+            std::function<bool()> handOff = transitionHandOff;
+            transitionHandOff = nullptr;
+            // The last blended frames would be shown after the effect
+            scheduler->discardBulk();
+            if (!handOff()) {
+                qWarning("Sending the effect after the transition went wrong.");
+                return;
+            }
+            hardwareEffect.setState(transitionTarget.state(), now);
+            showingCustomFrame = false;
+        } else {
+            // The effect takes over, its current frame might not change again if it's static
+            presentFrame(frame, [](ReportScheduler::Result result) {
+                if (result == ReportScheduler::Result::Failed)
+                    qWarning("Presenting the custom frame went wrong.");
+            });
+        }
+        return;
     }
+
+    uchar alpha = static_cast<uchar>(elapsed * 0xFF / (transitionDuration * 1000));
+    CustomFrame blended = transitionFrom;
+    blendRgb(blended.data(), frame.constData(), frame.size() / 3, alpha);
+    presentFrame(blended, [](ReportScheduler::Result result) {
+        if (result == ReportScheduler::Result::Failed)
+            qWarning("Presenting the transition frame went wrong.");
+    });
+    if (!transitionTimer->isActive())
+        transitionTimer->start(minInterpolationInterval * 2);
 }
 
-void RazerDevice::customFrameReady()
+void RazerDevice::lightingOwnerChanged(const QString &previous, const QString &owner)
 {
-    if (!displayCustomFrame()) {
-        qWarning("displayCustomFrame went wrong.");
+    // Clients that released their lease don't get their lighting back
+    if (previous.isEmpty() || leases->holds(previous))
+        lightingSnapshots.insert(previous, saveLighting());
+    for (auto it = lightingSnapshots.begin(); it != lightingSnapshots.end();) {
+        if (!it.key().isEmpty() && !leases->holds(it.key()))
+            it = lightingSnapshots.erase(it);
+        else
+            ++it;
     }
+    emit LightingOwnerChanged(owner);
+
+    if (!lightingSnapshots.contains(owner))
+        return;
+    // Not from within the call that changed the owner, errors of the setters would become its reply
+    LightingSnapshot snapshot = lightingSnapshots.take(owner);
+    QTimer::singleShot(0, this, [this, snapshot, owner]() {
+        if (leases->owner() == owner)
+            restoreLighting(snapshot);
+    });
+}
+
+void RazerDevice::deviceStoppedResponding()
+{
+    qWarning("%s stopped responding, calls fail until it's back.", qUtf8Printable(name));
+    unavailableLighting = saveLighting();
+
+    // Everything that sends on its own would only fail
+    frameTimer->stop();
+    presentTimer->stop();
+    interpolationTimer->stop();
+    cancelTransition();
+    jitterBuffer.clear();
+    scheduler->discardBulk();
+    commitTimer->stop();
+
+    probeTimer->start(health.backoff());
+}
+
+void RazerDevice::probeTick()
+{
+    health.startProbe();
+    if (!reconnect()) {
+        probeTimer->start(health.probeFailed());
+        return;
+    }
+    health.probeSucceeded();
+    qInfo("%s is responding again.", qUtf8Printable(name));
+    // Settings that didn't get stored are still pending
+    if (!pendingCommits.isEmpty())
+        commitTimer->start(commitDelay);
+    restoreLighting(unavailableLighting);
+}
+
+bool RazerDevice::reconnect()
+{
+    // The device is only taken back if it's the same one, the object path ends with the serial
+    QString serial = getObjectPath().path().section('/', -1);
+    QStringList paths {dev_path};
+    struct hid_device_info *devs = hid_enumerate(vendor_id, product_id);
+    for (struct hid_device_info *cur_dev = devs; cur_dev != nullptr; cur_dev = cur_dev->next) {
+        QString path(cur_dev->path);
+        if (cur_dev->interface_number == 0 && !paths.contains(path))
+            paths.append(path);
+    }
+    hid_free_enumeration(devs);
+
+    foreach (const QString &path, paths) {
+        if (handle != nullptr)
+            hid_close(handle);
+        handle = hid_open_path(path.toStdString().c_str());
+        if (handle == nullptr)
+            continue;
+        if (getSerial() == serial) {
+            dev_path = path;
+            // The bus scheduler stays, even if the device came back on another bus
+            location = UsbTopology::locate(dev_path);
+            return true;
+        }
+    }
+    // Possibly another device of the same model, reports fail right away until the next probe anyway
+    if (handle != nullptr)
+        hid_close(handle);
+    handle = nullptr;
+    return false;
 }
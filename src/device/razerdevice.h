@@ -25,20 +25,46 @@
 #include <QString>
 #include <QVector>
 #include <QHash>
+#include <QMap>
 #include <QDBusContext>
+#include <QDBusUnixFileDescriptor>
 #include <QByteArray>
+#include <QTimer>
+
+#include <functional>
 
 #include "../razer_test.h"
 #include "../razerreport.h"
+#include "../customeffect/colorcorrection.h"
 #include "../customeffect/customeffectthread.h"
+#include "../customeffect/frameinterpolator.h"
+#include "../customeffect/hardwareeffectmodel.h"
+#include "../customeffect/jitterbuffer.h"
+#include "../dbus/clientqos.h"
+#include "../dbus/dbuscallcontext.h"
+#include "../dbus/leasearbiter.h"
+#include "../dbus/propertiesnotifier.h"
 #include "../led/razerled.h"
+#include "busscheduler.h"
+#include "devicehealth.h"
+#include "reportscheduler.h"
+#include "usbtopology.h"
 
 // class RazerLED;
 
+// Reports recorded while capturing, with their CRC already calculated
+struct RecordedReports {
+    QVector<razer_report> reports;
+    // Settings to store after sending the reports, see RazerDevice::sendSetting()
+    QMap<QString, std::function<razer_report(RazerVarstore)>> commits;
+    // Property changes to announce once the reports are sent
+    QVector<PropertyChange> notifications;
+};
+
 /**
  * @todo write docs
  */
-class RazerDevice : public QObject, protected QDBusContext
+class RazerDevice : public QObject, protected QDBusContext, protected DBusCallContext
 {
     Q_OBJECT
     Q_CLASSINFO("D-Bus Interface", "io.github.openrazer1.Device")
@@ -48,6 +74,8 @@ class RazerDevice : public QObject, protected QDBusContext
     Q_PROPERTY(QStringList SupportedFx READ getSupportedFx)
     Q_PROPERTY(QStringList SupportedFeatures READ getSupportedFeatures)
     Q_PROPERTY(MatrixDimensions MatrixDimensions READ getMatrixDimensions)
+    Q_PROPERTY(RazerDPI DPI READ getDPI)
+    Q_PROPERTY(ushort PollRate READ getPollRate)
 
 public:
     RazerDevice(QString dev_path, ushort vendor_id, ushort product_id, QString name, QString type, QString pclass, QVector<RazerLedId> ledIds, QStringList fx, QStringList features, QVector<RazerDeviceQuirks> quirks, MatrixDimensions matrixDimensions, ushort maxDPI);
@@ -56,9 +84,31 @@ public:
     virtual bool openDeviceHandle();
     virtual bool initialize() = 0;
 
+    // Size of custom frames. matrix_dimensions are stored as rows (x) and columns (y),
+    // frames are as wide as there are columns.
+    uchar frameWidth() const;
+    uchar frameHeight() const;
+
     int sendReport(razer_report request_report, razer_report *response_report);
+    // Sends a setting that the device keeps across power cycles. With a commit delay the setting is only
+    // applied at first and stored once no change with the same key came in for the delay.
+    bool sendSetting(const QString &key, std::function<razer_report(RazerVarstore)> buildReport);
+    void discardPendingSettings(const QString &keyPrefix);
+
+    // While capturing, reports are recorded instead of sent and always succeed
+    void startCapture();
+    RecordedReports finishCapture();
+    int capturedReportCount() const;
+    // Sends recorded reports as they are and returns how many were sent before one failed.
+    // Nothing else may send to the device at the same time.
+    int sendPreparedReports(const QVector<razer_report> &reports);
+    void queueCommits(const QMap<QString, std::function<razer_report(RazerVarstore)>> &commits);
     QDBusObjectPath getObjectPath();
 
+    // Announces a changed property to D-Bus clients, or records it while capturing
+    void notifyPropertyChanged(const PropertyChange &change);
+    void notifyPropertiesChanged(const QVector<PropertyChange> &changes);
+
     // Getters behind properties (Q_PROPERTY)
     QString getName();
     QString getType();
@@ -72,6 +122,27 @@ public:
     bool hasFx(const QString &fxStr);
     bool hasQuirk(RazerDeviceQuirks quirk);
 
+    // Applies the color correction to a color that is sent to the device, e.g. for a static effect
+    RGB correctColor(RGB color);
+
+    // Rate limits of the D-Bus clients of the device and its LEDs
+    ClientQos *clientQos();
+    // Which client controls the lighting of the device and its LEDs
+    LeaseArbiter *leaseArbiter();
+    // Open while the device doesn't respond, reports fail right away then
+    const DeviceHealth *deviceHealth() const;
+
+    // Known once the handle is open, invalid for devices that aren't on USB
+    UsbLocation usbLocation() const;
+    // Devices whose input suffers from a busy bus, e.g. mice, get their frames sent first
+    bool isInputCritical() const;
+    // Shares the bus with the other devices on it, frames are interleaved and transactions timed
+    void setBusScheduler(BusScheduler *bus);
+
+    // Switches to an effect that runs on the device. With a transition duration the current frame is
+    // crossfaded into the effect first and command, which sends the effect, is only called at the end.
+    bool applyHardwareEffect(const HardwareEffectModel::State &state, std::function<bool()> command);
+
 public Q_SLOTS:
     // TODO: CamelCase public functions (at least for D-Bus)
     virtual QString getSerial();
@@ -86,15 +157,60 @@ public Q_SLOTS:
     virtual bool setPollRate(ushort poll_rate);
 
     // Custom frame
-    virtual bool displayCustomFrame() = 0;
-    virtual bool defineCustomFrame(uchar row, uchar startColumn, uchar endColumn, QByteArray rgbData) = 0;
+    bool displayCustomFrame();
+    bool defineCustomFrame(uchar row, uchar startColumn, uchar endColumn, QByteArray rgbData);
+    // "none", "linear" or "eased"
+    bool setFrameInterpolation(QString mode);
+
+    // Color correction of everything sent to the device. Applies to colors and frames set afterwards.
+    bool setColorCorrection(double gamma, double redGain, double greenGain, double blueGain);
+    bool setSoftwareBrightness(uchar brightness);
+
+    // Crossfade between effects, 0 switches instantly
+    bool setTransitionDuration(ushort milliseconds);
+
+    // Stores pending settings on the device now instead of after the commit delay
+    bool commit();
+    // 0 stores every change right away
+    bool setCommitDelay(ushort milliseconds);
 
     // getDeviceMode, setDeviceMode
 
     bool startCustomEffectThread(QString effectName);
     void pauseCustomEffectThread();
+    bool playAnimation(QDBusUnixFileDescriptor file, bool loop);
+
+    // Client frames shown at a presentation time, in microseconds of getMonotonicTime()
+    qlonglong getMonotonicTime();
+    bool submitFrame(qlonglong presentationTime, QByteArray rgbData);
+
+    // Layers composited on top of the custom effect
+    bool defineLayerFrame(uchar layer, uchar row, uchar startColumn, uchar endColumn, QByteArray rgbData);
+    bool setLayerProperties(uchar layer, QString blendMode, uchar opacity);
+    bool removeLayer(uchar layer);
+
+    // Lighting calls of clients that don't own the lighting are suspended until they do again.
+    // The higher priority wins, the lease ends with releaseLighting() or when the client disconnects.
+    bool acquireLighting(uchar priority);
+    bool releaseLighting();
+    // Unique name of the client that owns the lighting, empty if nobody does
+    QString getLightingOwner();
+
+Q_SIGNALS:
+    // lateness is how many microseconds after presentationTime the frame was fully shown, negative if early
+    void FramePresented(qlonglong presentationTime, qlonglong lateness);
+    // The frame was superseded by a newer one that was due at the same time
+    void FrameDropped(qlonglong presentationTime);
+    void LightingOwnerChanged(QString owner);
 
 protected:
+    // Calls come from the adaptor (QDBusContext) or from RazerDeviceDispatcher
+    using DBusCallContext::calledFromDBus;
+    using DBusCallContext::connection;
+    using DBusCallContext::message;
+    using DBusCallContext::sendErrorReply;
+    friend class RazerDeviceDispatcher;
+
     hid_device *handle = nullptr;
 
     QString dev_path;
@@ -112,12 +228,101 @@ protected:
     ushort maxDPI;
 
     CustomEffectThread *thread;
+    QTimer *frameTimer;
+
+    ColorCorrection colorCorrection;
+
+    bool capturing = false;
+    RecordedReports recorded;
+
+    // Frames are sent in the bulk lane, control commands right away
+    ReportScheduler *scheduler;
+    ClientQos qos;
+    LeaseArbiter *leases;
+    int sendPreparedReport(const razer_report &request_report, razer_report *response_report);
+    // The transaction with the retries, without the circuit breaker and the timing
+    virtual int exchangeReport(const razer_report &request_report, razer_report *response_report);
+
+    UsbLocation location;
+    BusScheduler *bus = nullptr;
+
+    int commitDelay = 1000;
+    QTimer *commitTimer;
+    QMap<QString, std::function<razer_report(RazerVarstore)>> pendingCommits;
+
+    // Built from the serial once, which has to be read from the device
+    QDBusObjectPath objectPath;
+    PropertiesNotifier *notifier;
+
+    FrameInterpolator interpolator;
+    // Rows of the next client frame while interpolating
+    CustomFrame stagedFrame;
+    QTimer *interpolationTimer;
+    // Moving average of the time it takes to present a frame, in microseconds
+    qint64 presentDuration = 0;
+
+    // What the device shows when it's not showing custom frames
+    HardwareEffectModel hardwareEffect;
+    bool showingCustomFrame = false;
+    // The last frame was uniform and is shown with activateStaticColor() instead of custom frame rows
+    bool offloaded = false;
+    RGB offloadedColor;
+    // Last frame shown, before color correction
+    CustomFrame lastFrame;
+
+    int transitionDuration = 0;
+    QTimer *transitionTimer;
+    CustomFrame transitionFrom;
+    qint64 transitionStart = 0;
+    // The target is the custom effect thread if there's no command to hand off to
+    HardwareEffectModel transitionTarget;
+    std::function<bool()> transitionHandOff;
+    bool canTransition();
+    bool beginTransition();
+    void cancelTransition();
+
+    JitterBuffer jitterBuffer;
+    QTimer *presentTimer;
+    void schedulePresent();
 
     QHash<RazerLedId, RazerLED *> leds;
 
+    // What a client showed when it lost the lighting, shown again once it owns the lighting again.
+    // The lighting from before the first lease is stored for the empty owner.
+    struct LightingSnapshot {
+        QHash<RazerLedId, RazerLED::State> leds;
+        bool customFrame = false;
+        CustomFrame frame;
+        // Named effect of the effect thread, it's started again instead of showing its last frame
+        QString effectName;
+    };
+    QHash<QString, LightingSnapshot> lightingSnapshots;
+    QString customEffectName;
+    LightingSnapshot saveLighting();
+    void restoreLighting(const LightingSnapshot &snapshot);
+
+    // Only changed on the thread that sends, see sendPreparedReports()
+    DeviceHealth health;
+    QTimer *probeTimer;
+    // Shown again once the device responds again, it may have lost its state
+    LightingSnapshot unavailableLighting;
+    // Opens the handle again, also if the device came back on another hidraw node
+    bool reconnect();
+
     bool checkFeature(QString featureStr);
     bool checkFx(QString fxStr);
 
+    // Device specific implementation of the custom frame, without interpolation
+    virtual bool activateCustomFrame() = 0;
+    virtual bool uploadCustomFrameRow(uchar row, uchar startColumn, uchar endColumn, QByteArray rgbData) = 0;
+    // Shows one color on the whole matrix with a native effect, returns false if the device can't
+    virtual bool activateStaticColor(RGB color);
+
+    void resizeLastFrame();
+    // Queues the frame in the bulk lane of the scheduler, done is called once it's on the device
+    void presentFrame(const CustomFrame &frame, ReportScheduler::Callback done = nullptr);
+    void startFrameTimer();
+
     QHash<uchar, QString> keyboardLayoutIds {
         {0x01, "US"},
         {0x02, "Greek"},
@@ -131,8 +336,13 @@ protected:
     };
 
 private slots:
-    void customRgbDataReady(uchar row, uchar startColumn, uchar endColumn, const QByteArray &rgbData);
-    void customFrameReady();
+    void customFrameTick();
+    void presentTimerTick();
+    void interpolationTick();
+    void transitionTick();
+    void lightingOwnerChanged(const QString &previous, const QString &owner);
+    void deviceStoppedResponding();
+    void probeTick();
 };
 
 #endif // RAZERDEVICE_H
@@ -21,6 +21,8 @@
 #include "../led/razerfakeled.h"
 
 int RazerFakeDevice::serialCounter = 1000;
+// The demo runs for as long as it wants, only the last reports are kept
+static const int maxReceivedReports = 1000;
 
 bool RazerFakeDevice::openDeviceHandle()
 {
@@ -42,6 +44,35 @@ bool RazerFakeDevice::initialize()
     return true;
 }
 
+QVector<razer_report> RazerFakeDevice::receivedReports() const
+{
+    return received;
+}
+
+void RazerFakeDevice::clearReceivedReports()
+{
+    received.clear();
+}
+
+void RazerFakeDevice::failAfter(int reports)
+{
+    reportsUntilFailure = reports;
+}
+
+int RazerFakeDevice::exchangeReport(const razer_report &request_report, razer_report *response_report)
+{
+    if (reportsUntilFailure == 0)
+        return 1;
+    if (reportsUntilFailure > 0)
+        reportsUntilFailure--;
+    if (received.size() == maxReceivedReports)
+        received.removeFirst();
+    received.append(request_report);
+    *response_report = request_report;
+    response_report->status = RazerStatus::SUCCESSFUL;
+    return 0;
+}
+
 /* --------------------- DBUS METHODS --------------------- */
 
 QString RazerFakeDevice::getSerial()
@@ -78,6 +109,7 @@ bool RazerFakeDevice::setDPI(RazerDPI dpi)
         return false;
 
     this->dpi = dpi;
+    notifyPropertyChanged({getObjectPath(), "io.github.openrazer1.Device", "DPI", QVariant::fromValue(dpi)});
 
     return true;
 }
@@ -99,6 +131,7 @@ bool RazerFakeDevice::setPollRate(ushort poll_rate)
 
     if (poll_rate == 1000 || poll_rate == 500 || poll_rate == 125) {
         this->poll_rate = poll_rate;
+        notifyPropertyChanged({getObjectPath(), "io.github.openrazer1.Device", "PollRate", QVariant::fromValue(poll_rate)});
     } else {
         if (calledFromDBus())
             sendErrorReply(QDBusError::Failed);
@@ -107,7 +140,7 @@ bool RazerFakeDevice::setPollRate(ushort poll_rate)
     return true;
 }
 
-bool RazerFakeDevice::displayCustomFrame()
+bool RazerFakeDevice::activateCustomFrame()
 {
     qDebug("Called %s", Q_FUNC_INFO);
     if (!checkFx("custom_frame"))
@@ -115,10 +148,16 @@ bool RazerFakeDevice::displayCustomFrame()
     return true;
 }
 
-bool RazerFakeDevice::defineCustomFrame(uchar row, uchar startColumn, uchar endColumn, QByteArray rgbData)
+bool RazerFakeDevice::uploadCustomFrameRow(uchar row, uchar startColumn, uchar endColumn, QByteArray rgbData)
 {
     qDebug("Called %s with param %i, %i, %i, %s", Q_FUNC_INFO, row, startColumn, endColumn, rgbData.toHex().constData());
     if (!checkFx("custom_frame"))
         return false;
     return true;
 }
+
+bool RazerFakeDevice::activateStaticColor(RGB color)
+{
+    qDebug("Called %s with params %i, %i, %i", Q_FUNC_INFO, color.r, color.g, color.b);
+    return fx.contains("static");
+}
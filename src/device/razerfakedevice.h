@@ -28,6 +28,14 @@ class RazerFakeDevice : public RazerDevice
 {
     using RazerDevice::RazerDevice;
 
+public:
+    // Reports the device received, for tests
+    QVector<razer_report> receivedReports() const;
+    void clearReceivedReports();
+    // The next reports succeed, every report after them fails. -1 never fails.
+    void failAfter(int reports);
+
+private:
     bool openDeviceHandle() override;
 
     bool initialize() override;
@@ -42,15 +50,20 @@ class RazerFakeDevice : public RazerDevice
     ushort getPollRate() override;
     bool setPollRate(ushort poll_rate) override;
 
-    bool displayCustomFrame() override;
-    bool defineCustomFrame(uchar row, uchar startColumn, uchar endColumn, QByteArray rgbData) override;
+    bool activateCustomFrame() override;
+    bool uploadCustomFrameRow(uchar row, uchar startColumn, uchar endColumn, QByteArray rgbData) override;
+    bool activateStaticColor(RGB color) override;
+
+    int exchangeReport(const razer_report &request_report, razer_report *response_report) override;
 
-private:
     QString serial;
     QString fwVersion = "v99.99";
 
     static int serialCounter;
 
+    QVector<razer_report> received;
+    int reportsUntilFailure = -1;
+
     RazerDPI dpi = {500, 500};
     ushort poll_rate = 1000;
 };
@@ -36,7 +36,7 @@ bool RazerMatrixDevice::initialize()
 
 /* --------------------- DBUS METHODS --------------------- */
 
-bool RazerMatrixDevice::displayCustomFrame()
+bool RazerMatrixDevice::activateCustomFrame()
 {
     qDebug("Called %s", Q_FUNC_INFO);
     if (!checkFx("custom_frame"))
@@ -50,7 +50,7 @@ bool RazerMatrixDevice::displayCustomFrame()
     }
 }
 
-bool RazerMatrixDevice::defineCustomFrame(uchar row, uchar startColumn, uchar endColumn, QByteArray rgbData)
+bool RazerMatrixDevice::uploadCustomFrameRow(uchar row, uchar startColumn, uchar endColumn, QByteArray rgbData)
 {
     qDebug("Called %s with param %i, %i, %i, %s", Q_FUNC_INFO, row, startColumn, endColumn, rgbData.toHex().constData());
     if (!checkFx("custom_frame"))
@@ -77,3 +77,13 @@ bool RazerMatrixDevice::defineCustomFrame(uchar row, uchar startColumn, uchar en
     }
     return true;
 }
+
+bool RazerMatrixDevice::activateStaticColor(RGB color)
+{
+    // The mouse matrix effect only applies to one LED, the custom frame covers all of them
+    if (!fx.contains("static") || quirks.contains(RazerDeviceQuirks::MouseMatrix))
+        return false;
+
+    RazerMatrixLED *led = static_cast<RazerMatrixLED *>(leds.values().first());
+    return led->setMatrixEffect(RazerMatrixEffectId::Static, color.r, color.g, color.b);
+}
@@ -30,8 +30,9 @@ class RazerMatrixDevice : public RazerDevice
 
     bool initialize() override;
 
-    bool displayCustomFrame() override;
-    bool defineCustomFrame(uchar row, uchar startColumn, uchar endColumn, QByteArray rgbData) override;
+    bool activateCustomFrame() override;
+    bool uploadCustomFrameRow(uchar row, uchar startColumn, uchar endColumn, QByteArray rgbData) override;
+    bool activateStaticColor(RGB color) override;
 };
 
 #endif // RAZERMATRIXDEVICE_H
@@ -0,0 +1,112 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "busscheduler.h"
+#include "reportscheduler.h"
+
+ReportScheduler::ReportScheduler(SendFunction send, QObject *parent)
+    : QObject(parent)
+    , send(send)
+    , current {{}, 0, nullptr}
+    , next {{}, 0, nullptr}
+{
+    // Lets the event loop handle D-Bus calls between two reports
+    bulkTimer = new QTimer(this);
+    bulkTimer->setInterval(0);
+    connect(bulkTimer, &QTimer::timeout, this, &ReportScheduler::sendNextBulkReport);
+}
+
+ReportScheduler::~ReportScheduler()
+{
+    if (bus != nullptr)
+        bus->detach(this);
+}
+
+void ReportScheduler::submitBulk(const QVector<razer_report> &reports, Callback done)
+{
+    if (reports.isEmpty()) {
+        if (done)
+            done(Result::Sent);
+        return;
+    }
+    if (current.reports.isEmpty()) {
+        current = {reports, 0, done};
+        wakeBulkLane();
+        return;
+    }
+    finish(next, Result::Superseded);
+    next = {reports, 0, done};
+}
+
+void ReportScheduler::discardBulk()
+{
+    bulkTimer->stop();
+    finish(current, Result::Superseded);
+    finish(next, Result::Superseded);
+}
+
+bool ReportScheduler::isBulkPending() const
+{
+    return !current.reports.isEmpty();
+}
+
+void ReportScheduler::setBusScheduler(BusScheduler *bus)
+{
+    this->bus = bus;
+    bulkTimer->stop();
+    if (isBulkPending())
+        wakeBulkLane();
+}
+
+void ReportScheduler::sendNextBulkReport()
+{
+    if (current.reports.isEmpty()) {
+        bulkTimer->stop();
+        return;
+    }
+    razer_report response_report;
+    bool ok = send(current.reports.at(current.sent), &response_report) == 0;
+    if (ok && ++current.sent < current.reports.size())
+        return;
+
+    Job job = current;
+    current = next;
+    next = {{}, 0, nullptr};
+    if (current.reports.isEmpty())
+        bulkTimer->stop();
+    finish(job, ok ? Result::Sent : Result::Failed);
+}
+
+void ReportScheduler::wakeBulkLane()
+{
+    if (bus != nullptr)
+        bus->wake();
+    else
+        bulkTimer->start();
+}
+
+void ReportScheduler::finish(Job &job, Result result)
+{
+    if (job.reports.isEmpty())
+        return;
+    // The callback might already submit the next frame
+    Callback done = job.done;
+    job = {{}, 0, nullptr};
+    if (done)
+        done(result);
+}
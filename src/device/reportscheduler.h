@@ -0,0 +1,87 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REPORTSCHEDULER_H
+#define REPORTSCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+
+#include <functional>
+
+#include "../razerreport.h"
+
+class BusScheduler;
+
+/**
+ * Sends the reports of a device in two lanes.
+ *
+ * Control commands are sent right away by the D-Bus call that makes them. Frames go
+ * into the bulk lane, which sends one report per event loop iteration, so a control
+ * command that comes in while a frame is uploaded waits for at most one row instead
+ * of the whole frame. Besides the frame that is being sent the bulk lane only holds
+ * the newest frame, a frame that waits behind it is superseded by the next one. The
+ * frame that is being sent is never superseded, a slow device would show none otherwise.
+ * With a BusScheduler the devices on the same bus take turns instead.
+ */
+class ReportScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Result {
+        Sent,
+        Failed,
+        // Replaced by a newer frame or discarded before all of its reports were sent
+        Superseded
+    };
+
+    typedef std::function<int(const razer_report &, razer_report *)> SendFunction;
+    typedef std::function<void(Result)> Callback;
+
+    explicit ReportScheduler(SendFunction send, QObject *parent = nullptr);
+    ~ReportScheduler() override;
+
+    // done is called once all reports are sent, right away if reports is empty
+    void submitBulk(const QVector<razer_report> &reports, Callback done);
+    // For control commands that change what the device shows, pending frames would override them
+    void discardBulk();
+    bool isBulkPending() const;
+
+    // Called by BusScheduler::attach() and detach()
+    void setBusScheduler(BusScheduler *bus);
+    void sendNextBulkReport();
+
+private:
+    struct Job {
+        QVector<razer_report> reports;
+        int sent;
+        Callback done;
+    };
+    static void finish(Job &job, Result result);
+    void wakeBulkLane();
+
+    SendFunction send;
+    QTimer *bulkTimer;
+    BusScheduler *bus = nullptr;
+    Job current;
+    Job next;
+};
+
+#endif // REPORTSCHEDULER_H
@@ -0,0 +1,65 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+#include "usbtopology.h"
+
+static QString readAttribute(const QDir &dir, const QString &name)
+{
+    QFile file(dir.filePath(name));
+    if (!file.open(QIODevice::ReadOnly))
+        return QString();
+    return QString::fromLatin1(file.readAll()).trimmed();
+}
+
+bool UsbLocation::isValid() const
+{
+    return bus >= 0;
+}
+
+UsbLocation UsbTopology::locate(const QString &hidrawPath, const QString &sysfsRoot)
+{
+    UsbLocation location;
+    QString node = QFileInfo(hidrawPath).fileName();
+    if (!node.startsWith("hidraw"))
+        return location;
+
+    // The device link points into the tree of the HID device, e.g.
+    // .../usb1/1-2/1-2.3/1-2.3:1.0/0003:1532:0226.0005. The USB device is the first
+    // directory above it with the bus number, the interface doesn't have one.
+    QString path = QFileInfo(QString("%1/class/hidraw/%2/device").arg(sysfsRoot, node)).canonicalFilePath();
+    QString root = QFileInfo(sysfsRoot).canonicalFilePath();
+    if (path.isEmpty() || root.isEmpty())
+        return location;
+    for (QDir dir(path); !dir.isRoot() && dir.absolutePath().startsWith(root); dir.cdUp()) {
+        QString busnum = readAttribute(dir, "busnum");
+        if (busnum.isEmpty())
+            continue;
+        bool ok;
+        int bus = busnum.toInt(&ok);
+        if (!ok)
+            break;
+        location.bus = bus;
+        location.ports = readAttribute(dir, "devpath");
+        break;
+    }
+    return location;
+}
@@ -0,0 +1,44 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef USBTOPOLOGY_H
+#define USBTOPOLOGY_H
+
+#include <QString>
+
+// Where a device is connected, as the kernel numbers buses and ports
+struct UsbLocation {
+    // -1 if unknown, e.g. for fake devices
+    int bus = -1;
+    // Ports from the root hub on, e.g. "2.3" for port 3 of the hub on port 2
+    QString ports;
+
+    bool isValid() const;
+};
+
+/**
+ * Looks up the USB location of hidraw devices in sysfs.
+ */
+class UsbTopology
+{
+public:
+    // hidrawPath is the path hidapi opens, e.g. /dev/hidraw3
+    static UsbLocation locate(const QString &hidrawPath, const QString &sysfsRoot = "/sys");
+};
+
+#endif // USBTOPOLOGY_H
@@ -180,16 +180,17 @@ bool RazerClassicLED::setBrightness(uchar brightness)
     qDebug("Called %s with params %i", Q_FUNC_INFO, brightness);
     if (!checkFx("brightness"))
         return false;
-    razer_report report, response_report;
-
-    report = razer_chroma_standard_set_led_brightness(RazerVarstore::STORE, this->ledId, brightness);
-    if (device->sendReport(report, &response_report) != 0) {
+    RazerLedId ledId = this->ledId;
+    bool ok = device->sendSetting(QString("brightness/%1").arg(static_cast<uchar>(ledId)), [=](RazerVarstore varstore) {
+        return razer_chroma_standard_set_led_brightness(varstore, ledId, brightness);
+    });
+    if (!ok) {
         sendErrorReply(QDBusError::Failed);
         return false;
     }
 
     // Save state into LED variable
-    this->brightness = brightness;
+    saveBrightness(brightness);
 
     return true;
 }
@@ -213,14 +214,22 @@ bool RazerClassicLED::getBrightness(uchar *brightness)
     return true;
 }
 
+void RazerClassicLED::restoreState(const State &state)
+{
+    RazerLED::restoreState(state);
+    // Every effect turns the LED on, only Off turns it off
+    classicState = state.effect == RazerEffect::Off ? RazerClassicLedState::Off : RazerClassicLedState::On;
+}
+
 /* --------------------- PRIVATE METHODS --------------------- */
 
 bool RazerClassicLED::setLedState(RazerClassicLedState state)
 {
-    razer_report report, response_report;
-
-    report = razer_chroma_standard_set_led_state(RazerVarstore::STORE, this->ledId, state);
-    if (device->sendReport(report, &response_report) != 0) {
+    RazerLedId ledId = this->ledId;
+    bool ok = device->sendSetting(QString("state/%1").arg(static_cast<uchar>(ledId)), [=](RazerVarstore varstore) {
+        return razer_chroma_standard_set_led_state(varstore, ledId, state);
+    });
+    if (!ok) {
         return false;
     }
 
@@ -259,10 +268,11 @@ bool RazerClassicLED::ensureLedStateOn()
 
 bool RazerClassicLED::setLedEffect(RazerClassicEffectId effect)
 {
-    razer_report report, response_report;
-
-    report = razer_chroma_standard_set_led_effect(RazerVarstore::STORE, this->ledId, effect);
-    if (device->sendReport(report, &response_report) != 0) {
+    RazerLedId ledId = this->ledId;
+    bool ok = device->sendSetting(QString("effect/%1").arg(static_cast<uchar>(ledId)), [=](RazerVarstore varstore) {
+        return razer_chroma_standard_set_led_effect(varstore, ledId, effect);
+    });
+    if (!ok) {
         return false;
     }
 
@@ -290,10 +300,12 @@ bool RazerClassicLED::getLedEffect(RazerClassicEffectId *effect)
 
 bool RazerClassicLED::setLedRgb(RGB color)
 {
-    razer_report report, response_report;
-
-    report = razer_chroma_standard_set_led_rgb(RazerVarstore::STORE, this->ledId, color.r, color.g, color.b);
-    if (device->sendReport(report, &response_report) != 0) {
+    RazerLedId ledId = this->ledId;
+    color = device->correctColor(color);
+    bool ok = device->sendSetting(QString("rgb/%1").arg(static_cast<uchar>(ledId)), [=](RazerVarstore varstore) {
+        return razer_chroma_standard_set_led_rgb(varstore, ledId, color.r, color.g, color.b);
+    });
+    if (!ok) {
         return false;
     }
 
@@ -44,6 +44,8 @@ public:
     bool setBrightness(uchar brightness) override;
     bool getBrightness(uchar *brightness) override;
 
+    void restoreState(const State &state) override;
+
 private:
     bool setLedState(RazerClassicLedState state);
     bool getLedState(RazerClassicLedState *state);
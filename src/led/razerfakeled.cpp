@@ -30,6 +30,8 @@ bool RazerFakeLED::setNone()
     qDebug("Called %s", Q_FUNC_INFO);
     if (!checkFx("off"))
         return false;
+    if (!sendReport(razer_chroma_standard_set_led_rgb(RazerVarstore::NOSTORE, ledId, 0x00, 0x00, 0x00)))
+        return false;
     saveFxAndColors(RazerEffect::Off, 0);
     return true;
 }
@@ -39,6 +41,8 @@ bool RazerFakeLED::setStatic(RGB color)
     qDebug("Called %s with params %i, %i, %i", Q_FUNC_INFO, color.r, color.g, color.b);
     if (!checkFx("static"))
         return false;
+    if (!sendReport(razer_chroma_standard_set_led_rgb(RazerVarstore::NOSTORE, ledId, color.r, color.g, color.b)))
+        return false;
     saveFxAndColors(RazerEffect::Static, 1, {color.r, color.g, color.b});
     return true;
 }
@@ -48,6 +52,8 @@ bool RazerFakeLED::setBreathing(RGB color)
     qDebug("Called %s with params %i, %i, %i", Q_FUNC_INFO, color.r, color.g, color.b);
     if (!checkFx("breathing"))
         return false;
+    if (!sendReport(razer_chroma_standard_set_led_rgb(RazerVarstore::NOSTORE, ledId, color.r, color.g, color.b)))
+        return false;
     saveFxAndColors(RazerEffect::Breathing, 1, {color.r, color.g, color.b});
     return true;
 }
@@ -57,6 +63,8 @@ bool RazerFakeLED::setBreathingDual(RGB color, RGB color2)
     qDebug("Called %s with params %i, %i, %i, %i, %i, %i", Q_FUNC_INFO, color.r, color.g, color.b, color2.r, color2.g, color2.b);
     if (!checkFx("breathing_dual"))
         return false;
+    if (!sendReport(razer_chroma_standard_set_led_rgb(RazerVarstore::NOSTORE, ledId, color.r, color.g, color.b)))
+        return false;
     saveFxAndColors(RazerEffect::BreathingDual, 2, color, color2);
     return true;
 }
@@ -66,6 +74,8 @@ bool RazerFakeLED::setBreathingRandom()
     qDebug("Called %s", Q_FUNC_INFO);
     if (!checkFx("breathing_random"))
         return false;
+    if (!sendReport(razer_chroma_standard_set_led_rgb(RazerVarstore::NOSTORE, ledId, 0x00, 0x00, 0x00)))
+        return false;
     saveFxAndColors(RazerEffect::BreathingRandom, 0);
     return true;
 }
@@ -75,6 +85,8 @@ bool RazerFakeLED::setBlinking(RGB color)
     qDebug("Called %s with params %i, %i, %i", Q_FUNC_INFO, color.r, color.g, color.b);
     if (!checkFx("blinking"))
         return false;
+    if (!sendReport(razer_chroma_standard_set_led_rgb(RazerVarstore::NOSTORE, ledId, color.r, color.g, color.b)))
+        return false;
     saveFxAndColors(RazerEffect::Blinking, 1, {color.r, color.g, color.b});
     return true;
 }
@@ -84,6 +96,8 @@ bool RazerFakeLED::setSpectrum()
     qDebug("Called %s", Q_FUNC_INFO);
     if (!checkFx("spectrum"))
         return false;
+    if (!sendReport(razer_chroma_standard_set_led_rgb(RazerVarstore::NOSTORE, ledId, 0x00, 0x00, 0x00)))
+        return false;
     saveFxAndColors(RazerEffect::Spectrum, 0);
     return true;
 }
@@ -93,6 +107,9 @@ bool RazerFakeLED::setWave(WaveDirection direction)
     qDebug("Called %s with params %hhu", Q_FUNC_INFO, static_cast<uchar>(direction));
     if (!checkFx("wave"))
         return false;
+    if (!sendReport(razer_chroma_standard_set_led_rgb(RazerVarstore::NOSTORE, ledId, 0x00, 0x00, 0x00)))
+        return false;
+    this->direction = direction;
     saveFxAndColors(RazerEffect::Wave, 0);
     return true;
 }
@@ -102,6 +119,9 @@ bool RazerFakeLED::setReactive(ReactiveSpeed speed, RGB color)
     qDebug("Called %s with params %hhu, %i, %i, %i", Q_FUNC_INFO, static_cast<uchar>(speed), color.r, color.g, color.b);
     if (!checkFx("reactive"))
         return false;
+    if (!sendReport(razer_chroma_standard_set_led_rgb(RazerVarstore::NOSTORE, ledId, color.r, color.g, color.b)))
+        return false;
+    this->speed = speed;
     saveFxAndColors(RazerEffect::Reactive, 1, {color.r, color.g, color.b});
     return true;
 }
@@ -111,7 +131,20 @@ bool RazerFakeLED::setBrightness(uchar brightness)
     qDebug("Called %s with params %i", Q_FUNC_INFO, brightness);
     if (!checkFx("brightness"))
         return false;
-    this->brightness = brightness;
+    if (!sendReport(razer_chroma_standard_set_led_brightness(RazerVarstore::NOSTORE, ledId, brightness)))
+        return false;
+    saveBrightness(brightness);
+    return true;
+}
+
+bool RazerFakeLED::sendReport(const razer_report &report)
+{
+    razer_report response_report;
+    if (device->sendReport(report, &response_report) != 0) {
+        if (calledFromDBus())
+            sendErrorReply(QDBusError::Failed);
+        return false;
+    }
     return true;
 }
 
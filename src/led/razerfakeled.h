@@ -20,6 +20,7 @@
 #define RAZERFAKELED_H
 
 #include "razerled.h"
+#include "../razerreport.h"
 
 /**
  * @todo write docs
@@ -43,6 +44,10 @@ public:
 
     bool setBrightness(uchar brightness) override;
     bool getBrightness(uchar *brightness) override;
+
+private:
+    // One report per call like a real LED, so scenes and batches can be tried out on fake devices
+    bool sendReport(const razer_report &report);
 };
 
 #endif // RAZERFAKELED_H
@@ -18,7 +18,7 @@
 
 #include "razerled.h"
 
-RazerLED::RazerLED(RazerDevice *device, RazerLedId ledId) : device(device), ledId(ledId)
+RazerLED::RazerLED(RazerDevice *device, RazerLedId ledId) : DBusCallContext(this), device(device), ledId(ledId)
 {
 }
 
@@ -27,7 +27,7 @@ RazerLED::~RazerLED()
 
 QDBusObjectPath RazerLED::getObjectPath()
 {
-    return QDBusObjectPath(QString("/io/github/openrazer1/devices/%1/led/%2").arg(device->getSerial()).arg(static_cast<uchar>(ledId)));
+    return QDBusObjectPath(QString("%1/led/%2").arg(device->getObjectPath().path()).arg(static_cast<uchar>(ledId)));
 }
 
 uchar RazerLED::getBrightness()
@@ -54,6 +54,62 @@ razer_test::RazerLedId RazerLED::getLedId()
     return ledId;
 }
 
+RazerLED::State RazerLED::saveState()
+{
+    return {effect, color1, color2, color3, brightness, direction, speed};
+}
+
+void RazerLED::restoreState(const State &state)
+{
+    effect = state.effect;
+    color1 = state.color1;
+    color2 = state.color2;
+    color3 = state.color3;
+    brightness = state.brightness;
+    direction = state.direction;
+    speed = state.speed;
+}
+
+bool RazerLED::applyState(const State &state)
+{
+    bool ok;
+    switch (state.effect) {
+    case RazerEffect::Off:
+        ok = setNone();
+        break;
+    case RazerEffect::Static:
+        ok = setStatic(state.color1);
+        break;
+    case RazerEffect::Breathing:
+        ok = setBreathing(state.color1);
+        break;
+    case RazerEffect::BreathingDual:
+        ok = setBreathingDual(state.color1, state.color2);
+        break;
+    case RazerEffect::BreathingRandom:
+        ok = setBreathingRandom();
+        break;
+    case RazerEffect::Blinking:
+        ok = setBlinking(state.color1);
+        break;
+    case RazerEffect::Spectrum:
+        ok = setSpectrum();
+        break;
+    case RazerEffect::Wave:
+        ok = setWave(state.direction);
+        break;
+    case RazerEffect::Reactive:
+        ok = setReactive(state.speed, state.color1);
+        break;
+    default:
+        ok = false;
+        break;
+    }
+    if (state.brightness != brightness && device->hasFx("brightness"))
+        ok = setBrightness(state.brightness) && ok;
+    return ok;
+}
+
 bool RazerLED::checkFx(QString fxStr)
 {
     if (!device->hasFx(fxStr)) {
@@ -76,4 +132,17 @@ void RazerLED::saveFxAndColors(RazerEffect fx, int numColors, RGB color1, RGB co
     if (numColors >= 3) {
         this->color3 = color3;
     }
+    notifyPropertyChanged("CurrentEffect", QVariant::fromValue(effect));
+    notifyPropertyChanged("CurrentColors", QVariant::fromValue(getCurrentColors()));
+}
+
+void RazerLED::saveBrightness(uchar brightness)
+{
+    this->brightness = brightness;
+    notifyPropertyChanged("Brightness", QVariant::fromValue(brightness));
+}
+
+void RazerLED::notifyPropertyChanged(const QString &name, const QVariant &value)
+{
+    device->notifyPropertyChanged({getObjectPath(), "io.github.openrazer1.Led", name, value});
 }
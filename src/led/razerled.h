@@ -26,6 +26,7 @@
 
 #include "../razer_test.h"
 #include "../razer_test_private.h"
+#include "../dbus/dbuscallcontext.h"
 
 using namespace razer_test;
 
@@ -36,13 +37,14 @@ class RazerDevice;
 /**
  * @todo write docs
  */
-class RazerLED : public QObject, protected QDBusContext
+class RazerLED : public QObject, protected QDBusContext, protected DBusCallContext
 {
     Q_OBJECT
     Q_CLASSINFO("D-Bus Interface", "io.github.openrazer1.Led")
     Q_PROPERTY(QList<RGB> CurrentColors READ getCurrentColors)
     Q_PROPERTY(RazerEffect CurrentEffect READ getCurrentEffect)
     Q_PROPERTY(RazerLedId LedId READ getLedId)
+    Q_PROPERTY(uchar Brightness READ getBrightness)
 
 public:
     RazerLED(RazerDevice *device, RazerLedId ledId);
@@ -57,6 +59,21 @@ public:
     QList<RGB> getCurrentColors();
     RazerLedId getLedId();
 
+    // What the LED was last set to, reported on D-Bus
+    struct State {
+        RazerEffect effect;
+        RGB color1;
+        RGB color2;
+        RGB color3;
+        uchar brightness;
+        WaveDirection direction;
+        ReactiveSpeed speed;
+    };
+    State saveState();
+    virtual void restoreState(const State &state);
+    // Sends the state to the LED again with the setters, unlike restoreState()
+    bool applyState(const State &state);
+
     RazerDevice *device;
     const RazerLedId ledId;
     uchar brightness;
@@ -77,13 +94,25 @@ public Q_SLOTS:
     uchar getBrightness();
 
 protected:
+    // Calls come from the adaptor (QDBusContext) or from RazerLEDDispatcher
+    using DBusCallContext::calledFromDBus;
+    using DBusCallContext::connection;
+    using DBusCallContext::message;
+    using DBusCallContext::sendErrorReply;
+    friend class RazerLEDDispatcher;
+
     bool checkFx(QString fxStr);
     void saveFxAndColors(RazerEffect fx, int numColors, RGB color1 = {0, 0, 0}, RGB color2 = {0, 0, 0}, RGB color3 = {0, 0, 0});
+    void saveBrightness(uchar brightness);
+    void notifyPropertyChanged(const QString &name, const QVariant &value);
 
     RazerEffect effect = RazerEffect::Spectrum;
     RGB color1 = {0, 255, 0};
     RGB color2 = {255, 0, 0};
     RGB color3 = {0, 0, 255};
+    // Only known once set, the device can't be asked for them
+    WaveDirection direction = WaveDirection::LEFT_TO_RIGHT;
+    ReactiveSpeed speed = ReactiveSpeed::_500MS;
 };
 
 #include "../device/razerdevice.h"
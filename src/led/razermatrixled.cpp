@@ -18,6 +18,17 @@
 
 #include "razermatrixled.h"
 
+// State of the software model of the effect, with the colors before color correction
+static HardwareEffectModel::State modelState(RazerEffect effect, RGB color1 = {0, 0, 0}, RGB color2 = {0, 0, 0}, WaveDirection direction = WaveDirection::LEFT_TO_RIGHT)
+{
+    HardwareEffectModel::State state;
+    state.effect = effect;
+    state.color1 = {color1.r, color1.g, color1.b};
+    state.color2 = {color2.r, color2.g, color2.b};
+    state.direction = direction;
+    return state;
+}
+
 bool RazerMatrixLED::initialize()
 {
     bool ok;
@@ -43,7 +54,9 @@ bool RazerMatrixLED::setNone()
     if (device->hasQuirk(RazerDeviceQuirks::MouseMatrix)) {
         return setMouseMatrixEffect(RazerMouseMatrixEffectId::Off);
     } else {
-        return setMatrixEffect(RazerMatrixEffectId::Off);
+        return device->applyHardwareEffect(modelState(RazerEffect::Off), [=] {
+            return setMatrixEffect(RazerMatrixEffectId::Off);
+        });
     }
 }
 
@@ -53,10 +66,14 @@ bool RazerMatrixLED::setStatic(RGB color)
     if (!checkFx("static"))
         return false;
     saveFxAndColors(RazerEffect::Static, 1, color);
+    RGB uncorrected = color;
+    color = device->correctColor(color);
     if (device->hasQuirk(RazerDeviceQuirks::MouseMatrix)) {
         return setMouseMatrixEffect(RazerMouseMatrixEffectId::Static, 0x00, 0x00, 0x01, color.r, color.g, color.b);
     } else {
-        return setMatrixEffect(RazerMatrixEffectId::Static, color.r, color.g, color.b);
+        return device->applyHardwareEffect(modelState(RazerEffect::Static, uncorrected), [=] {
+            return setMatrixEffect(RazerMatrixEffectId::Static, color.r, color.g, color.b);
+        });
     }
 }
 
@@ -66,10 +83,14 @@ bool RazerMatrixLED::setBreathing(RGB color)
     if (!checkFx("breathing"))
         return false;
     saveFxAndColors(RazerEffect::Breathing, 1, color);
+    RGB uncorrected = color;
+    color = device->correctColor(color);
     if (device->hasQuirk(RazerDeviceQuirks::MouseMatrix)) {
         return setMouseMatrixEffect(RazerMouseMatrixEffectId::Breathing, 0x01, 0x00, 0x01, color.r, color.g, color.b);
     } else {
-        return setMatrixEffect(RazerMatrixEffectId::Breathing, 0x01, color.r, color.g, color.b);
+        return device->applyHardwareEffect(modelState(RazerEffect::Breathing, uncorrected), [=] {
+            return setMatrixEffect(RazerMatrixEffectId::Breathing, 0x01, color.r, color.g, color.b);
+        });
     }
 }
 
@@ -79,10 +100,15 @@ bool RazerMatrixLED::setBreathingDual(RGB color, RGB color2)
     if (!checkFx("breathing_dual"))
         return false;
     saveFxAndColors(RazerEffect::BreathingDual, 2, color, color2);
+    RGB uncorrected = color, uncorrected2 = color2;
+    color = device->correctColor(color);
+    color2 = device->correctColor(color2);
     if (device->hasQuirk(RazerDeviceQuirks::MouseMatrix)) {
         return setMouseMatrixEffect(RazerMouseMatrixEffectId::Breathing, 0x02, 0x00, 0x02, color.r, color.g, color.b, color2.r, color2.g, color2.b);
     } else {
-        return setMatrixEffect(RazerMatrixEffectId::Breathing, 0x02, color.r, color.g, color.b, color2.r, color2.g, color2.b);
+        return device->applyHardwareEffect(modelState(RazerEffect::BreathingDual, uncorrected, uncorrected2), [=] {
+            return setMatrixEffect(RazerMatrixEffectId::Breathing, 0x02, color.r, color.g, color.b, color2.r, color2.g, color2.b);
+        });
     }
 }
 
@@ -95,7 +121,9 @@ bool RazerMatrixLED::setBreathingRandom()
     if (device->hasQuirk(RazerDeviceQuirks::MouseMatrix)) {
         return setMouseMatrixEffect(RazerMouseMatrixEffectId::Breathing);
     } else {
-        return setMatrixEffect(RazerMatrixEffectId::Breathing, 0x03);
+        return device->applyHardwareEffect(modelState(RazerEffect::BreathingRandom), [=] {
+            return setMatrixEffect(RazerMatrixEffectId::Breathing, 0x03);
+        });
     }
 }
 
@@ -119,7 +147,9 @@ bool RazerMatrixLED::setSpectrum()
     if (device->hasQuirk(RazerDeviceQuirks::MouseMatrix)) {
         return setMouseMatrixEffect(RazerMouseMatrixEffectId::Spectrum);
     } else {
-        return setMatrixEffect(RazerMatrixEffectId::Spectrum);
+        return device->applyHardwareEffect(modelState(RazerEffect::Spectrum), [=] {
+            return setMatrixEffect(RazerMatrixEffectId::Spectrum);
+        });
     }
 }
 
@@ -128,12 +158,15 @@ bool RazerMatrixLED::setWave(WaveDirection direction)
     qDebug("Called %s with params %hhu", Q_FUNC_INFO, static_cast<uchar>(direction));
     if (!checkFx("wave"))
         return false;
+    this->direction = direction;
     saveFxAndColors(RazerEffect::Wave, 0);
     if (device->hasQuirk(RazerDeviceQuirks::MouseMatrix)) {
         // Wave direction is 0x00 / 0x01 instead of 0x01 / 0x02 for mouse_matrix, so subtract one
         return setMouseMatrixEffect(RazerMouseMatrixEffectId::Wave, static_cast<uchar>(direction) - 0x01, 0x28);
     } else {
-        return setMatrixEffect(RazerMatrixEffectId::Wave, static_cast<uchar>(direction));
+        return device->applyHardwareEffect(modelState(RazerEffect::Wave, {0, 0, 0}, {0, 0, 0}, direction), [=] {
+            return setMatrixEffect(RazerMatrixEffectId::Wave, static_cast<uchar>(direction));
+        });
     }
 }
 
@@ -142,11 +175,16 @@ bool RazerMatrixLED::setReactive(ReactiveSpeed speed, RGB color)
     qDebug("Called %s with params %hhu, %i, %i, %i", Q_FUNC_INFO, static_cast<uchar>(speed), color.r, color.g, color.b);
     if (!checkFx("reactive"))
         return false;
+    this->speed = speed;
     saveFxAndColors(RazerEffect::Reactive, 1, color);
+    RGB uncorrected = color;
+    color = device->correctColor(color);
     if (device->hasQuirk(RazerDeviceQuirks::MouseMatrix)) {
         return setMouseMatrixEffect(RazerMouseMatrixEffectId::Reactive, 0x00, static_cast<uchar>(speed), 0x01, color.r, color.g, color.b);
     } else {
-        return setMatrixEffect(RazerMatrixEffectId::Reactive, static_cast<uchar>(speed), color.r, color.g, color.b);
+        return device->applyHardwareEffect(modelState(RazerEffect::Reactive, uncorrected), [=] {
+            return setMatrixEffect(RazerMatrixEffectId::Reactive, static_cast<uchar>(speed), color.r, color.g, color.b);
+        });
     }
 }
 
@@ -155,21 +193,21 @@ bool RazerMatrixLED::setBrightness(uchar brightness)
     qDebug("Called %s with params %i", Q_FUNC_INFO, brightness);
     if (!checkFx("brightness"))
         return false;
-    razer_report report, response_report;
-
-    if (device->hasQuirk(RazerDeviceQuirks::MatrixBrightness)) {
-        report = razer_chroma_extended_matrix_set_brightness(RazerVarstore::STORE, this->ledId, brightness);
-    } else {
-        report = razer_chroma_standard_set_led_brightness(RazerVarstore::STORE, this->ledId, brightness);
-    }
-    if (device->sendReport(report, &response_report) != 0) {
+    RazerLedId ledId = this->ledId;
+    bool extended = device->hasQuirk(RazerDeviceQuirks::MatrixBrightness);
+    bool ok = device->sendSetting(QString("brightness/%1").arg(static_cast<uchar>(ledId)), [=](RazerVarstore varstore) {
+        if (extended)
+            return razer_chroma_extended_matrix_set_brightness(varstore, ledId, brightness);
+        return razer_chroma_standard_set_led_brightness(varstore, ledId, brightness);
+    });
+    if (!ok) {
         if (calledFromDBus())
             sendErrorReply(QDBusError::Failed);
         return false;
     }
 
     // Save state into LED variable
-    this->brightness = brightness;
+    saveBrightness(brightness);
 
     return true;
 }
@@ -224,23 +262,33 @@ bool RazerMatrixLED::setMatrixEffect(RazerMatrixEffectId effect, uchar arg1, uch
 
 bool RazerMatrixLED::setMouseMatrixEffect(RazerMouseMatrixEffectId effect, uchar arg3, uchar arg4, uchar arg5, uchar arg6, uchar arg7, uchar arg8, uchar arg9, uchar arg10, uchar arg11)
 {
-    razer_report report, response_report;
-
     // Custom Frame uses 0x00 LED ID
     RazerLedId ledId = effect == RazerMouseMatrixEffectId::CustomFrame ? RazerLedId::Unspecified : this->ledId;
 
-    report = razer_chroma_extended_mouse_matrix_effect(RazerVarstore::STORE, ledId, effect);
-    report.arguments[3] = arg3;
-    report.arguments[4] = arg4;
-    report.arguments[5] = arg5;
-    report.arguments[6] = arg6;
-    report.arguments[7] = arg7;
-    report.arguments[8] = arg8;
-    report.arguments[9] = arg9;
-    report.arguments[10] = arg10;
-    report.arguments[11] = arg11;
+    auto buildReport = [=](RazerVarstore varstore) {
+        razer_report report = razer_chroma_extended_mouse_matrix_effect(varstore, ledId, effect);
+        report.arguments[3] = arg3;
+        report.arguments[4] = arg4;
+        report.arguments[5] = arg5;
+        report.arguments[6] = arg6;
+        report.arguments[7] = arg7;
+        report.arguments[8] = arg8;
+        report.arguments[9] = arg9;
+        report.arguments[10] = arg10;
+        report.arguments[11] = arg11;
+        return report;
+    };
 
-    if (device->sendReport(report, &response_report) != 0) {
+    bool ok;
+    if (effect == RazerMouseMatrixEffectId::CustomFrame) {
+        // Storing an effect later would also show it again and replace the custom frame
+        device->discardPendingSettings("effect/");
+        razer_report response_report;
+        ok = device->sendReport(buildReport(RazerVarstore::STORE), &response_report) == 0;
+    } else {
+        ok = device->sendSetting(QString("effect/%1").arg(static_cast<uchar>(ledId)), buildReport);
+    }
+    if (!ok) {
         if (calledFromDBus())
             sendErrorReply(QDBusError::Failed);
         return false;
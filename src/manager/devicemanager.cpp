@@ -16,13 +16,81 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <QMetaMethod>
+#include <QRunnable>
+#include <QThreadPool>
+
 #include "devicemanager.h"
 #include "config.h"
 
+// Methods that can be part of a scene, all of them only send reports and update the cached state
+static const QStringList sceneMethods {
+    "setNone", "setStatic", "setBreathing", "setBreathingDual", "setBreathingRandom", "setBlinking",
+    "setSpectrum", "setWave", "setReactive", "setBrightness", "setDPI", "setPollRate"
+};
+
+// Sends the recorded reports of the devices on one bus, in parallel to the other buses
+class ReportReplay : public QRunnable
+{
+public:
+    struct Device {
+        RazerDevice *device;
+        QVector<razer_report> reports;
+        int sent;
+        bool failed;
+    };
+
+    ReportReplay()
+    {
+        setAutoDelete(false);
+    }
+
+    void add(RazerDevice *device, const QVector<razer_report> &reports)
+    {
+        // Input-critical devices go first in every turn
+        if (device->isInputCritical())
+            devices.prepend({device, reports, 0, false});
+        else
+            devices.append({device, reports, 0, false});
+    }
+
+    void run() override
+    {
+        // The devices take turns with one report each instead of one device hogging the bus
+        bool pending = true;
+        while (pending) {
+            pending = false;
+            for (Device &device : devices) {
+                if (device.failed || device.sent == device.reports.size())
+                    continue;
+                if (device.device->sendPreparedReports(device.reports.mid(device.sent, 1)) == 1)
+                    device.sent++;
+                else
+                    device.failed = true;
+                pending = true;
+            }
+        }
+    }
+
+    QVector<Device> devices;
+};
+
 DeviceManager::DeviceManager(QVector<RazerDevice *> rDevices)
 {
+    this->rDevices = rDevices;
     foreach (RazerDevice *rDevice, rDevices) {
+        UsbLocation location = rDevice->usbLocation();
+        if (location.isValid()) {
+            qDebug("%s is on bus %i, port %s", qUtf8Printable(rDevice->getName()), location.bus, qUtf8Printable(location.ports));
+            if (!buses.contains(location.bus))
+                buses.insert(location.bus, new BusScheduler(this));
+            rDevice->setBusScheduler(buses.value(location.bus));
+        }
         devices.append(rDevice->getObjectPath());
+        objects.insert(rDevice->getObjectPath().path(), rDevice);
+        foreach (RazerLED *led, rDevice->getLeds()) {
+            objects.insert(led->getObjectPath().path(), led);
+        }
     }
 }
 
@@ -40,3 +108,283 @@ QDBusObjectPath DeviceManager::getObjectPath()
 {
     return QDBusObjectPath("/io/github/openrazer1");
 }
+
+void DeviceManager::setPeerServer(PeerServer *peerServer)
+{
+    this->peerServer = peerServer;
+}
+
+QString DeviceManager::getPeerAddress()
+{
+    qDebug("Called %s", Q_FUNC_INFO);
+    if (peerServer == nullptr || peerServer->address().isEmpty()) {
+        if (calledFromDBus())
+            sendErrorReply(QDBusError::NotSupported, "The peer-to-peer endpoint is not available.");
+        return QString();
+    }
+    return peerServer->address();
+}
+
+bool DeviceManager::defineScene(QString name, QList<RazerOperation> operations)
+{
+    qDebug("Called %s with params %s", Q_FUNC_INFO, qUtf8Printable(name));
+
+    // Compiling runs the setters, which also update the cached state of the LEDs
+    QHash<RazerLED *, RazerLED::State> previousStates;
+    foreach (const RazerOperation &operation, operations) {
+        auto *led = qobject_cast<RazerLED *>(objects.value(operation.object.path()));
+        if (led != nullptr && !previousStates.contains(led))
+            previousStates.insert(led, led->saveState());
+    }
+
+    foreach (RazerDevice *device, rDevices)
+        device->startCapture();
+    QString error;
+    bool ok = true;
+    foreach (const RazerOperation &operation, operations) {
+        if (!invokeOperation(operation, &error)) {
+            ok = false;
+            break;
+        }
+    }
+
+    Scene scene;
+    foreach (RazerDevice *device, rDevices) {
+        RecordedReports recorded = device->finishCapture();
+        if (!recorded.reports.isEmpty() || !recorded.commits.isEmpty() || !recorded.notifications.isEmpty())
+            scene.devices.insert(device, recorded);
+    }
+    for (auto it = previousStates.constBegin(); it != previousStates.constEnd(); ++it) {
+        scene.leds.insert(it.key(), it.key()->saveState());
+        it.key()->restoreState(it.value());
+    }
+
+    if (!ok) {
+        qWarning("Compiling scene %s failed: %s", qUtf8Printable(name), qUtf8Printable(error));
+        if (calledFromDBus())
+            sendErrorReply(QDBusError::InvalidArgs, error);
+        return false;
+    }
+    scenes.insert(name, scene);
+    return true;
+}
+
+bool DeviceManager::applyScene(QString name)
+{
+    qDebug("Called %s with params %s", Q_FUNC_INFO, qUtf8Printable(name));
+    if (!scenes.contains(name)) {
+        if (calledFromDBus())
+            sendErrorReply(QDBusError::InvalidArgs, "Unknown scene.");
+        return false;
+    }
+    const Scene scene = scenes.value(name);
+
+    QHash<RazerDevice *, QVector<razer_report>> reports;
+    for (auto it = scene.devices.constBegin(); it != scene.devices.constEnd(); ++it)
+        reports.insert(it.key(), it.value().reports);
+    QHash<RazerDevice *, int> sent = replayReports(reports);
+
+    QVector<RazerDevice *> failed;
+    for (auto it = scene.devices.constBegin(); it != scene.devices.constEnd(); ++it) {
+        if (sent.value(it.key()) == it.value().reports.size()) {
+            it.key()->queueCommits(it.value().commits);
+            it.key()->notifyPropertiesChanged(it.value().notifications);
+        } else {
+            qWarning("Applying scene %s to device %s failed.", qUtf8Printable(name), qUtf8Printable(it.key()->getName()));
+            failed.append(it.key());
+        }
+    }
+    for (auto it = scene.leds.constBegin(); it != scene.leds.constEnd(); ++it) {
+        if (!failed.contains(it.key()->device))
+            it.key()->restoreState(it.value());
+    }
+
+    if (!failed.isEmpty()) {
+        if (calledFromDBus())
+            sendErrorReply(QDBusError::Failed, "The scene could not be applied to all devices.");
+        return false;
+    }
+    return true;
+}
+
+bool DeviceManager::removeScene(QString name)
+{
+    qDebug("Called %s with params %s", Q_FUNC_INFO, qUtf8Printable(name));
+    if (scenes.remove(name) == 0) {
+        if (calledFromDBus())
+            sendErrorReply(QDBusError::InvalidArgs, "Unknown scene.");
+        return false;
+    }
+    return true;
+}
+
+QList<RazerOperationResult> DeviceManager::applyBatch(QList<RazerOperation> operations)
+{
+    qDebug("Called %s", Q_FUNC_INFO);
+
+    QHash<RazerLED *, RazerLED::State> previousStates;
+    foreach (const RazerOperation &operation, operations) {
+        auto *led = qobject_cast<RazerLED *>(objects.value(operation.object.path()));
+        if (led != nullptr && !previousStates.contains(led))
+            previousStates.insert(led, led->saveState());
+    }
+
+    // Record the reports of every operation, remembering which of them belong to which operation
+    QList<RazerOperationResult> results;
+    QVector<RazerDevice *> operationDevices;
+    QVector<int> operationEnds;
+    foreach (RazerDevice *device, rDevices)
+        device->startCapture();
+    foreach (const RazerOperation &operation, operations) {
+        RazerDevice *device = deviceOf(objects.value(operation.object.path()));
+        QString error;
+        bool ok = invokeOperation(operation, &error);
+        results.append({ok, error});
+        operationDevices.append(device);
+        operationEnds.append(device != nullptr ? device->capturedReportCount() : 0);
+    }
+    QHash<RazerDevice *, RecordedReports> recorded;
+    QHash<RazerDevice *, QVector<razer_report>> reports;
+    foreach (RazerDevice *device, rDevices) {
+        RecordedReports deviceRecorded = device->finishCapture();
+        recorded.insert(device, deviceRecorded);
+        if (!deviceRecorded.reports.isEmpty())
+            reports.insert(device, deviceRecorded.reports);
+    }
+
+    QHash<RazerDevice *, int> sent = replayReports(reports);
+
+    QVector<RazerDevice *> failed;
+    for (int i = 0; i < results.size(); i++) {
+        RazerDevice *device = operationDevices.at(i);
+        if (results.at(i).success && device != nullptr && operationEnds.at(i) > sent.value(device)) {
+            results[i] = {false, "Sending the reports to the device failed."};
+            if (!failed.contains(device))
+                failed.append(device);
+        }
+    }
+    foreach (RazerDevice *device, rDevices) {
+        if (!failed.contains(device)) {
+            device->queueCommits(recorded.value(device).commits);
+            device->notifyPropertiesChanged(recorded.value(device).notifications);
+        }
+    }
+    // The cached state already changed while recording, undo it where the device didn't get the reports
+    for (auto it = previousStates.constBegin(); it != previousStates.constEnd(); ++it) {
+        if (failed.contains(it.key()->device))
+            it.key()->restoreState(it.value());
+    }
+    return results;
+}
+
+RazerDevice *DeviceManager::deviceOf(QObject *object)
+{
+    if (auto *led = qobject_cast<RazerLED *>(object))
+        return led->device;
+    return qobject_cast<RazerDevice *>(object);
+}
+
+QHash<RazerDevice *, int> DeviceManager::replayReports(const QHash<RazerDevice *, QVector<razer_report>> &reports)
+{
+    // Buses are independent, so every bus gets its own thread, and so does every device that isn't on
+    // a known bus. The event loop is blocked until all of them are done, so nothing else sends to the
+    // devices in the meantime.
+    QHash<int, ReportReplay *> busReplays;
+    QVector<ReportReplay *> replays;
+    for (auto it = reports.constBegin(); it != reports.constEnd(); ++it) {
+        int bus = it.key()->usbLocation().bus;
+        ReportReplay *replay = busReplays.value(bus);
+        if (replay == nullptr) {
+            replay = new ReportReplay;
+            replays.append(replay);
+            if (bus >= 0)
+                busReplays.insert(bus, replay);
+        }
+        replay->add(it.key(), it.value());
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(replays.size(), 1));
+    foreach (ReportReplay *replay, replays)
+        pool.start(replay);
+    pool.waitForDone();
+
+    QHash<RazerDevice *, int> sent;
+    foreach (ReportReplay *replay, replays) {
+        foreach (const ReportReplay::Device &device, replay->devices)
+            sent.insert(device.device, device.sent);
+        delete replay;
+    }
+    return sent;
+}
+
+QVariantMap DeviceManager::getBusUtilization()
+{
+    qDebug("Called %s", Q_FUNC_INFO);
+    QVariantMap utilization;
+    for (auto it = buses.constBegin(); it != buses.constEnd(); ++it)
+        utilization.insert(QString("usb%1").arg(it.key()), it.value()->utilization());
+    return utilization;
+}
+
+bool DeviceManager::invokeOperation(const RazerOperation &operation, QString *error)
+{
+    QObject *object = objects.value(operation.object.path());
+    if (object == nullptr) {
+        *error = QString("Unknown object %1.").arg(operation.object.path());
+        return false;
+    }
+    if (!sceneMethods.contains(operation.method)) {
+        *error = QString("%1 can't be used in a scene.").arg(operation.method);
+        return false;
+    }
+
+    const QMetaObject *metaObject = object->metaObject();
+    QMetaMethod method;
+    for (int i = 0; i < metaObject->methodCount(); i++) {
+        QMetaMethod candidate = metaObject->method(i);
+        if (candidate.name() == operation.method.toLatin1() && candidate.returnType() == QMetaType::Bool
+                && candidate.parameterCount() == operation.arguments.size()) {
+            method = candidate;
+            break;
+        }
+    }
+    if (!method.isValid()) {
+        *error = QString("No method %1 with %2 arguments on %3.").arg(operation.method).arg(operation.arguments.size()).arg(operation.object.path());
+        return false;
+    }
+
+    // Structs like RGB arrive as QDBusArgument, everything else as plain values
+    QVector<QVariant> arguments;
+    for (int i = 0; i < method.parameterCount(); i++) {
+        QVariant argument = operation.arguments.at(i);
+        int type = method.parameterType(i);
+        if (argument.userType() == qMetaTypeId<QDBusArgument>()) {
+            QVariant converted(type, nullptr);
+            if (!QDBusMetaType::demarshall(argument.value<QDBusArgument>(), type, converted.data())) {
+                *error = QString("Argument %1 of %2 has the wrong type.").arg(i).arg(operation.method);
+                return false;
+            }
+            argument = converted;
+        } else if (!argument.convert(type)) {
+            *error = QString("Argument %1 of %2 has the wrong type.").arg(i).arg(operation.method);
+            return false;
+        }
+        arguments.append(argument);
+    }
+
+    QList<QByteArray> typeNames = method.parameterTypes();
+    QGenericArgument genericArguments[10];
+    for (int i = 0; i < arguments.size(); i++)
+        genericArguments[i] = QGenericArgument(typeNames.at(i).constData(), arguments.at(i).constData());
+
+    bool result = false;
+    if (!method.invoke(object, Qt::DirectConnection, Q_RETURN_ARG(bool, result),
+                       genericArguments[0], genericArguments[1], genericArguments[2], genericArguments[3], genericArguments[4],
+                       genericArguments[5], genericArguments[6], genericArguments[7], genericArguments[8], genericArguments[9])
+            || !result) {
+        *error = QString("%1 on %2 failed.").arg(operation.method).arg(operation.object.path());
+        return false;
+    }
+    return true;
+}
@@ -21,14 +21,18 @@
 
 #include <QObject>
 #include <QVector>
+#include <QHash>
+#include <QDBusContext>
 #include <QDBusObjectPath>
+#include <QVariantMap>
 
+#include "../dbus/peerserver.h"
 #include "../device/razerdevice.h"
 
 /**
  * @todo write docs
  */
-class DeviceManager : public QObject
+class DeviceManager : public QObject, protected QDBusContext
 {
     Q_OBJECT
     Q_CLASSINFO("D-Bus Interface", "io.github.openrazer1.Manager")
@@ -41,9 +45,42 @@ public:
     QString getVersion();
     QList<QDBusObjectPath> getDevices();
     QDBusObjectPath getObjectPath();
+    void setPeerServer(PeerServer *peerServer);
+
+public Q_SLOTS:
+    // Address to pass to QDBusConnection::connectToPeer(), to use the same objects without the bus daemon
+    QString getPeerAddress();
+
+    // Scenes are compiled once into the reports they send, applying them only replays the reports
+    bool defineScene(QString name, QList<RazerOperation> operations);
+    bool applyScene(QString name);
+    bool removeScene(QString name);
+
+    // Runs the operations like a scene that is applied once, with one result per operation
+    QList<RazerOperationResult> applyBatch(QList<RazerOperation> operations);
+
+    // Fraction of the last second each USB bus with devices was busy with reports, by bus, e.g. "usb1"
+    QVariantMap getBusUtilization();
 
 private:
+    struct Scene {
+        QHash<RazerDevice *, RecordedReports> devices;
+        QHash<RazerLED *, RazerLED::State> leds;
+    };
+
+    bool invokeOperation(const RazerOperation &operation, QString *error);
+    RazerDevice *deviceOf(QObject *object);
+    // Sends the reports of all buses in parallel, returns how many reports of each device were sent
+    QHash<RazerDevice *, int> replayReports(const QHash<RazerDevice *, QVector<razer_report>> &reports);
+
     QVector<QDBusObjectPath> devices;
+    QVector<RazerDevice *> rDevices;
+    // Devices and LEDs by object path
+    QHash<QString, QObject *> objects;
+    QHash<QString, Scene> scenes;
+    PeerServer *peerServer = nullptr;
+    // Shared by the devices on the same USB bus
+    QHash<int, BusScheduler *> buses;
 };
 
 #endif // DEVICEMANAGER_H
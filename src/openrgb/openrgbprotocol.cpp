@@ -0,0 +1,145 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QDataStream>
+#include <QtEndian>
+
+#include "openrgbprotocol.h"
+
+namespace OpenRgb {
+
+// Strings are sent with their length including the terminating null
+static void writeString(QDataStream &stream, const QString &string)
+{
+    QByteArray bytes = string.toUtf8();
+    stream << static_cast<quint16>(bytes.size() + 1);
+    stream.writeRawData(bytes.constData(), bytes.size() + 1);
+}
+
+static void writeColors(QDataStream &stream, const QVector<quint32> &colors)
+{
+    stream << static_cast<quint16>(colors.size());
+    foreach (quint32 color, colors)
+        stream << color;
+}
+
+QByteArray packet(quint32 deviceIndex, quint32 packetId, const QByteArray &data)
+{
+    QByteArray result;
+    QDataStream stream(&result, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.writeRawData("ORGB", 4);
+    stream << deviceIndex << packetId << static_cast<quint32>(data.size());
+    stream.writeRawData(data.constData(), data.size());
+    return result;
+}
+
+bool parseHeader(const QByteArray &data, quint32 *deviceIndex, quint32 *packetId, quint32 *size)
+{
+    if (data.size() < headerSize || !data.startsWith("ORGB"))
+        return false;
+    QDataStream stream(data.mid(4, headerSize - 4));
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream >> *deviceIndex >> *packetId >> *size;
+    return stream.status() == QDataStream::Ok;
+}
+
+QByteArray controllerData(const Controller &controller)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    // Filled in at the end
+    stream << static_cast<quint32>(0);
+    stream << static_cast<qint32>(controller.type);
+    writeString(stream, controller.name);
+    writeString(stream, controller.description);
+    writeString(stream, controller.version);
+    writeString(stream, controller.serial);
+    writeString(stream, controller.location);
+
+    stream << static_cast<quint16>(controller.modes.size());
+    stream << controller.activeMode;
+    foreach (const Mode &mode, controller.modes) {
+        writeString(stream, mode.name);
+        stream << mode.value << mode.flags << mode.speedMin << mode.speedMax << mode.colorsMin << mode.colorsMax
+               << mode.speed << mode.direction << mode.colorMode;
+        writeColors(stream, mode.colors);
+    }
+
+    quint32 ledCount = controller.width * controller.height;
+    stream << static_cast<quint16>(1);
+    writeString(stream, controller.zoneName);
+    stream << static_cast<qint32>(controller.height > 1 ? Matrix : (ledCount > 1 ? Linear : Single));
+    stream << ledCount << ledCount << ledCount;
+    if (controller.height > 1) {
+        stream << static_cast<quint16>(8 + ledCount * 4);
+        stream << controller.height << controller.width;
+        for (quint32 i = 0; i < ledCount; i++)
+            stream << i;
+    } else {
+        stream << static_cast<quint16>(0);
+    }
+
+    stream << static_cast<quint16>(ledCount);
+    for (quint32 i = 0; i < ledCount; i++) {
+        writeString(stream, controller.height > 1 ? QString("LED %1,%2").arg(i / controller.width).arg(i % controller.width)
+                                                  : QString("LED %1").arg(i));
+        stream << i;
+    }
+    writeColors(stream, controller.colors);
+
+    qToLittleEndian(static_cast<quint32>(data.size()), reinterpret_cast<uchar *>(data.data()));
+    return data;
+}
+
+bool parseColors(const QByteArray &data, int *offset, QVector<quint32> *colors)
+{
+    QDataStream stream(data.mid(*offset));
+    stream.setByteOrder(QDataStream::LittleEndian);
+    quint16 count;
+    stream >> count;
+    colors->resize(count);
+    for (quint16 i = 0; i < count; i++)
+        stream >> (*colors)[i];
+    if (stream.status() != QDataStream::Ok)
+        return false;
+    *offset += 2 + count * 4;
+    return true;
+}
+
+bool parseMode(const QByteArray &data, int *offset, Mode *mode)
+{
+    QDataStream stream(data.mid(*offset));
+    stream.setByteOrder(QDataStream::LittleEndian);
+    quint16 nameLength;
+    stream >> nameLength;
+    QByteArray name(nameLength, Qt::Uninitialized);
+    if (stream.readRawData(name.data(), nameLength) != nameLength)
+        return false;
+    mode->name = QString::fromUtf8(name.constData());
+    stream >> mode->value >> mode->flags >> mode->speedMin >> mode->speedMax >> mode->colorsMin >> mode->colorsMax
+           >> mode->speed >> mode->direction >> mode->colorMode;
+    if (stream.status() != QDataStream::Ok)
+        return false;
+    *offset += 2 + nameLength + 9 * 4;
+    return parseColors(data, offset, &mode->colors);
+}
+
+}
@@ -0,0 +1,151 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENRGBPROTOCOL_H
+#define OPENRGBPROTOCOL_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+/**
+ * Messages of the OpenRGB SDK network protocol, version 0.
+ *
+ * Every packet starts with the magic "ORGB", the controller index, the packet id and
+ * the size of the data that follows, all little endian. Colors are 0x00BBGGRR.
+ */
+namespace OpenRgb {
+
+const quint32 protocolVersion = 0;
+const quint16 defaultPort = 6742;
+const int headerSize = 16;
+// Largest packet accepted from a client
+const quint32 maxPacketSize = 1024 * 1024;
+
+enum PacketId : quint32 {
+    RequestControllerCount = 0,
+    RequestControllerData = 1,
+    RequestProtocolVersion = 40,
+    SetClientName = 50,
+    DeviceListUpdated = 100,
+    ResizeZone = 1000,
+    UpdateLeds = 1050,
+    UpdateZoneLeds = 1051,
+    UpdateSingleLed = 1052,
+    SetCustomMode = 1100,
+    UpdateMode = 1101
+};
+
+enum ModeFlags : quint32 {
+    HasSpeed = 1 << 0,
+    HasDirectionLR = 1 << 1,
+    HasPerLedColor = 1 << 5,
+    HasModeSpecificColor = 1 << 6,
+    HasRandomColor = 1 << 7
+};
+
+enum ColorMode : quint32 {
+    NoColors = 0,
+    PerLed = 1,
+    ModeSpecific = 2,
+    Random = 3
+};
+
+enum Direction : quint32 {
+    Left = 0,
+    Right = 1
+};
+
+enum ZoneType : qint32 {
+    Single = 0,
+    Linear = 1,
+    Matrix = 2
+};
+
+enum DeviceType : qint32 {
+    Keyboard = 5,
+    Mouse = 6,
+    Mousemat = 7,
+    Headset = 8,
+    Unknown = 14
+};
+
+struct Mode {
+    QString name;
+    qint32 value = 0;
+    quint32 flags = 0;
+    quint32 speedMin = 0;
+    quint32 speedMax = 0;
+    quint32 colorsMin = 0;
+    quint32 colorsMax = 0;
+    quint32 speed = 0;
+    quint32 direction = 0;
+    quint32 colorMode = NoColors;
+    QVector<quint32> colors;
+};
+
+// One zone with width * height LEDs, a matrix if height > 1
+struct Controller {
+    DeviceType type = Unknown;
+    QString name;
+    QString description;
+    QString version;
+    QString serial;
+    QString location;
+    QVector<Mode> modes;
+    qint32 activeMode = 0;
+    QString zoneName;
+    quint32 width = 1;
+    quint32 height = 1;
+    // Current color of every LED, row by row
+    QVector<quint32> colors;
+};
+
+QByteArray packet(quint32 deviceIndex, quint32 packetId, const QByteArray &data);
+// Returns false if data doesn't start with a valid header
+bool parseHeader(const QByteArray &data, quint32 *deviceIndex, quint32 *packetId, quint32 *size);
+
+QByteArray controllerData(const Controller &controller);
+// Reads a quint16 count followed by the colors, offset is advanced past them
+bool parseColors(const QByteArray &data, int *offset, QVector<quint32> *colors);
+// Reads a mode as sent in UpdateMode, after the data size and mode index
+bool parseMode(const QByteArray &data, int *offset, Mode *mode);
+
+inline quint32 color(uchar red, uchar green, uchar blue)
+{
+    return red | (green << 8) | (blue << 16);
+}
+
+inline uchar red(quint32 color)
+{
+    return color & 0xFF;
+}
+
+inline uchar green(quint32 color)
+{
+    return (color >> 8) & 0xFF;
+}
+
+inline uchar blue(quint32 color)
+{
+    return (color >> 16) & 0xFF;
+}
+
+}
+
+#endif // OPENRGBPROTOCOL_H
@@ -0,0 +1,383 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QLocalSocket>
+#include <QTcpSocket>
+#include <QtEndian>
+
+#include "openrgbserver.h"
+
+using namespace OpenRgb;
+
+struct ModeDefinition {
+    const char *fx;
+    const char *name;
+    quint32 flags;
+    quint32 colors;
+    ColorMode colorMode;
+};
+
+// In the order they are offered to clients
+static const ModeDefinition modeDefinitions[] = {
+    {"custom_frame", "Direct", HasPerLedColor, 0, PerLed},
+    {"off", "Off", 0, 0, NoColors},
+    {"static", "Static", HasModeSpecificColor, 1, ModeSpecific},
+    {"breathing", "Breathing", HasModeSpecificColor, 1, ModeSpecific},
+    {"breathing_dual", "Breathing Dual", HasModeSpecificColor, 2, ModeSpecific},
+    {"breathing_random", "Breathing Random", HasRandomColor, 0, Random},
+    {"blinking", "Blinking", HasModeSpecificColor, 1, ModeSpecific},
+    {"spectrum", "Spectrum Cycle", 0, 0, NoColors},
+    {"wave", "Wave", HasDirectionLR, 0, NoColors},
+    {"reactive", "Reactive", HasSpeed | HasModeSpecificColor, 1, ModeSpecific},
+};
+
+// fx of every RazerEffect, in the order of the enum
+static const char *const effectFx[] = {
+    "off", "static", "breathing", "breathing_dual", "breathing_random", "blinking", "spectrum", "wave", "reactive"
+};
+
+static RGB toRgb(quint32 color)
+{
+    return {red(color), green(color), blue(color)};
+}
+
+OpenRgbServer::OpenRgbServer(QVector<RazerDevice *> devices, QObject *parent)
+    : QObject(parent)
+    , devices(devices)
+{
+    foreach (RazerDevice *device, devices) {
+        DeviceState state;
+        for (const ModeDefinition &definition : modeDefinitions) {
+            if (!device->hasFx(definition.fx))
+                continue;
+            Mode mode;
+            mode.name = definition.name;
+            mode.value = state.modes.size();
+            mode.flags = definition.flags;
+            mode.colorsMin = definition.colors;
+            mode.colorsMax = definition.colors;
+            mode.colorMode = definition.colorMode;
+            mode.colors.fill(color(0xFF, 0xFF, 0xFF), static_cast<int>(definition.colors));
+            if (mode.flags & HasDirectionLR)
+                mode.direction = Right;
+            if (mode.flags & HasSpeed) {
+                mode.speedMin = static_cast<quint32>(ReactiveSpeed::_500MS);
+                mode.speedMax = static_cast<quint32>(ReactiveSpeed::_2000MS);
+                mode.speed = mode.speedMin;
+            }
+            state.modes.append(mode);
+            state.modeFx.append(definition.fx);
+        }
+
+        // The current effect of the first LED, with several LEDs there is no better guess
+        QList<RazerLED *> leds = device->getLeds().values();
+        if (!leds.isEmpty()) {
+            int effect = static_cast<int>(leds.first()->getCurrentEffect());
+            state.activeMode = qMax(state.modeFx.indexOf(effectFx[effect]), 0);
+        }
+
+        if (device->hasFx("custom_frame")) {
+            state.width = device->frameWidth();
+            state.height = device->frameHeight();
+        }
+        state.colors.fill(0, static_cast<int>(state.width * state.height));
+        states.append(state);
+    }
+}
+
+bool OpenRgbServer::listen(const QString &address)
+{
+    bool isPort;
+    quint16 port = address.toUShort(&isPort);
+    bool ok;
+    if (isPort) {
+        tcpServer = new QTcpServer(this);
+        connect(tcpServer, &QTcpServer::newConnection, this, &OpenRgbServer::newConnection);
+        // Only local clients, like the bus
+        ok = tcpServer->listen(QHostAddress::LocalHost, port);
+        if (!ok)
+            qWarning("Failed to listen for OpenRGB clients on port %u: %s", port, qUtf8Printable(tcpServer->errorString()));
+    } else {
+        localServer = new QLocalServer(this);
+        localServer->setSocketOptions(QLocalServer::WorldAccessOption);
+        connect(localServer, &QLocalServer::newConnection, this, &OpenRgbServer::newConnection);
+        QLocalServer::removeServer(address);
+        ok = localServer->listen(address);
+        if (!ok)
+            qWarning("Failed to listen for OpenRGB clients on \"%s\": %s", qUtf8Printable(address), qUtf8Printable(localServer->errorString()));
+    }
+    if (ok)
+        qInfo("Listening for OpenRGB clients on %s.", qUtf8Printable(address));
+    return ok;
+}
+
+void OpenRgbServer::newConnection()
+{
+    forever {
+        QIODevice *socket = nullptr;
+        if (sender() == tcpServer)
+            socket = tcpServer->nextPendingConnection();
+        else
+            socket = localServer->nextPendingConnection();
+        if (socket == nullptr)
+            return;
+        Client client;
+        // OpenRGB has no leases, its clients only control the devices nobody holds a lease on
+        client.id = QString("openrgb:%1").arg(nextClientId++);
+        clients.insert(socket, client);
+        connect(socket, &QIODevice::readyRead, this, &OpenRgbServer::readClient);
+        if (auto *tcpSocket = qobject_cast<QTcpSocket *>(socket))
+            connect(tcpSocket, &QTcpSocket::disconnected, this, &OpenRgbServer::removeClient);
+        else
+            connect(static_cast<QLocalSocket *>(socket), &QLocalSocket::disconnected, this, &OpenRgbServer::removeClient);
+    }
+}
+
+void OpenRgbServer::readClient()
+{
+    auto *socket = qobject_cast<QIODevice *>(sender());
+    if (socket == nullptr || !clients.contains(socket))
+        return;
+    Client &client = clients[socket];
+    QByteArray &buffer = client.buffer;
+    buffer.append(socket->readAll());
+
+    quint32 deviceIndex, packetId, size;
+    while (buffer.size() >= headerSize) {
+        if (!parseHeader(buffer, &deviceIndex, &packetId, &size) || size > maxPacketSize) {
+            qWarning("Invalid packet from an OpenRGB client, disconnecting.");
+            clients.remove(socket);
+            socket->close();
+            return;
+        }
+        if (static_cast<quint32>(buffer.size()) < headerSize + size)
+            return;
+        QByteArray data = buffer.mid(headerSize, static_cast<int>(size));
+        buffer.remove(0, headerSize + static_cast<int>(size));
+        handlePacket(socket, client, deviceIndex, packetId, data);
+    }
+}
+
+void OpenRgbServer::removeClient()
+{
+    auto *socket = qobject_cast<QIODevice *>(sender());
+    if (socket == nullptr)
+        return;
+    clients.remove(socket);
+    socket->deleteLater();
+}
+
+void OpenRgbServer::handlePacket(QIODevice *socket, const Client &client, quint32 deviceIndex, quint32 packetId, const QByteArray &data)
+{
+    if (packetId == RequestControllerCount) {
+        QByteArray count(4, Qt::Uninitialized);
+        qToLittleEndian(static_cast<quint32>(devices.size()), reinterpret_cast<uchar *>(count.data()));
+        socket->write(packet(0, RequestControllerCount, count));
+        return;
+    }
+    if (packetId == RequestProtocolVersion) {
+        QByteArray version(4, Qt::Uninitialized);
+        qToLittleEndian(protocolVersion, reinterpret_cast<uchar *>(version.data()));
+        socket->write(packet(0, RequestProtocolVersion, version));
+        return;
+    }
+    if (packetId == SetClientName) {
+        qDebug("OpenRGB client connected: %s", data.constData());
+        return;
+    }
+
+    if (deviceIndex >= static_cast<quint32>(devices.size())) {
+        qWarning("OpenRGB client sent packet %u for unknown controller %u.", packetId, deviceIndex);
+        return;
+    }
+    int index = static_cast<int>(deviceIndex);
+    DeviceState &state = states[index];
+
+    switch (packetId) {
+    case RequestControllerData:
+        socket->write(packet(deviceIndex, RequestControllerData, controllerData(controller(index))));
+        break;
+    case UpdateLeds: {
+        // After the size of the data
+        int offset = 4;
+        QVector<quint32> colors;
+        if (!parseColors(data, &offset, &colors) || colors.size() != state.colors.size())
+            break;
+        state.colors = colors;
+        applyColors(client, index);
+        break;
+    }
+    case UpdateZoneLeds: {
+        // After the size of the data and the zone, there is only zone 0
+        int offset = 8;
+        QVector<quint32> colors;
+        if (data.size() < offset || qFromLittleEndian<quint32>(reinterpret_cast<const uchar *>(data.constData() + 4)) != 0
+                || !parseColors(data, &offset, &colors) || colors.size() != state.colors.size())
+            break;
+        state.colors = colors;
+        applyColors(client, index);
+        break;
+    }
+    case UpdateSingleLed: {
+        if (data.size() < 8)
+            break;
+        qint32 led = qFromLittleEndian<qint32>(reinterpret_cast<const uchar *>(data.constData()));
+        if (led < 0 || led >= state.colors.size())
+            break;
+        state.colors[led] = qFromLittleEndian<quint32>(reinterpret_cast<const uchar *>(data.constData() + 4));
+        applyColors(client, index);
+        break;
+    }
+    case SetCustomMode:
+        if (state.modeFx.contains("custom_frame")) {
+            state.activeMode = state.modeFx.indexOf("custom_frame");
+            applyColors(client, index);
+        }
+        break;
+    case UpdateMode: {
+        if (data.size() < 8)
+            break;
+        qint32 modeIndex = qFromLittleEndian<qint32>(reinterpret_cast<const uchar *>(data.constData() + 4));
+        int offset = 8;
+        Mode mode;
+        if (modeIndex < 0 || modeIndex >= state.modes.size() || !parseMode(data, &offset, &mode))
+            break;
+        applyMode(client, index, modeIndex, mode);
+        break;
+    }
+    case ResizeZone:
+        // The zones have the size of the device
+        break;
+    default:
+        qWarning("Unhandled OpenRGB packet %u.", packetId);
+        break;
+    }
+}
+
+Controller OpenRgbServer::controller(int index)
+{
+    RazerDevice *device = devices.at(index);
+    const DeviceState &state = states.at(index);
+
+    Controller controller;
+    QString type = device->getType();
+    if (type == "keyboard")
+        controller.type = Keyboard;
+    else if (type == "mouse")
+        controller.type = Mouse;
+    else if (type == "mousepad")
+        controller.type = Mousemat;
+    else if (type == "headset")
+        controller.type = Headset;
+    controller.name = device->getName();
+    controller.description = "Razer device";
+    controller.version = device->getFirmwareVersion();
+    controller.serial = device->getObjectPath().path().section('/', -1);
+    controller.location = device->getObjectPath().path();
+    controller.modes = state.modes;
+    controller.activeMode = state.activeMode;
+    controller.zoneName = state.height > 1 ? "Matrix" : "LEDs";
+    controller.width = state.width;
+    controller.height = state.height;
+    controller.colors = state.colors;
+    return controller;
+}
+
+bool OpenRgbServer::applyColors(const Client &client, int index)
+{
+    RazerDevice *device = devices.at(index);
+    DeviceState &state = states[index];
+    // Suspended like the D-Bus calls of clients without the lease, the client still gets its colors reported back
+    if (!device->leaseArbiter()->mayControl(client.id))
+        return true;
+
+    if (!device->hasFx("custom_frame")) {
+        // A single color for the whole device
+        if (!device->hasFx("static"))
+            return false;
+        state.activeMode = state.modeFx.indexOf("static");
+        state.modes[state.activeMode].colors = {state.colors.first()};
+        bool ok = true;
+        foreach (RazerLED *led, device->getLeds())
+            ok &= led->setStatic(toRgb(state.colors.first()));
+        return ok;
+    }
+
+    // Straight onto the custom frame rows, the effect would overwrite them
+    device->pauseCustomEffectThread();
+    state.activeMode = state.modeFx.indexOf("custom_frame");
+    QByteArray row(static_cast<int>(state.width) * 3, Qt::Uninitialized);
+    for (quint32 y = 0; y < state.height; y++) {
+        for (quint32 x = 0; x < state.width; x++) {
+            quint32 color = state.colors.at(static_cast<int>(y * state.width + x));
+            row[static_cast<int>(x) * 3] = static_cast<char>(red(color));
+            row[static_cast<int>(x) * 3 + 1] = static_cast<char>(green(color));
+            row[static_cast<int>(x) * 3 + 2] = static_cast<char>(blue(color));
+        }
+        if (!device->defineCustomFrame(static_cast<uchar>(y), 0, static_cast<uchar>(state.width - 1), row))
+            return false;
+    }
+    return device->displayCustomFrame();
+}
+
+bool OpenRgbServer::applyMode(const Client &client, int index, qint32 modeIndex, const Mode &mode)
+{
+    RazerDevice *device = devices.at(index);
+    DeviceState &state = states[index];
+    QString fx = state.modeFx.at(modeIndex);
+    if (fx == "custom_frame") {
+        state.activeMode = modeIndex;
+        return applyColors(client, index);
+    }
+
+    // Keep the settings of the client, so they are reported back
+    Mode &stored = state.modes[modeIndex];
+    if (static_cast<quint32>(mode.colors.size()) == stored.colorsMax)
+        stored.colors = mode.colors;
+    stored.direction = mode.direction;
+    if (stored.flags & HasSpeed)
+        stored.speed = qBound(stored.speedMin, mode.speed, stored.speedMax);
+    state.activeMode = modeIndex;
+    if (!device->leaseArbiter()->mayControl(client.id))
+        return true;
+
+    RGB color1 = stored.colors.isEmpty() ? RGB{0, 0, 0} : toRgb(stored.colors.at(0));
+    RGB color2 = stored.colors.size() < 2 ? RGB{0, 0, 0} : toRgb(stored.colors.at(1));
+    bool ok = true;
+    foreach (RazerLED *led, device->getLeds()) {
+        if (fx == "off")
+            ok &= led->setNone();
+        else if (fx == "static")
+            ok &= led->setStatic(color1);
+        else if (fx == "breathing")
+            ok &= led->setBreathing(color1);
+        else if (fx == "breathing_dual")
+            ok &= led->setBreathingDual(color1, color2);
+        else if (fx == "breathing_random")
+            ok &= led->setBreathingRandom();
+        else if (fx == "blinking")
+            ok &= led->setBlinking(color1);
+        else if (fx == "spectrum")
+            ok &= led->setSpectrum();
+        else if (fx == "wave")
+            ok &= led->setWave(stored.direction == Left ? WaveDirection::RIGHT_TO_LEFT : WaveDirection::LEFT_TO_RIGHT);
+        else if (fx == "reactive")
+            ok &= led->setReactive(static_cast<ReactiveSpeed>(stored.speed), color1);
+    }
+    return ok;
+}
@@ -0,0 +1,84 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENRGBSERVER_H
+#define OPENRGBSERVER_H
+
+#include <QHash>
+#include <QLocalServer>
+#include <QObject>
+#include <QTcpServer>
+#include <QVector>
+
+#include "openrgbprotocol.h"
+#include "../device/razerdevice.h"
+
+/**
+ * Serves the devices to OpenRGB SDK clients, one controller per device.
+ *
+ * Devices with custom frames have one zone of the size of their matrix and a Direct mode,
+ * LED updates are sent as custom frame rows. The other modes are the effects in fx and are
+ * applied to all LEDs of the device.
+ */
+class OpenRgbServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    OpenRgbServer(QVector<RazerDevice *> devices, QObject *parent = nullptr);
+
+    // A port number listens on localhost, anything else is the name of a local socket
+    bool listen(const QString &address);
+
+private slots:
+    void newConnection();
+    void readClient();
+    void removeClient();
+
+private:
+    struct DeviceState {
+        QVector<OpenRgb::Mode> modes;
+        // fx string of every mode
+        QStringList modeFx;
+        qint32 activeMode = 0;
+        quint32 width = 1;
+        quint32 height = 1;
+        QVector<quint32> colors;
+    };
+
+    struct Client {
+        // Name of the client for the lighting leases of the devices
+        QString id;
+        // Received data that isn't a complete packet yet
+        QByteArray buffer;
+    };
+
+    void handlePacket(QIODevice *socket, const Client &client, quint32 deviceIndex, quint32 packetId, const QByteArray &data);
+    OpenRgb::Controller controller(int index);
+    bool applyColors(const Client &client, int index);
+    bool applyMode(const Client &client, int index, qint32 modeIndex, const OpenRgb::Mode &mode);
+
+    QTcpServer *tcpServer = nullptr;
+    QLocalServer *localServer = nullptr;
+    QVector<RazerDevice *> devices;
+    QVector<DeviceState> states;
+    QHash<QIODevice *, Client> clients;
+    quint64 nextClientId = 0;
+};
+
+#endif // OPENRGBSERVER_H
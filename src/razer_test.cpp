@@ -23,9 +23,15 @@
 #include "led/razerled.h"
 #include "led/razerclassicled.h"
 #include "dbus/razerdeviceadaptor.h"
+#include "dbus/razerdevicedispatcher.h"
 #include "dbus/devicemanageradaptor.h"
 #include "dbus/razerledadaptor.h"
+#include "dbus/razerleddispatcher.h"
+#include "dbus/peerserver.h"
 #include "manager/devicemanager.h"
+#include "openrgb/openrgbserver.h"
+#include "stream/framestreamserver.h"
+#include "customeffect/effectfactory.h"
 #include "config.h"
 
 #define ANSI_BOLD          "\x1b[1m"
@@ -36,6 +42,8 @@
 
 // Used to tell myMessageOutput if --verbose was given on the command line
 bool verbose = false;
+// Export devices and LEDs with the generated adaptors instead of the dispatchers (--legacy-adaptors)
+bool legacyAdaptors = false;
 
 void myMessageOutput(QtMsgType type, const QMessageLogContext &/*context*/, const QString &msg)
 {
@@ -102,19 +110,49 @@ bool getVidPidFromJson(QJsonObject deviceObj, ushort *vid, ushort *pid)
     return true;
 }
 
-bool registerDeviceOnDBus(RazerDevice *device, QDBusConnection &connection)
+// Registers the object with its adaptors, or its dispatcher if there is one
+bool registerObjectOnDBus(QObject *object, DBusDispatcher *dispatcher, const QString &path, QDBusConnection &connection, PeerServer *peerServer)
+{
+    bool ok;
+    if (dispatcher != nullptr) {
+        ok = dispatcher->registerOn(connection, path);
+        peerServer->registerObject(path, dispatcher);
+    } else {
+        ok = connection.registerObject(path, object);
+        peerServer->registerObject(path, object);
+    }
+    if (!ok)
+        qCritical("Failed to register D-Bus object at \"%s\".", qUtf8Printable(path));
+    return ok;
+}
+
+bool registerDeviceOnDBus(RazerDevice *device, QDBusConnection &connection, PeerServer *peerServer)
 {
     // D-Bus
-    new RazerDeviceAdaptor(device);
-    if (!connection.registerObject(device->getObjectPath().path(), device)) {
-        qCritical("Failed to register D-Bus object at \"%s\".", qUtf8Printable(device->getObjectPath().path()));
+    DBusDispatcher *dispatcher = nullptr;
+    if (legacyAdaptors) {
+        new RazerDeviceAdaptor(device);
+    } else {
+        dispatcher = new RazerDeviceDispatcher(device);
+        dispatcher->setClientQos(device->clientQos());
+        dispatcher->setLeaseArbiter(device->leaseArbiter());
+        dispatcher->setDeviceHealth(device->deviceHealth());
+    }
+    if (!registerObjectOnDBus(device, dispatcher, device->getObjectPath().path(), connection, peerServer)) {
         delete device;
         return false;
     }
     foreach (RazerLED *led, device->getLeds()) {
-        new RazerLEDAdaptor(led);
-        if (!connection.registerObject(led->getObjectPath().path(), led)) {
-            qCritical("Failed to register D-Bus object at \"%s\".", qUtf8Printable(led->getObjectPath().path()));
+        if (legacyAdaptors) {
+            new RazerLEDAdaptor(led);
+        } else {
+            dispatcher = new RazerLEDDispatcher(led);
+            // The LEDs share the limits, the lighting lease and the health of their device
+            dispatcher->setClientQos(device->clientQos());
+            dispatcher->setLeaseArbiter(device->leaseArbiter());
+            dispatcher->setDeviceHealth(device->deviceHealth());
+        }
+        if (!registerObjectOnDBus(led, dispatcher, led->getObjectPath().path(), connection, peerServer)) {
             delete device;
             return false;
         }
@@ -201,6 +239,15 @@ RazerDevice *initializeDevice(QString dev_path, QJsonObject deviceObj)
         delete device;
         return nullptr;
     }
+    // Optional calibration, e.g. {"gamma": 2.2, "white_balance": [1.0, 0.85, 0.7]}
+    if (deviceObj.contains("color_correction")) {
+        QJsonObject correction = deviceObj["color_correction"].toObject();
+        QJsonArray whiteBalance = correction["white_balance"].toArray();
+        device->setColorCorrection(correction["gamma"].toDouble(1.0),
+                                   whiteBalance.at(0).toDouble(1.0),
+                                   whiteBalance.at(1).toDouble(1.0),
+                                   whiteBalance.at(2).toDouble(1.0));
+    }
     return device;
 }
 
@@ -221,9 +268,15 @@ int main(int argc, char *argv[])
     parser.addOption({"devel", QString("Uses data files at ../data/devices instead of %1.").arg(RAZER_TEST_DATADIR)});
     parser.addOption({"fake-devices", "Adds fake devices instead of real ones."});
     parser.addOption({"verbose", "Print debug messages."});
+    parser.addOption({"legacy-adaptors", "Exports devices and LEDs with the generated adaptors instead of the table-driven dispatchers."});
+    parser.addOption({"peer-address", "Listens for peer-to-peer D-Bus connections on <address> instead of an abstract Unix socket.", "address"});
+    parser.addOption({"stream-socket", QString("Listens for frame streams on the local socket <name> instead of %1.").arg(FrameStream::defaultSocketName), "name"});
+    parser.addOption({"openrgb", QString("Serves the OpenRGB SDK protocol on localhost if <address> is a port (usually %1), otherwise on the local socket <address>.").arg(OpenRgb::defaultPort), "address"});
+    parser.addOption({"effect-plugins", QString("Loads custom effect plugins from <directory> instead of %1.").arg(RAZER_TEST_PLUGINDIR), "directory"});
     parser.process(app);
 
     verbose = parser.isSet("verbose");
+    legacyAdaptors = parser.isSet("legacy-adaptors");
     qInstallMessageHandler(myMessageOutput);
 
     qInfo("razer_test - version %s", RAZER_TEST_VERSION);
@@ -233,6 +286,12 @@ int main(int argc, char *argv[])
     // Register the enums with the Qt system
     razer_test::registerMetaTypes();
 
+    // Load the custom effect plugins
+    QString pluginDir = parser.isSet("effect-plugins") ? parser.value("effect-plugins") : RAZER_TEST_PLUGINDIR;
+    int pluginEffects = EffectFactory::loadPlugins(pluginDir);
+    if (pluginEffects > 0)
+        qInfo("Loaded %d custom effects from plugins.", pluginEffects);
+
     // Get the D-Bus system bus
     QDBusConnection connection = QDBusConnection::systemBus();
 
@@ -244,6 +303,9 @@ int main(int argc, char *argv[])
 
     QVector<RazerDevice *> devices;
 
+    // The same objects on a private socket, for clients that stream frames
+    auto *peerServer = new PeerServer();
+
     // Use the real devices
     if (!parser.isSet("fake-devices")) {
         if (hid_init())
@@ -276,7 +338,7 @@ int main(int argc, char *argv[])
                     devices.append(device);
 
                     // D-Bus
-                    registerDeviceOnDBus(device, connection);
+                    registerDeviceOnDBus(device, connection, peerServer);
 
                     break;
                 }
@@ -296,7 +358,7 @@ int main(int argc, char *argv[])
             devices.append(device);
 
             // D-Bus
-            registerDeviceOnDBus(device, connection);
+            registerDeviceOnDBus(device, connection, peerServer);
         }
     }
 
@@ -306,6 +368,20 @@ int main(int argc, char *argv[])
         qFatal("Failed to register D-Bus object at \"%s\".", qUtf8Printable(manager->getObjectPath().path()));
     }
 
+    peerServer->setParent(manager);
+    peerServer->registerObject(manager->getObjectPath().path(), manager);
+    if (parser.isSet("peer-address") ? peerServer->listen(parser.value("peer-address")) : peerServer->listen())
+        manager->setPeerServer(peerServer);
+
+    // Frames over a plain socket, without marshalling and replies
+    auto *streamServer = new FrameStreamServer(devices, manager);
+    streamServer->listen(parser.isSet("stream-socket") ? parser.value("stream-socket") : FrameStream::defaultSocketName);
+
+    if (parser.isSet("openrgb")) {
+        auto *openRgbServer = new OpenRgbServer(devices, manager);
+        openRgbServer->listen(parser.value("openrgb"));
+    }
+
 #ifdef DEMO
 
     if (devices.isEmpty()) {
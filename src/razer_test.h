@@ -21,6 +21,8 @@
 
 #include <QDBusArgument>
 #include <QDBusMetaType>
+#include <QDBusObjectPath>
+#include <QVariantList>
 
 namespace razer_test {
 
@@ -217,6 +219,55 @@ inline const QDBusArgument &operator>>(const QDBusArgument &argument, RGB &value
     return argument;
 }
 
+// A method call on a device or LED object, e.g. setStatic with one RGB argument
+struct RazerOperation {
+    QDBusObjectPath object;
+    QString method;
+    QVariantList arguments;
+};
+
+// Marshall the RazerOperation data into a D-Bus argument
+inline QDBusArgument &operator<<(QDBusArgument &argument, const RazerOperation &value)
+{
+    argument.beginStructure();
+    argument << value.object << value.method << value.arguments;
+    argument.endStructure();
+    return argument;
+}
+
+// Retrieve the RazerOperation data from the D-Bus argument
+inline const QDBusArgument &operator>>(const QDBusArgument &argument, RazerOperation &value)
+{
+    argument.beginStructure();
+    argument >> value.object >> value.method >> value.arguments;
+    argument.endStructure();
+    return argument;
+}
+
+// Outcome of one RazerOperation, error is empty on success
+struct RazerOperationResult {
+    bool success;
+    QString error;
+};
+
+// Marshall the RazerOperationResult data into a D-Bus argument
+inline QDBusArgument &operator<<(QDBusArgument &argument, const RazerOperationResult &value)
+{
+    argument.beginStructure();
+    argument << value.success << value.error;
+    argument.endStructure();
+    return argument;
+}
+
+// Retrieve the RazerOperationResult data from the D-Bus argument
+inline const QDBusArgument &operator>>(const QDBusArgument &argument, RazerOperationResult &value)
+{
+    argument.beginStructure();
+    argument >> value.success >> value.error;
+    argument.endStructure();
+    return argument;
+}
+
 }
 
 Q_DECLARE_METATYPE(razer_test::RazerLedId)
@@ -226,6 +277,8 @@ Q_DECLARE_METATYPE(razer_test::RazerEffect)
 Q_DECLARE_METATYPE(razer_test::RazerDPI)
 Q_DECLARE_METATYPE(razer_test::MatrixDimensions)
 Q_DECLARE_METATYPE(razer_test::RGB)
+Q_DECLARE_METATYPE(razer_test::RazerOperation)
+Q_DECLARE_METATYPE(razer_test::RazerOperationResult)
 
 namespace razer_test {
 
@@ -255,6 +308,16 @@ inline void registerMetaTypes()
     qDBusRegisterMetaType<RazerEffect>();
 
     qDBusRegisterMetaType<QList<QDBusObjectPath>>();
+
+    qRegisterMetaType<RazerOperation>("RazerOperation");
+    qDBusRegisterMetaType<RazerOperation>();
+    qRegisterMetaType<QList<RazerOperation>>("QList<RazerOperation>");
+    qDBusRegisterMetaType<QList<RazerOperation>>();
+
+    qRegisterMetaType<RazerOperationResult>("RazerOperationResult");
+    qDBusRegisterMetaType<RazerOperationResult>();
+    qRegisterMetaType<QList<RazerOperationResult>>("QList<RazerOperationResult>");
+    qDBusRegisterMetaType<QList<RazerOperationResult>>();
 }
 
 }
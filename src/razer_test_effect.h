@@ -0,0 +1,96 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RAZERTESTEFFECT_H
+#define RAZERTESTEFFECT_H
+
+/*
+ * C ABI for custom effect plugins.
+ *
+ * A plugin is a shared library in the daemon's effect plugin directory that
+ * exports RAZER_TEST_EFFECT_ENTRY. No Qt or C++ types cross this boundary, so
+ * plugins can be written in any language that can produce a C shared library.
+ *
+ * Minimal plugin:
+ *
+ *   static void *create(uint8_t width, uint8_t height) { ... }
+ *   static void destroy(void *instance) { ... }
+ *   static void render(void *instance, razer_test_effect_frame *frame) { ... }
+ *
+ *   static const razer_test_effect effects[] = {
+ *       {RAZER_TEST_EFFECT_ABI_VERSION, "myeffect", 30, 0, 0, create, destroy, render}
+ *   };
+ *
+ *   const razer_test_effect *razer_test_effect_entry(unsigned int *count)
+ *   {
+ *       *count = 1;
+ *       return effects;
+ *   }
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RAZER_TEST_EFFECT_ABI_VERSION 1
+
+/* The effect repeats itself after `period` frames. It is rendered once and then played back from a cache. */
+#define RAZER_TEST_EFFECT_PERIODIC 0x01
+/* The effect always renders the same frame. It is rendered once and not animated. */
+#define RAZER_TEST_EFFECT_STATIC 0x02
+
+typedef struct razer_test_effect_frame {
+    uint8_t width;
+    uint8_t height;
+    /* Number of bytes between the start of two rows */
+    uint32_t stride;
+    /* Packed RGB24 data, height rows of width * 3 bytes */
+    uint8_t *rgb_data;
+} razer_test_effect_frame;
+
+typedef struct razer_test_effect {
+    /* Has to be RAZER_TEST_EFFECT_ABI_VERSION, otherwise the effect is not loaded */
+    uint32_t abi_version;
+    /* Name used to start the effect, e.g. with startCustomEffectThread */
+    const char *name;
+    /* Preferred frames per second */
+    uint32_t fps;
+    /* RAZER_TEST_EFFECT_* flags */
+    uint32_t flags;
+    /* Number of frames in one cycle, only used with RAZER_TEST_EFFECT_PERIODIC */
+    uint32_t period;
+
+    /* Create an effect instance for a matrix of the given size, NULL on error */
+    void *(*create)(uint8_t width, uint8_t height);
+    void (*destroy)(void *instance);
+    /* Render the next frame into the buffer provided by the daemon. Called from the effect thread. */
+    void (*render)(void *instance, razer_test_effect_frame *frame);
+} razer_test_effect;
+
+/* Exported by every plugin. Returns an array of *count effects that stays valid while the plugin is loaded. */
+typedef const razer_test_effect *(*razer_test_effect_entry_func)(unsigned int *count);
+#define RAZER_TEST_EFFECT_ENTRY "razer_test_effect_entry"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RAZERTESTEFFECT_H */
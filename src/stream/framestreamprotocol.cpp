@@ -0,0 +1,95 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtEndian>
+
+#include "framestreamprotocol.h"
+
+namespace FrameStream {
+
+QByteArray encodeMessage(MessageType type, const QByteArray &payload)
+{
+    QByteArray message;
+    message.reserve(4 + 1 + payload.size());
+    appendUInt32(&message, static_cast<quint32>(1 + payload.size()));
+    appendUInt8(&message, static_cast<quint8>(type));
+    message.append(payload);
+    return message;
+}
+
+bool takeMessage(QByteArray *buffer, MessageType *type, QByteArray *payload, bool *error)
+{
+    *error = false;
+    if (buffer->size() < 4)
+        return false;
+    quint32 size = readUInt32(*buffer, 0);
+    if (size == 0 || size > static_cast<quint32>(maxMessageSize)) {
+        *error = true;
+        return false;
+    }
+    if (static_cast<quint32>(buffer->size()) < 4 + size)
+        return false;
+
+    *type = static_cast<MessageType>(static_cast<quint8>(buffer->at(4)));
+    *payload = buffer->mid(5, static_cast<int>(size) - 1);
+    buffer->remove(0, 4 + static_cast<int>(size));
+    return true;
+}
+
+void appendUInt8(QByteArray *data, quint8 value)
+{
+    data->append(static_cast<char>(value));
+}
+
+void appendUInt16(QByteArray *data, quint16 value)
+{
+    uchar bytes[2];
+    qToLittleEndian(value, bytes);
+    data->append(reinterpret_cast<const char *>(bytes), sizeof(bytes));
+}
+
+void appendUInt32(QByteArray *data, quint32 value)
+{
+    uchar bytes[4];
+    qToLittleEndian(value, bytes);
+    data->append(reinterpret_cast<const char *>(bytes), sizeof(bytes));
+}
+
+void appendInt64(QByteArray *data, qint64 value)
+{
+    uchar bytes[8];
+    qToLittleEndian(value, bytes);
+    data->append(reinterpret_cast<const char *>(bytes), sizeof(bytes));
+}
+
+quint16 readUInt16(const QByteArray &data, int offset)
+{
+    return qFromLittleEndian<quint16>(reinterpret_cast<const uchar *>(data.constData() + offset));
+}
+
+quint32 readUInt32(const QByteArray &data, int offset)
+{
+    return qFromLittleEndian<quint32>(reinterpret_cast<const uchar *>(data.constData() + offset));
+}
+
+qint64 readInt64(const QByteArray &data, int offset)
+{
+    return qFromLittleEndian<qint64>(reinterpret_cast<const uchar *>(data.constData() + offset));
+}
+
+}
@@ -0,0 +1,91 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAMESTREAMPROTOCOL_H
+#define FRAMESTREAMPROTOCOL_H
+
+#include <QByteArray>
+
+/**
+ * Binary protocol to stream custom frames over a Unix stream socket.
+ *
+ * Every message is a little endian quint32 with the size of the rest of the message,
+ * followed by the message type and its payload. Integers are little endian.
+ *
+ * The client starts with Hello, the server answers with Welcome which lists the devices.
+ * After SelectDevice the client pushes frames, an Ack is sent for frames that ask for it
+ * once the frame was presented, dropped or rejected. Errors are reported with Error.
+ */
+namespace FrameStream {
+
+const quint16 protocolVersion = 1;
+// Name passed to QLocalServer / QLocalSocket if none is configured
+const char *const defaultSocketName = "razer_test-frames";
+// Largest message accepted, enough for the frames of every device
+const int maxMessageSize = 64 * 1024;
+
+enum class MessageType : quint8 {
+    // Client: quint16 version
+    Hello = 0x01,
+    // Client: UTF-8 object path of the device
+    SelectDevice = 0x02,
+    // Client: quint32 sequence, qint64 presentation time (0 for now), quint8 flags, RGB data of the whole frame
+    Frame = 0x03,
+
+    // Server: quint16 version, quint8 device count, per device quint8 path length, path, quint8 width, quint8 height
+    Welcome = 0x81,
+    // Server: quint8 width, quint8 height
+    DeviceSelected = 0x82,
+    // Server: quint32 sequence, quint8 AckStatus, qint64 lateness in microseconds
+    Ack = 0x83,
+    // Server: UTF-8 message
+    Error = 0xFF
+};
+
+enum FrameFlags : quint8 {
+    RequestAck = 0x01
+};
+
+enum class AckStatus : quint8 {
+    Presented = 0,
+    // Superseded by a newer frame that was due at the same time, or another client holds the lighting lease
+    Dropped = 1,
+    // Wrong size or too many frames queued
+    Rejected = 2
+};
+
+// Size of the fields of a Frame message before the RGB data
+const int frameHeaderSize = 4 + 8 + 1;
+
+QByteArray encodeMessage(MessageType type, const QByteArray &payload);
+// Takes the first complete message out of buffer. Returns false if more data is needed,
+// sets error if the message is malformed, after which the connection should be closed.
+bool takeMessage(QByteArray *buffer, MessageType *type, QByteArray *payload, bool *error);
+
+void appendUInt8(QByteArray *data, quint8 value);
+void appendUInt16(QByteArray *data, quint16 value);
+void appendUInt32(QByteArray *data, quint32 value);
+void appendInt64(QByteArray *data, qint64 value);
+// The caller has to make sure offset is in range
+quint16 readUInt16(const QByteArray &data, int offset);
+quint32 readUInt32(const QByteArray &data, int offset);
+qint64 readInt64(const QByteArray &data, int offset);
+
+}
+
+#endif // FRAMESTREAMPROTOCOL_H
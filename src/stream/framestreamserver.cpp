@@ -0,0 +1,222 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "framestreamserver.h"
+
+using namespace FrameStream;
+
+FrameStreamServer::FrameStreamServer(QVector<RazerDevice *> devices, QObject *parent)
+    : QObject(parent)
+    , devices(devices)
+{
+    server = new QLocalServer(this);
+    // Like the bus policy, every user may use the devices
+    server->setSocketOptions(QLocalServer::WorldAccessOption);
+    connect(server, &QLocalServer::newConnection, this, &FrameStreamServer::newConnection);
+
+    foreach (RazerDevice *device, devices) {
+        connect(device, &RazerDevice::FramePresented, this, &FrameStreamServer::framePresented);
+        connect(device, &RazerDevice::FrameDropped, this, &FrameStreamServer::frameDropped);
+    }
+}
+
+bool FrameStreamServer::listen(const QString &name)
+{
+    // A socket left behind by a daemon that didn't shut down cleanly
+    QLocalServer::removeServer(name);
+    if (!server->listen(name)) {
+        qWarning("Failed to listen for frame streams on \"%s\": %s", qUtf8Printable(name), qUtf8Printable(server->errorString()));
+        return false;
+    }
+    qInfo("Listening for frame streams on \"%s\".", qUtf8Printable(server->fullServerName()));
+    return true;
+}
+
+QString FrameStreamServer::fullServerName() const
+{
+    return server->fullServerName();
+}
+
+void FrameStreamServer::newConnection()
+{
+    while (QLocalSocket *socket = server->nextPendingConnection()) {
+        Client client;
+        // Streams can't acquire a lease, they only control the devices nobody holds a lease on
+        client.id = QString("framestream:%1").arg(nextClientId++);
+        clients.insert(socket, client);
+        connect(socket, &QLocalSocket::readyRead, this, &FrameStreamServer::readClient);
+        connect(socket, &QLocalSocket::disconnected, this, &FrameStreamServer::removeClient);
+    }
+}
+
+void FrameStreamServer::readClient()
+{
+    auto *socket = qobject_cast<QLocalSocket *>(sender());
+    if (socket == nullptr || !clients.contains(socket))
+        return;
+    Client &client = clients[socket];
+    client.buffer.append(socket->readAll());
+
+    MessageType type;
+    QByteArray payload;
+    bool error;
+    while (takeMessage(&client.buffer, &type, &payload, &error)) {
+        if (!handleMessage(socket, client, type, payload)) {
+            socket->disconnectFromServer();
+            return;
+        }
+    }
+    if (error) {
+        sendError(socket, "Malformed message.");
+        socket->disconnectFromServer();
+    }
+}
+
+void FrameStreamServer::removeClient()
+{
+    auto *socket = qobject_cast<QLocalSocket *>(sender());
+    if (socket == nullptr)
+        return;
+    clients.remove(socket);
+    socket->deleteLater();
+}
+
+bool FrameStreamServer::handleMessage(QLocalSocket *socket, Client &client, MessageType type, const QByteArray &payload)
+{
+    if (!client.welcomed && type != MessageType::Hello) {
+        sendError(socket, "Expected Hello.");
+        return false;
+    }
+
+    switch (type) {
+    case MessageType::Hello: {
+        if (payload.size() < 2 || readUInt16(payload, 0) != protocolVersion) {
+            sendError(socket, QString("Unsupported protocol version, expected %1.").arg(protocolVersion));
+            return false;
+        }
+        QByteArray welcome;
+        appendUInt16(&welcome, protocolVersion);
+        appendUInt8(&welcome, static_cast<quint8>(devices.size()));
+        foreach (RazerDevice *device, devices) {
+            QByteArray path = device->getObjectPath().path().toUtf8();
+            appendUInt8(&welcome, static_cast<quint8>(path.size()));
+            welcome.append(path);
+            appendUInt8(&welcome, device->frameWidth());
+            appendUInt8(&welcome, device->frameHeight());
+        }
+        socket->write(encodeMessage(MessageType::Welcome, welcome));
+        client.welcomed = true;
+        return true;
+    }
+    case MessageType::SelectDevice: {
+        QString path = QString::fromUtf8(payload);
+        RazerDevice *selected = nullptr;
+        foreach (RazerDevice *device, devices) {
+            if (device->getObjectPath().path() == path)
+                selected = device;
+        }
+        if (selected == nullptr || !selected->hasFx("custom_frame")) {
+            sendError(socket, "Unknown device or it doesn't support custom frames.");
+            return true;
+        }
+        // Frames of the previous device won't be acked anymore
+        client.pendingAcks.clear();
+        client.device = selected;
+        QByteArray reply;
+        appendUInt8(&reply, selected->frameWidth());
+        appendUInt8(&reply, selected->frameHeight());
+        socket->write(encodeMessage(MessageType::DeviceSelected, reply));
+        return true;
+    }
+    case MessageType::Frame:
+        handleFrame(socket, client, payload);
+        return true;
+    default:
+        sendError(socket, "Unknown message type.");
+        return false;
+    }
+}
+
+void FrameStreamServer::handleFrame(QLocalSocket *socket, Client &client, const QByteArray &payload)
+{
+    if (payload.size() < frameHeaderSize) {
+        sendError(socket, "Frame message too short.");
+        return;
+    }
+    quint32 sequence = readUInt32(payload, 0);
+    qint64 presentationTime = readInt64(payload, 4);
+    bool requestAck = (static_cast<quint8>(payload.at(12)) & RequestAck) != 0;
+
+    if (client.device == nullptr) {
+        sendError(socket, "No device selected.");
+        return;
+    }
+    if (presentationTime == 0)
+        presentationTime = client.device->getMonotonicTime();
+
+    // Suspended like the D-Bus calls of clients without the lease, the stream goes on and shows again once the lease ends
+    if (!client.device->leaseArbiter()->mayControl(client.id)) {
+        if (requestAck)
+            sendAck(socket, sequence, AckStatus::Dropped);
+        return;
+    }
+
+    // The jitter buffer replaces a frame with the same timestamp without telling anyone
+    if (client.pendingAcks.contains(presentationTime))
+        sendAck(socket, client.pendingAcks.take(presentationTime), AckStatus::Dropped);
+
+    if (!client.device->submitFrame(presentationTime, payload.mid(frameHeaderSize))) {
+        if (requestAck)
+            sendAck(socket, sequence, AckStatus::Rejected);
+        return;
+    }
+    if (requestAck)
+        client.pendingAcks.insert(presentationTime, sequence);
+}
+
+void FrameStreamServer::framePresented(qlonglong presentationTime, qlonglong lateness)
+{
+    ackFrame(qobject_cast<RazerDevice *>(sender()), presentationTime, AckStatus::Presented, lateness);
+}
+
+void FrameStreamServer::frameDropped(qlonglong presentationTime)
+{
+    ackFrame(qobject_cast<RazerDevice *>(sender()), presentationTime, AckStatus::Dropped, 0);
+}
+
+void FrameStreamServer::ackFrame(RazerDevice *device, qint64 presentationTime, AckStatus status, qint64 lateness)
+{
+    for (auto it = clients.begin(); it != clients.end(); ++it) {
+        if (it.value().device == device && it.value().pendingAcks.contains(presentationTime))
+            sendAck(it.key(), it.value().pendingAcks.take(presentationTime), status, lateness);
+    }
+}
+
+void FrameStreamServer::sendAck(QLocalSocket *socket, quint32 sequence, AckStatus status, qint64 lateness)
+{
+    QByteArray ack;
+    appendUInt32(&ack, sequence);
+    appendUInt8(&ack, static_cast<quint8>(status));
+    appendInt64(&ack, lateness);
+    socket->write(encodeMessage(MessageType::Ack, ack));
+}
+
+void FrameStreamServer::sendError(QLocalSocket *socket, const QString &message)
+{
+    socket->write(encodeMessage(MessageType::Error, message.toUtf8()));
+}
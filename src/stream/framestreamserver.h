@@ -0,0 +1,74 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAMESTREAMSERVER_H
+#define FRAMESTREAMSERVER_H
+
+#include <QHash>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QObject>
+#include <QVector>
+
+#include "framestreamprotocol.h"
+#include "../device/razerdevice.h"
+
+/**
+ * Accepts frame streams (see framestreamprotocol.h) and feeds them to RazerDevice::submitFrame().
+ */
+class FrameStreamServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    FrameStreamServer(QVector<RazerDevice *> devices, QObject *parent = nullptr);
+
+    bool listen(const QString &name = FrameStream::defaultSocketName);
+    QString fullServerName() const;
+
+private slots:
+    void newConnection();
+    void readClient();
+    void removeClient();
+    void framePresented(qlonglong presentationTime, qlonglong lateness);
+    void frameDropped(qlonglong presentationTime);
+
+private:
+    struct Client {
+        // Name of the client for the lighting leases of the devices
+        QString id;
+        QByteArray buffer;
+        bool welcomed = false;
+        RazerDevice *device = nullptr;
+        // Sequence numbers of frames waiting for an ack, by presentation time
+        QHash<qint64, quint32> pendingAcks;
+    };
+
+    bool handleMessage(QLocalSocket *socket, Client &client, FrameStream::MessageType type, const QByteArray &payload);
+    void handleFrame(QLocalSocket *socket, Client &client, const QByteArray &payload);
+    void sendAck(QLocalSocket *socket, quint32 sequence, FrameStream::AckStatus status, qint64 lateness = 0);
+    void sendError(QLocalSocket *socket, const QString &message);
+    void ackFrame(RazerDevice *device, qint64 presentationTime, FrameStream::AckStatus status, qint64 lateness);
+
+    QLocalServer *server;
+    QVector<RazerDevice *> devices;
+    QHash<QLocalSocket *, Client> clients;
+    quint64 nextClientId = 0;
+};
+
+#endif // FRAMESTREAMSERVER_H
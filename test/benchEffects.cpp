@@ -0,0 +1,123 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QObject>
+#include <QtTest>
+
+#include "../src/customeffect/colorkernels.h"
+#include "../src/customeffect/customframe.h"
+#include "../src/customeffect/spectrumeffect.h"
+#include "../src/customeffect/waveeffect.h"
+
+// Per-frame cost of the effects and kernels, on a real keyboard and on a large virtual canvas.
+class benchEffects : public QObject
+{
+    Q_OBJECT
+private:
+    void addCanvases();
+
+private slots:
+    void spectrumFrame_data();
+    void spectrumFrame();
+    void waveFrame_data();
+    void waveFrame();
+    void blendFrame_data();
+    void blendFrame();
+    void scaleFrame_data();
+    void scaleFrame();
+};
+
+QTEST_MAIN(benchEffects)
+
+void benchEffects::addCanvases()
+{
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::newRow("22x6") << 22 << 6;
+    QTest::newRow("255x255") << 255 << 255;
+}
+
+void benchEffects::spectrumFrame_data()
+{
+    addCanvases();
+}
+
+void benchEffects::spectrumFrame()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+    qInfo("Using %s color kernels.", activeColorKernelTable()->name);
+    CustomFrame frame(width, height);
+    SpectrumEffect effect(width, height);
+    effect.initialize();
+    QBENCHMARK {
+        effect.prepareRgbData(frame);
+    }
+}
+
+void benchEffects::waveFrame_data()
+{
+    addCanvases();
+}
+
+void benchEffects::waveFrame()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+    CustomFrame frame(width, height);
+    WaveEffect effect(width, height);
+    effect.initialize();
+    QBENCHMARK {
+        effect.prepareRgbData(frame);
+    }
+}
+
+void benchEffects::blendFrame_data()
+{
+    addCanvases();
+}
+
+void benchEffects::blendFrame()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+    CustomFrame frame(width, height);
+    CustomFrame overlay(width, height);
+    fillRgb(overlay.data(), width * height, {0x00, 0x80, 0xFF});
+    QBENCHMARK {
+        blendRgb(frame.data(), overlay.constData(), width * height, 0x80);
+    }
+}
+
+void benchEffects::scaleFrame_data()
+{
+    addCanvases();
+}
+
+void benchEffects::scaleFrame()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+    CustomFrame frame(width, height);
+    fillRgb(frame.data(), width * height, {0xFF, 0xFF, 0xFF});
+    QBENCHMARK {
+        scaleRgb(frame.data(), width * height, 0xF0);
+    }
+}
+
+#include "benchEffects.moc"
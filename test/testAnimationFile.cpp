@@ -0,0 +1,173 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+
+#include <unistd.h>
+
+#include <QObject>
+#include <QTemporaryFile>
+#include <QtTest>
+
+#include "../src/customeffect/animationfile.h"
+
+class testAnimationFile : public QObject
+{
+    Q_OBJECT
+private:
+    QVector<CustomFrame> frames;
+    QVector<ushort> durations;
+    QTemporaryFile file;
+
+private slots:
+    void initTestCase();
+    void sequentialPlayback();
+    void randomSeek();
+    void openFromDescriptor();
+    void keepsPrivateCopy();
+    void rejectsInvalidFiles();
+};
+
+QTEST_MAIN(testAnimationFile)
+
+void testAnimationFile::initTestCase()
+{
+    // Mostly small changes with a full change every now and then, like a real animation
+    CustomFrame frame(22, 6);
+    for (int i = 0; i < 100; i++) {
+        int changes = i % 7 == 0 ? 22 * 6 : qrand() % 10;
+        for (int c = 0; c < changes; c++)
+            frame.data()[qrand() % frame.size()] = static_cast<uchar>(qrand());
+        CustomFrame copy(22, 6);
+        memcpy(copy.data(), frame.constData(), frame.size());
+        frames.append(copy);
+        durations.append(10 + i);
+    }
+
+    QByteArray encoded = AnimationFile::encode(frames, durations);
+    QVERIFY(encoded.size() < frames.size() * frame.size());
+    QVERIFY(file.open());
+    file.write(encoded);
+    file.flush();
+}
+
+void testAnimationFile::sequentialPlayback()
+{
+    AnimationFile animation;
+    QVERIFY(animation.open(file.fileName()));
+    QCOMPARE(animation.width(), static_cast<uchar>(22));
+    QCOMPARE(animation.height(), static_cast<uchar>(6));
+    QCOMPARE(animation.frameCount(), frames.size());
+    QCOMPARE(animation.minFrameDuration(), static_cast<ushort>(10));
+
+    CustomFrame frame(22, 6);
+    for (int i = 0; i < frames.size(); i++) {
+        QVERIFY(animation.decodeNextFrame(i, frame));
+        QVERIFY(frame == frames.at(i));
+        QCOMPARE(animation.frameDuration(i), durations.at(i));
+    }
+}
+
+void testAnimationFile::randomSeek()
+{
+    AnimationFile animation;
+    QVERIFY(animation.open(file.fileName()));
+
+    for (int i = frames.size() - 1; i >= 0; i -= 7) {
+        CustomFrame frame(22, 6);
+        QVERIFY(animation.decodeFrame(i, frame));
+        QVERIFY(frame == frames.at(i));
+    }
+    CustomFrame wrongSize(15, 1);
+    QVERIFY(!animation.decodeFrame(0, wrongSize));
+}
+
+void testAnimationFile::openFromDescriptor()
+{
+    // Like a descriptor passed over D-Bus, which is closed once the call is handled
+    QFile client(file.fileName());
+    QVERIFY(client.open(QIODevice::ReadOnly));
+    AnimationFile animation;
+    QVERIFY(animation.open(client.handle()));
+    client.close();
+
+    CustomFrame frame(22, 6);
+    QVERIFY(animation.decodeFrame(frames.size() - 1, frame));
+    QVERIFY(frame == frames.last());
+    QVERIFY(!animation.open(-1));
+}
+
+void testAnimationFile::keepsPrivateCopy()
+{
+    QTemporaryFile changing;
+    QVERIFY(changing.open());
+    changing.write(AnimationFile::encode(frames, durations));
+    changing.flush();
+    AnimationFile animation;
+    QVERIFY(animation.open(changing.handle()));
+
+    // The client rewrites and truncates its file while the animation is played
+    QVERIFY(changing.resize(0));
+    changing.seek(0);
+    changing.write(QByteArray(32, '\xFF'));
+    changing.flush();
+
+    CustomFrame frame(22, 6);
+    for (int i = 0; i < frames.size(); i++) {
+        QVERIFY(animation.decodeNextFrame(i, frame));
+        QVERIFY(frame == frames.at(i));
+    }
+}
+
+void testAnimationFile::rejectsInvalidFiles()
+{
+    QByteArray encoded = AnimationFile::encode(frames, durations);
+    AnimationFile animation;
+
+    QTemporaryFile truncated;
+    QVERIFY(truncated.open());
+    truncated.write(encoded.left(encoded.size() - 1));
+    truncated.flush();
+    QVERIFY(!animation.open(truncated.fileName()));
+    QVERIFY(!animation.isOpen());
+
+    QTemporaryFile badMagic;
+    QVERIFY(badMagic.open());
+    encoded[0] = 'X';
+    badMagic.write(encoded);
+    badMagic.flush();
+    QVERIFY(!animation.open(badMagic.fileName()));
+
+    // The effect thread would never sleep
+    QVector<ushort> zeroDuration = durations;
+    zeroDuration[5] = 0;
+    QTemporaryFile noDuration;
+    QVERIFY(noDuration.open());
+    noDuration.write(AnimationFile::encode(frames, zeroDuration));
+    noDuration.flush();
+    QVERIFY(!animation.open(noDuration.fileName()));
+
+    // Reading a pipe could block until the client writes to it
+    int pipeFds[2];
+    QCOMPARE(pipe(pipeFds), 0);
+    QVERIFY(!animation.open(pipeFds[0]));
+    ::close(pipeFds[0]);
+    ::close(pipeFds[1]);
+}
+
+#include "testAnimationFile.moc"
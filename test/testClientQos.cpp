@@ -0,0 +1,86 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QObject>
+#include <QtTest>
+
+#include "../src/dbus/clientqos.h"
+
+class testClientQos : public QObject
+{
+    Q_OBJECT
+private slots:
+    void burstThenRate();
+    void clientsAndClassesAreSeparate();
+    void forgetsIdleClients();
+};
+
+QTEST_MAIN(testClientQos)
+
+void testClientQos::burstThenRate()
+{
+    ClientQos qos;
+    qos.setLimit(ClientQos::TrafficClass::Control, {10, 3});
+
+    for (int i = 0; i < 3; i++)
+        QVERIFY(qos.admit(":1.1", ClientQos::TrafficClass::Control, 0));
+    QVERIFY(!qos.admit(":1.1", ClientQos::TrafficClass::Control, 0));
+
+    // One token every 100 ms
+    QVERIFY(!qos.admit(":1.1", ClientQos::TrafficClass::Control, 99000));
+    QVERIFY(qos.admit(":1.1", ClientQos::TrafficClass::Control, 100000));
+    QVERIFY(!qos.admit(":1.1", ClientQos::TrafficClass::Control, 100000));
+
+    // Never more than the burst, however long the client was idle
+    for (int i = 0; i < 3; i++)
+        QVERIFY(qos.admit(":1.1", ClientQos::TrafficClass::Control, 60000000));
+    QVERIFY(!qos.admit(":1.1", ClientQos::TrafficClass::Control, 60000000));
+}
+
+void testClientQos::clientsAndClassesAreSeparate()
+{
+    ClientQos qos;
+    qos.setLimit(ClientQos::TrafficClass::Control, {1, 1});
+    qos.setLimit(ClientQos::TrafficClass::Bulk, {1, 1});
+
+    QVERIFY(qos.admit(":1.1", ClientQos::TrafficClass::Bulk, 0));
+    QVERIFY(!qos.admit(":1.1", ClientQos::TrafficClass::Bulk, 0));
+    // A streaming client can still send control commands, and other clients aren't affected
+    QVERIFY(qos.admit(":1.1", ClientQos::TrafficClass::Control, 0));
+    QVERIFY(qos.admit(":1.2", ClientQos::TrafficClass::Bulk, 0));
+    QVERIFY(qos.admit(":1.2", ClientQos::TrafficClass::Control, 0));
+}
+
+void testClientQos::forgetsIdleClients()
+{
+    ClientQos qos;
+    qos.setLimit(ClientQos::TrafficClass::Control, {1, 2});
+
+    // Many short-lived clients, e.g. command line tools
+    for (int i = 0; i < 1000; i++)
+        QVERIFY(qos.admit(QString(":1.%1").arg(i), ClientQos::TrafficClass::Control, i * 2000000LL));
+
+    // A busy client keeps its bucket
+    QVERIFY(qos.admit("busy", ClientQos::TrafficClass::Control, 2000000000LL));
+    QVERIFY(qos.admit("busy", ClientQos::TrafficClass::Control, 2000000000LL));
+    for (int i = 0; i < 100; i++)
+        qos.admit(QString("new%1").arg(i), ClientQos::TrafficClass::Control, 2000000000LL);
+    QVERIFY(!qos.admit("busy", ClientQos::TrafficClass::Control, 2000000000LL));
+}
+
+#include "testClientQos.moc"
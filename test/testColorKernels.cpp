@@ -0,0 +1,192 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QObject>
+#include <QVector>
+#include <QtTest>
+
+#include "../src/customeffect/colorcorrection.h"
+#include "../src/customeffect/colorkernels.h"
+#include "../src/customeffect/effectkernels.h"
+
+Q_DECLARE_METATYPE(ColorKernelIsa)
+
+class testColorKernels : public QObject
+{
+    Q_OBJECT
+private:
+    QByteArray randomBytes(int size);
+
+private slots:
+    void matchesScalar_data();
+    void matchesScalar();
+    void spectrumColor();
+    void specializedKernelsMatchGeneric();
+    void colorCorrection();
+    void uniform();
+};
+
+QTEST_MAIN(testColorKernels)
+
+QByteArray testColorKernels::randomBytes(int size)
+{
+    QByteArray bytes(size, Qt::Uninitialized);
+    for (int i = 0; i < size; i++)
+        bytes[i] = static_cast<char>(qrand());
+    return bytes;
+}
+
+void testColorKernels::matchesScalar_data()
+{
+    QTest::addColumn<ColorKernelIsa>("isa");
+    QTest::newRow("sse2") << ColorKernelIsa::SSE2;
+    QTest::newRow("avx2") << ColorKernelIsa::AVX2;
+}
+
+void testColorKernels::matchesScalar()
+{
+    QFETCH(ColorKernelIsa, isa);
+    const ColorKernelTable *scalar = colorKernelTable(ColorKernelIsa::Scalar);
+    const ColorKernelTable *table = colorKernelTable(isa);
+    if (table == nullptr)
+        QSKIP("Not supported on this CPU or build.");
+
+    // Cover every tail length of the vector loops
+    for (int pixels = 0; pixels < 100; pixels++) {
+        QByteArray src = randomBytes(pixels * 3);
+        QByteArray expected = randomBytes(pixels * 3);
+        QByteArray actual = expected;
+        auto *e = reinterpret_cast<uchar *>(expected.data());
+        auto *a = reinterpret_cast<uchar *>(actual.data());
+        auto *s = reinterpret_cast<const uchar *>(src.constData());
+
+        uchar alpha = static_cast<uchar>(qrand());
+        scalar->blend(e, s, pixels, alpha);
+        table->blend(a, s, pixels, alpha);
+        QCOMPARE(actual, expected);
+
+        scalar->scale(e, pixels, alpha);
+        table->scale(a, pixels, alpha);
+        QCOMPARE(actual, expected);
+
+        scalar->scaleChannels(e, pixels, {0x12, 0xFF, alpha});
+        table->scaleChannels(a, pixels, {0x12, 0xFF, alpha});
+        QCOMPARE(actual, expected);
+
+        scalar->fill(e, pixels, {0x12, 0x34, 0x56});
+        table->fill(a, pixels, {0x12, 0x34, 0x56});
+        QCOMPARE(actual, expected);
+
+        scalar->gradient(e, pixels, {0x00, 0x80, 0xFF}, {0xFF, 0x10, 0x00});
+        table->gradient(a, pixels, {0x00, 0x80, 0xFF}, {0xFF, 0x10, 0x00});
+        QCOMPARE(actual, expected);
+
+        scalar->hsvToRgb(e, s, pixels);
+        table->hsvToRgb(a, s, pixels);
+        QCOMPARE(actual, expected);
+
+        QByteArray mask = randomBytes(pixels * 3);
+        auto *m = reinterpret_cast<const uchar *>(mask.constData());
+        for (BlendMode mode : {BlendMode::Normal, BlendMode::Add, BlendMode::Multiply, BlendMode::Screen}) {
+            scalar->composite(e, s, m, pixels, mode, alpha);
+            table->composite(a, s, m, pixels, mode, alpha);
+            QCOMPARE(actual, expected);
+
+            scalar->composite(e, s, nullptr, pixels, mode, alpha);
+            table->composite(a, s, nullptr, pixels, mode, alpha);
+            QCOMPARE(actual, expected);
+        }
+    }
+}
+
+void testColorKernels::spectrumColor()
+{
+    RGBval color = ::spectrumColor(0, 0x10);
+    QCOMPARE(color.red, static_cast<uchar>(0xFF));
+    QCOMPARE(color.green, static_cast<uchar>(0x00));
+
+    // Yellow is reached after one transition
+    color = ::spectrumColor(16, 0x10);
+    QCOMPARE(color.red, static_cast<uchar>(0xFF));
+    QCOMPARE(color.green, static_cast<uchar>(0xFF));
+    QCOMPARE(color.blue, static_cast<uchar>(0x00));
+
+    // And the cycle wraps around to red
+    color = ::spectrumColor(spectrumCycleLength(0x10), 0x10);
+    QCOMPARE(color.red, static_cast<uchar>(0xFF));
+    QCOMPARE(color.green, static_cast<uchar>(0x00));
+    QCOMPARE(color.blue, static_cast<uchar>(0x00));
+}
+
+void testColorKernels::specializedKernelsMatchGeneric()
+{
+    // Keyboard dimensions, which have a specialization
+    CustomFrame specialized(22, 6);
+    CustomFrame generic(22, 6);
+    QVERIFY(selectUniformKernel(22, 6) != &uniformKernel<0, 0>);
+
+    selectUniformKernel(22, 6)(specialized, {0x12, 0x34, 0x56});
+    uniformKernel<0, 0>(generic, {0x12, 0x34, 0x56});
+    QVERIFY(specialized == generic);
+
+    for (int position = 0; position < spectrumCycleLength(0x40); position++) {
+        selectWaveKernel(22, 6)(specialized, position, 0x40);
+        waveKernel<0, 0>(generic, position, 0x40);
+        QVERIFY(specialized == generic);
+    }
+}
+
+void testColorKernels::colorCorrection()
+{
+    ColorCorrection correction;
+    QVERIFY(correction.isIdentity());
+
+    // Without gamma the vectorized scale is used, it has to match the table
+    correction.setBrightness(0x80);
+    correction.setWhiteBalance(1.0, 0.5, 0.0);
+    QVERIFY(!correction.isIdentity());
+    RGBval color = correction.apply(RGBval{0xFF, 0xFF, 0xFF});
+    QCOMPARE(color.red, static_cast<uchar>(0x80));
+    QCOMPARE(color.green, static_cast<uchar>(0x40));
+    QCOMPARE(color.blue, static_cast<uchar>(0x00));
+
+    correction.setGamma(2.0);
+    correction.setWhiteBalance(1.0, 1.0, 1.0);
+    correction.setBrightness(0xFF);
+    color = correction.apply(RGBval{0xFF, 0x80, 0x00});
+    QCOMPARE(color.red, static_cast<uchar>(0xFF));
+    QCOMPARE(color.green, static_cast<uchar>(0x40));
+    QCOMPARE(color.blue, static_cast<uchar>(0x00));
+
+    correction.setGamma(1.0);
+    QVERIFY(correction.isIdentity());
+}
+
+void testColorKernels::uniform()
+{
+    CustomFrame frame(22, 6);
+    uniformKernel<0, 0>(frame, {0x12, 0x34, 0x56});
+    QVERIFY(isUniformRgb(frame.constData(), frame.size() / 3));
+    QVERIFY(isUniformRgb(frame.constData(), 1));
+
+    // Differs only in the last channel of the last pixel
+    frame.data()[frame.size() - 1] = 0x57;
+    QVERIFY(!isUniformRgb(frame.constData(), frame.size() / 3));
+}
+
+#include "testColorKernels.moc"
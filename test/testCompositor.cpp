@@ -0,0 +1,147 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QObject>
+#include <QtTest>
+
+#include "../src/customeffect/compositor.h"
+
+class testCompositor : public QObject
+{
+    Q_OBJECT
+private slots:
+    void emptyShowsBackground();
+    void undefinedPixelsAreTransparent();
+    void blendModes();
+    void upperLayerChange();
+    void removeLayer();
+};
+
+QTEST_MAIN(testCompositor)
+
+static QByteArray pixelData(int pixels, uchar red, uchar green, uchar blue)
+{
+    QByteArray data;
+    for (int i = 0; i < pixels; i++) {
+        data.append(static_cast<char>(red));
+        data.append(static_cast<char>(green));
+        data.append(static_cast<char>(blue));
+    }
+    return data;
+}
+
+static CustomFrame filledFrame(uchar width, uchar height, RGBval color)
+{
+    CustomFrame frame(width, height);
+    fillRgb(frame.data(), width * height, color);
+    return frame;
+}
+
+void testCompositor::emptyShowsBackground()
+{
+    Compositor compositor(4, 2);
+    CustomFrame background = filledFrame(4, 2, {0x10, 0x20, 0x30});
+    CustomFrame output;
+    QVERIFY(compositor.isEmpty());
+    compositor.compose(background, true, output);
+    QVERIFY(output == background);
+}
+
+void testCompositor::undefinedPixelsAreTransparent()
+{
+    Compositor compositor(4, 2);
+    CustomFrame background = filledFrame(4, 2, {0x10, 0x20, 0x30});
+    CustomFrame output;
+
+    QVERIFY(compositor.defineLayerRow(0, 1, 1, 2, pixelData(2, 0xFF, 0x00, 0x00)));
+    QVERIFY(compositor.isDirty());
+    compositor.compose(background, true, output);
+    QVERIFY(!compositor.isDirty());
+
+    QCOMPARE(output.rowArray(0), background.rowArray(0));
+    QCOMPARE(output.rowArray(1), pixelData(1, 0x10, 0x20, 0x30) + pixelData(2, 0xFF, 0x00, 0x00) + pixelData(1, 0x10, 0x20, 0x30));
+
+    // Out of bounds and wrong sizes are rejected
+    QVERIFY(!compositor.defineLayerRow(0, 2, 0, 0, pixelData(1, 0, 0, 0)));
+    QVERIFY(!compositor.defineLayerRow(0, 0, 0, 4, pixelData(5, 0, 0, 0)));
+    QVERIFY(!compositor.defineLayerRow(0, 0, 0, 1, pixelData(1, 0, 0, 0)));
+}
+
+void testCompositor::blendModes()
+{
+    Compositor compositor(1, 1);
+    CustomFrame background = filledFrame(1, 1, {0x80, 0x80, 0x80});
+    CustomFrame output;
+    compositor.defineLayerRow(0, 0, 0, 0, pixelData(1, 0x80, 0xFF, 0x00));
+
+    compositor.setLayerProperties(0, BlendMode::Add, 0xFF);
+    compositor.compose(background, true, output);
+    QCOMPARE(output.rowArray(0), pixelData(1, 0xFF, 0xFF, 0x80));
+
+    compositor.setLayerProperties(0, BlendMode::Multiply, 0xFF);
+    compositor.compose(background, false, output);
+    QCOMPARE(output.rowArray(0), pixelData(1, 0x40, 0x80, 0x00));
+
+    compositor.setLayerProperties(0, BlendMode::Screen, 0xFF);
+    compositor.compose(background, false, output);
+    QCOMPARE(output.rowArray(0), pixelData(1, 0xC0, 0xFF, 0x80));
+
+    compositor.setLayerProperties(0, BlendMode::Normal, 0x00);
+    compositor.compose(background, false, output);
+    QCOMPARE(output.rowArray(0), pixelData(1, 0x80, 0x80, 0x80));
+}
+
+void testCompositor::upperLayerChange()
+{
+    Compositor compositor(2, 1);
+    CustomFrame background = filledFrame(2, 1, {0x00, 0x00, 0x00});
+    CustomFrame output;
+    compositor.defineLayerRow(0, 0, 0, 1, pixelData(2, 0x40, 0x40, 0x40));
+    compositor.defineLayerRow(5, 0, 1, 1, pixelData(1, 0x20, 0x00, 0x00));
+    compositor.setLayerProperties(5, BlendMode::Add, 0xFF);
+    compositor.compose(background, true, output);
+    QCOMPARE(output.rowArray(0), pixelData(1, 0x40, 0x40, 0x40) + pixelData(1, 0x60, 0x40, 0x40));
+
+    // Only the upper layer is composited again, the result has to be the same as a full pass
+    compositor.defineLayerRow(5, 0, 0, 0, pixelData(1, 0x00, 0x00, 0x10));
+    compositor.compose(background, false, output);
+    QCOMPARE(output.rowArray(0), pixelData(1, 0x40, 0x40, 0x50) + pixelData(1, 0x60, 0x40, 0x40));
+}
+
+void testCompositor::removeLayer()
+{
+    Compositor compositor(1, 1);
+    CustomFrame background = filledFrame(1, 1, {0x01, 0x02, 0x03});
+    CustomFrame output;
+    compositor.defineLayerRow(0, 0, 0, 0, pixelData(1, 0xFF, 0xFF, 0xFF));
+    compositor.compose(background, true, output);
+    QVERIFY(output != background);
+
+    QVERIFY(!compositor.removeLayer(1));
+    QVERIFY(compositor.removeLayer(0));
+    QVERIFY(compositor.isEmpty());
+    QVERIFY(compositor.isDirty());
+    compositor.compose(background, false, output);
+    QVERIFY(output == background);
+
+    for (int layer = 0; layer < Compositor::maxLayers; layer++)
+        QVERIFY(compositor.setLayerProperties(layer, BlendMode::Normal, 0xFF));
+    QVERIFY(!compositor.setLayerProperties(Compositor::maxLayers, BlendMode::Normal, 0xFF));
+}
+
+#include "testCompositor.moc"
@@ -0,0 +1,85 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QObject>
+#include <QtTest>
+
+#include "../src/device/devicehealth.h"
+
+class testDeviceHealth : public QObject
+{
+    Q_OBJECT
+private slots:
+    void tripsAfterConsecutiveFailures();
+    void backsOffWhileProbing();
+};
+
+QTEST_MAIN(testDeviceHealth)
+
+void testDeviceHealth::tripsAfterConsecutiveFailures()
+{
+    DeviceHealth health;
+    QVERIFY(health.allowRequest());
+
+    // A success in between starts counting over
+    for (int i = 0; i < DeviceHealth::failureThreshold - 1; i++)
+        QVERIFY(!health.recordFailure());
+    health.recordSuccess();
+    for (int i = 0; i < DeviceHealth::failureThreshold - 1; i++)
+        QVERIFY(!health.recordFailure());
+    QVERIFY(health.allowRequest());
+
+    QVERIFY(health.recordFailure());
+    QCOMPARE(health.state(), DeviceHealth::State::Open);
+    QVERIFY(!health.allowRequest());
+    // Only reported once
+    QVERIFY(!health.recordFailure());
+}
+
+void testDeviceHealth::backsOffWhileProbing()
+{
+    DeviceHealth health;
+    for (int i = 0; i < DeviceHealth::failureThreshold; i++)
+        health.recordFailure();
+    QCOMPARE(health.backoff(), DeviceHealth::initialBackoff);
+
+    // Probes are let through
+    health.startProbe();
+    QCOMPARE(health.state(), DeviceHealth::State::HalfOpen);
+    QVERIFY(health.allowRequest());
+    QVERIFY(!health.recordFailure());
+
+    QCOMPARE(health.probeFailed(), DeviceHealth::initialBackoff * 2);
+    QVERIFY(!health.allowRequest());
+    QCOMPARE(health.probeFailed(), DeviceHealth::initialBackoff * 4);
+    for (int i = 0; i < 20; i++)
+        health.probeFailed();
+    QCOMPARE(health.backoff(), DeviceHealth::maxBackoff);
+
+    health.startProbe();
+    health.probeSucceeded();
+    QCOMPARE(health.state(), DeviceHealth::State::Closed);
+    QVERIFY(health.allowRequest());
+
+    // The next outage starts with short delays again
+    for (int i = 0; i < DeviceHealth::failureThreshold; i++)
+        health.recordFailure();
+    QCOMPARE(health.backoff(), DeviceHealth::initialBackoff);
+}
+
+#include "testDeviceHealth.moc"
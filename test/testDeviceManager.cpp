@@ -0,0 +1,143 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QObject>
+#include <QtTest>
+
+#include "../src/device/razerfakedevice.h"
+#include "../src/manager/devicemanager.h"
+
+class testDeviceManager : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void batchResultPerOperation();
+    void batchDeviceFailsPartway();
+
+private:
+    RazerFakeDevice *createDevice();
+    QDBusObjectPath ledPath(RazerFakeDevice *device, RazerLedId ledId);
+
+    QVector<RazerDevice *> devices;
+};
+
+QTEST_MAIN(testDeviceManager)
+
+void testDeviceManager::initTestCase()
+{
+    registerMetaTypes();
+}
+
+void testDeviceManager::init()
+{
+    devices.clear();
+}
+
+void testDeviceManager::cleanup()
+{
+    qDeleteAll(devices);
+    devices.clear();
+}
+
+RazerFakeDevice *testDeviceManager::createDevice()
+{
+    auto *device = new RazerFakeDevice("", 0x1532, 0x0000, "Fake keyboard", "keyboard", "fake",
+                                       {RazerLedId::LogoLED, RazerLedId::BacklightLED}, {"static", "spectrum", "brightness"}, {}, {}, {1, 1}, 0);
+    devices.append(device);
+    auto *rDevice = static_cast<RazerDevice *>(device);
+    if (!rDevice->openDeviceHandle() || !rDevice->initialize())
+        return nullptr;
+    return device;
+}
+
+QDBusObjectPath testDeviceManager::ledPath(RazerFakeDevice *device, RazerLedId ledId)
+{
+    return device->getLeds().value(ledId)->getObjectPath();
+}
+
+void testDeviceManager::batchResultPerOperation()
+{
+    RazerFakeDevice *first = createDevice();
+    RazerFakeDevice *second = createDevice();
+    QVERIFY(first != nullptr && second != nullptr);
+    DeviceManager manager(devices);
+
+    QList<RazerOperation> operations {
+        {ledPath(first, RazerLedId::LogoLED), "setStatic", {QVariant::fromValue(RGB {0xFF, 0x00, 0x00})}},
+        {ledPath(second, RazerLedId::LogoLED), "setStatic", {QVariant::fromValue(RGB {0x00, 0xFF, 0x00})}},
+        {QDBusObjectPath("/io/github/openrazer1/devices/none"), "setSpectrum", {}},
+        {ledPath(first, RazerLedId::BacklightLED), "setBrightness", {QVariant::fromValue(uchar(100))}},
+        {ledPath(first, RazerLedId::BacklightLED), "getBrightness", {}},
+        // Not one of the effects of the device
+        {ledPath(second, RazerLedId::BacklightLED), "setBreathingRandom", {}},
+        {ledPath(second, RazerLedId::BacklightLED), "setSpectrum", {}}
+    };
+    QList<RazerOperationResult> results = manager.applyBatch(operations);
+
+    QCOMPARE(results.size(), operations.size());
+    const QVector<bool> expected {true, true, false, true, false, false, true};
+    for (int i = 0; i < results.size(); i++) {
+        QCOMPARE(results.at(i).success, expected.at(i));
+        QCOMPARE(results.at(i).error.isEmpty(), expected.at(i));
+    }
+
+    // The reports of the operations that failed before reaching the device aren't sent
+    QCOMPARE(first->receivedReports().size(), 2);
+    QCOMPARE(second->receivedReports().size(), 2);
+    QCOMPARE(first->getLeds().value(RazerLedId::LogoLED)->getCurrentEffect(), RazerEffect::Static);
+    QCOMPARE(first->getLeds().value(RazerLedId::BacklightLED)->getBrightness(), uchar(100));
+    QCOMPARE(second->getLeds().value(RazerLedId::LogoLED)->getCurrentEffect(), RazerEffect::Static);
+}
+
+void testDeviceManager::batchDeviceFailsPartway()
+{
+    RazerFakeDevice *first = createDevice();
+    RazerFakeDevice *second = createDevice();
+    QVERIFY(first != nullptr && second != nullptr);
+    DeviceManager manager(devices);
+    second->failAfter(1);
+
+    QList<RazerOperation> operations {
+        {ledPath(first, RazerLedId::LogoLED), "setStatic", {QVariant::fromValue(RGB {0xFF, 0x00, 0x00})}},
+        {ledPath(second, RazerLedId::LogoLED), "setBrightness", {QVariant::fromValue(uchar(100))}},
+        {ledPath(second, RazerLedId::BacklightLED), "setStatic", {QVariant::fromValue(RGB {0x00, 0xFF, 0x00})}},
+        {ledPath(first, RazerLedId::BacklightLED), "setStatic", {QVariant::fromValue(RGB {0x00, 0x00, 0xFF})}}
+    };
+    QList<RazerOperationResult> results = manager.applyBatch(operations);
+
+    QCOMPARE(results.size(), operations.size());
+    QVERIFY(results.at(0).success);
+    QVERIFY(results.at(1).success);
+    QVERIFY(!results.at(2).success);
+    QCOMPARE(results.at(2).error, QString("Sending the reports to the device failed."));
+    QVERIFY(results.at(3).success);
+
+    // The other device isn't held back by the failure
+    QCOMPARE(first->receivedReports().size(), 2);
+    QCOMPARE(first->getLeds().value(RazerLedId::BacklightLED)->getCurrentEffect(), RazerEffect::Static);
+    QCOMPARE(second->receivedReports().size(), 1);
+    // The cached state of the failed device is what it was before the batch
+    QCOMPARE(second->getLeds().value(RazerLedId::BacklightLED)->getCurrentEffect(), RazerEffect::Spectrum);
+    QCOMPARE(second->getLeds().value(RazerLedId::LogoLED)->getBrightness(), uchar(255));
+}
+
+#include "testDeviceManager.moc"
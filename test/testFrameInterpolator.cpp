@@ -0,0 +1,108 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+
+#include <QObject>
+#include <QtTest>
+
+#include "../src/customeffect/frameinterpolator.h"
+
+class testFrameInterpolator : public QObject
+{
+    Q_OBJECT
+private slots:
+    void firstFrameIsShownDirectly();
+    void linear();
+    void eased();
+    void earlyFrameContinuesFromScreen();
+};
+
+QTEST_MAIN(testFrameInterpolator)
+
+static CustomFrame grayFrame(uchar value)
+{
+    CustomFrame frame(1, 1);
+    memset(frame.data(), value, frame.size());
+    return frame;
+}
+
+void testFrameInterpolator::firstFrameIsShownDirectly()
+{
+    FrameInterpolator interpolator;
+    interpolator.setMode(FrameInterpolator::Mode::Linear);
+    CustomFrame out;
+    QVERIFY(!interpolator.frameAt(0, out));
+
+    interpolator.pushFrame(grayFrame(100), 1000);
+    QVERIFY(interpolator.frameAt(1000, out));
+    QCOMPARE(out.constData()[0], static_cast<uchar>(100));
+    QVERIFY(!interpolator.isAnimating());
+    QVERIFY(!interpolator.frameAt(2000, out));
+}
+
+void testFrameInterpolator::linear()
+{
+    FrameInterpolator interpolator;
+    interpolator.setMode(FrameInterpolator::Mode::Linear);
+    CustomFrame out;
+    interpolator.pushFrame(grayFrame(0), 0);
+    interpolator.frameAt(0, out);
+
+    // The second frame arrives 100ms later, so it fades in over 100ms
+    interpolator.pushFrame(grayFrame(200), 100000);
+    QVERIFY(interpolator.frameAt(150000, out));
+    QCOMPARE(out.constData()[0], static_cast<uchar>(100));
+    QVERIFY(interpolator.frameAt(200000, out));
+    QCOMPARE(out.constData()[0], static_cast<uchar>(200));
+    QVERIFY(!interpolator.isAnimating());
+}
+
+void testFrameInterpolator::eased()
+{
+    FrameInterpolator interpolator;
+    interpolator.setMode(FrameInterpolator::Mode::Eased);
+    CustomFrame out;
+    interpolator.pushFrame(grayFrame(0), 0);
+    interpolator.frameAt(0, out);
+    interpolator.pushFrame(grayFrame(255), 100000);
+
+    // Slower than linear at the start, symmetric around the middle
+    interpolator.frameAt(110000, out);
+    QVERIFY(out.constData()[0] < 25);
+    interpolator.frameAt(150000, out);
+    QCOMPARE(out.constData()[0], static_cast<uchar>(128));
+}
+
+void testFrameInterpolator::earlyFrameContinuesFromScreen()
+{
+    FrameInterpolator interpolator;
+    interpolator.setMode(FrameInterpolator::Mode::Linear);
+    CustomFrame out;
+    interpolator.pushFrame(grayFrame(0), 0);
+    interpolator.pushFrame(grayFrame(200), 100000);
+
+    // Arrives halfway through the transition, which continues from 100 instead of jumping
+    interpolator.pushFrame(grayFrame(0), 150000);
+    QVERIFY(interpolator.frameAt(150000, out));
+    QCOMPARE(out.constData()[0], static_cast<uchar>(100));
+    interpolator.frameAt(175000, out);
+    QCOMPARE(out.constData()[0], static_cast<uchar>(50));
+}
+
+#include "testFrameInterpolator.moc"
@@ -0,0 +1,93 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QObject>
+#include <QtTest>
+
+#include "../src/stream/framestreamprotocol.h"
+
+using namespace FrameStream;
+
+class testFrameStreamProtocol : public QObject
+{
+    Q_OBJECT
+private slots:
+    void roundTrip();
+    void partialMessage();
+    void oversizedMessage();
+};
+
+QTEST_MAIN(testFrameStreamProtocol)
+
+void testFrameStreamProtocol::roundTrip()
+{
+    QByteArray payload;
+    appendUInt32(&payload, 0x12345678);
+    appendInt64(&payload, -42);
+    appendUInt8(&payload, RequestAck);
+    payload.append("rgb");
+
+    QByteArray buffer = encodeMessage(MessageType::Frame, payload);
+    buffer.append(encodeMessage(MessageType::Hello, QByteArray()));
+
+    MessageType type;
+    QByteArray received;
+    bool error;
+    QVERIFY(takeMessage(&buffer, &type, &received, &error));
+    QCOMPARE(type, MessageType::Frame);
+    QCOMPARE(received, payload);
+    QCOMPARE(readUInt32(received, 0), static_cast<quint32>(0x12345678));
+    QCOMPARE(readInt64(received, 4), static_cast<qint64>(-42));
+
+    // The second message is still in the buffer
+    QVERIFY(takeMessage(&buffer, &type, &received, &error));
+    QCOMPARE(type, MessageType::Hello);
+    QVERIFY(received.isEmpty());
+    QVERIFY(buffer.isEmpty());
+}
+
+void testFrameStreamProtocol::partialMessage()
+{
+    QByteArray message = encodeMessage(MessageType::SelectDevice, "/io/github/openrazer1/devices/XX0000000000");
+    QByteArray buffer;
+    MessageType type;
+    QByteArray payload;
+    bool error;
+    // Arrives one byte at a time
+    for (int i = 0; i < message.size() - 1; i++) {
+        buffer.append(message.at(i));
+        QVERIFY(!takeMessage(&buffer, &type, &payload, &error));
+        QVERIFY(!error);
+    }
+    buffer.append(message.at(message.size() - 1));
+    QVERIFY(takeMessage(&buffer, &type, &payload, &error));
+    QCOMPARE(type, MessageType::SelectDevice);
+}
+
+void testFrameStreamProtocol::oversizedMessage()
+{
+    QByteArray buffer;
+    appendUInt32(&buffer, maxMessageSize + 1);
+    MessageType type;
+    QByteArray payload;
+    bool error;
+    QVERIFY(!takeMessage(&buffer, &type, &payload, &error));
+    QVERIFY(error);
+}
+
+#include "testFrameStreamProtocol.moc"
@@ -0,0 +1,115 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QObject>
+#include <QtTest>
+
+#include "../src/customeffect/hardwareeffectmodel.h"
+
+class testHardwareEffectModel : public QObject
+{
+    Q_OBJECT
+private slots:
+    void staticColor();
+    void breathing();
+    void holdsFirstFrameBeforeStart();
+    void waveDirection();
+};
+
+QTEST_MAIN(testHardwareEffectModel)
+
+static HardwareEffectModel::State state(RazerEffect effect, RGBval color1 = {0x00, 0x00, 0x00}, RGBval color2 = {0x00, 0x00, 0x00})
+{
+    HardwareEffectModel::State state;
+    state.effect = effect;
+    state.color1 = color1;
+    state.color2 = color2;
+    return state;
+}
+
+void testHardwareEffectModel::staticColor()
+{
+    HardwareEffectModel model(22, 6);
+    CustomFrame frame;
+    model.setState(state(RazerEffect::Static, {0x12, 0x34, 0x56}), 0);
+    model.render(1000000, frame);
+    QCOMPARE(frame.width(), static_cast<uchar>(22));
+    QCOMPARE(frame.height(), static_cast<uchar>(6));
+    const uchar *last = frame.constData() + frame.size() - 3;
+    QCOMPARE(last[0], static_cast<uchar>(0x12));
+    QCOMPARE(last[1], static_cast<uchar>(0x34));
+    QCOMPARE(last[2], static_cast<uchar>(0x56));
+
+    // Off and effects that can't be modelled are dark
+    model.setState(state(RazerEffect::Reactive, {0x12, 0x34, 0x56}), 0);
+    model.render(0, frame);
+    QCOMPARE(frame.constData()[0], static_cast<uchar>(0x00));
+}
+
+void testHardwareEffectModel::breathing()
+{
+    HardwareEffectModel model(1, 1);
+    CustomFrame frame;
+    model.setState(state(RazerEffect::BreathingDual, {0xFF, 0x00, 0x00}, {0x00, 0x00, 0xFF}), 0);
+
+    // Starts dark, brightest in the middle of the breath
+    model.render(0, frame);
+    QCOMPARE(frame.constData()[0], static_cast<uchar>(0x00));
+    model.render(HardwareEffectModel::breathingPeriod / 2, frame);
+    QCOMPARE(frame.constData()[0], static_cast<uchar>(0xFF));
+
+    // The next breath uses the second color
+    model.render(HardwareEffectModel::breathingPeriod * 3 / 2, frame);
+    QCOMPARE(frame.constData()[0], static_cast<uchar>(0x00));
+    QCOMPARE(frame.constData()[2], static_cast<uchar>(0xFF));
+}
+
+void testHardwareEffectModel::holdsFirstFrameBeforeStart()
+{
+    HardwareEffectModel model(1, 1);
+    CustomFrame first, early;
+    model.setState(state(RazerEffect::Spectrum), 1000000);
+    model.render(1000000, first);
+    model.render(0, early);
+    QVERIFY(first == early);
+    // Spectrum starts at red
+    QCOMPARE(first.constData()[0], static_cast<uchar>(0xFF));
+    QCOMPARE(first.constData()[1], static_cast<uchar>(0x00));
+}
+
+void testHardwareEffectModel::waveDirection()
+{
+    HardwareEffectModel left(22, 1), right(22, 1);
+    HardwareEffectModel::State leftState = state(RazerEffect::Wave);
+    HardwareEffectModel::State rightState = leftState;
+    rightState.direction = WaveDirection::RIGHT_TO_LEFT;
+    left.setState(leftState, 0);
+    right.setState(rightState, 0);
+
+    // After one column's worth of time the colors moved by one column, in opposite directions
+    qint64 columnTime = HardwareEffectModel::wavePeriod / 22;
+    CustomFrame left0, left1, right0, right1;
+    left.render(0, left0);
+    left.render(columnTime, left1);
+    right.render(0, right0);
+    right.render(columnTime, right1);
+    QVERIFY(memcmp(left1.constData() + 3, left0.constData(), 3 * 20) == 0);
+    QVERIFY(memcmp(right1.constData(), right0.constData() + 3, 3 * 20) == 0);
+}
+
+#include "testHardwareEffectModel.moc"
@@ -0,0 +1,116 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QObject>
+#include <QtTest>
+
+#include "../src/customeffect/jitterbuffer.h"
+
+class testJitterBuffer : public QObject
+{
+    Q_OBJECT
+private slots:
+    void presentsInOrder();
+    void supersedesLateFrames();
+    void latencyShiftsSendTime();
+    void capacity();
+    void rejectsFarFutureFrames();
+};
+
+QTEST_MAIN(testJitterBuffer)
+
+static CustomFrame frameWithColor(uchar value)
+{
+    CustomFrame frame(2, 1);
+    frame.data()[0] = value;
+    return frame;
+}
+
+void testJitterBuffer::presentsInOrder()
+{
+    JitterBuffer buffer;
+    QVERIFY(buffer.push(3000, frameWithColor(3)));
+    QVERIFY(buffer.push(1000, frameWithColor(1)));
+    QVERIFY(buffer.push(2000, frameWithColor(2)));
+    QCOMPARE(buffer.nextSendTime(), qint64(1000));
+
+    qint64 pts;
+    CustomFrame frame;
+    QVector<qint64> dropped;
+    QVERIFY(!buffer.takeDue(999, &pts, &frame, &dropped));
+    for (uchar i = 1; i <= 3; i++) {
+        QVERIFY(buffer.takeDue(i * 1000, &pts, &frame, &dropped));
+        QCOMPARE(pts, qint64(i * 1000));
+        QCOMPARE(frame.constData()[0], i);
+    }
+    QVERIFY(dropped.isEmpty());
+    QVERIFY(buffer.isEmpty());
+}
+
+void testJitterBuffer::supersedesLateFrames()
+{
+    JitterBuffer buffer;
+    buffer.push(1000, frameWithColor(1));
+    buffer.push(2000, frameWithColor(2));
+    buffer.push(3000, frameWithColor(3));
+
+    qint64 pts;
+    CustomFrame frame;
+    QVector<qint64> dropped;
+    QVERIFY(buffer.takeDue(2500, &pts, &frame, &dropped));
+    QCOMPARE(pts, qint64(2000));
+    QCOMPARE(dropped, QVector<qint64>({1000}));
+    QCOMPARE(buffer.nextSendTime(), qint64(3000));
+}
+
+void testJitterBuffer::latencyShiftsSendTime()
+{
+    JitterBuffer buffer;
+    buffer.addLatencySample(400);
+    QCOMPARE(buffer.latency(), qint64(400));
+    buffer.push(1000, frameWithColor(1));
+    QCOMPARE(buffer.nextSendTime(), qint64(600));
+
+    // A single outlier only moves the estimate a bit
+    buffer.addLatencySample(4400);
+    QCOMPARE(buffer.latency(), qint64(900));
+}
+
+void testJitterBuffer::capacity()
+{
+    JitterBuffer buffer;
+    for (int i = 0; i < JitterBuffer::capacity; i++)
+        QVERIFY(buffer.push(i, frameWithColor(i)));
+    QVERIFY(!buffer.push(JitterBuffer::capacity, frameWithColor(0)));
+    // Replacing a queued frame is still possible
+    QVERIFY(buffer.push(0, frameWithColor(0xFF)));
+}
+
+void testJitterBuffer::rejectsFarFutureFrames()
+{
+    JitterBuffer buffer;
+    const qint64 now = 1000000;
+    QVERIFY(buffer.push(now + JitterBuffer::horizon, frameWithColor(1), now));
+    for (int i = 0; i < JitterBuffer::capacity; i++)
+        QVERIFY(!buffer.push(now + JitterBuffer::horizon + 1 + i, frameWithColor(2), now));
+    // The buffer didn't fill up, frames due soon still get in
+    QVERIFY(buffer.push(now + 1000, frameWithColor(3), now));
+    QCOMPARE(buffer.nextSendTime(), now + 1000);
+}
+
+#include "testJitterBuffer.moc"
@@ -27,7 +27,7 @@ private:
     QJsonArray loadJson();
     ushort hexStringToUshort(const QString &str);
 
-    QStringList allowedKeys = {"name", "vid", "pid", "type", "pclass", "leds", "fx", "features", "quirks", "matrix_dimensions", "max_dpi"};
+    QStringList allowedKeys = {"name", "vid", "pid", "type", "pclass", "leds", "fx", "features", "quirks", "matrix_dimensions", "max_dpi", "color_correction"};
 
     QStringList validType = {"core", "headset", "keyboard", "keypad", "mouse", "mousepad", "mug"};
     QStringList validPclass = {"classic", "matrix"};
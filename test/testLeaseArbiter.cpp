@@ -0,0 +1,128 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QObject>
+#include <QSignalSpy>
+#include <QtTest>
+
+#include "../src/dbus/leasearbiter.h"
+
+class testLeaseArbiter : public QObject
+{
+    Q_OBJECT
+private slots:
+    void everyoneControlsWithoutLeases();
+    void higherPriorityWins();
+    void previousOwnerComesBack();
+    void reacquiringKeepsOrder();
+    void releasesClientsThatAlreadyLeft();
+};
+
+QTEST_MAIN(testLeaseArbiter)
+
+void testLeaseArbiter::everyoneControlsWithoutLeases()
+{
+    LeaseArbiter leases;
+    QVERIFY(leases.owner().isEmpty());
+    QVERIFY(leases.mayControl(":1.1"));
+    QVERIFY(!leases.release(":1.1"));
+}
+
+void testLeaseArbiter::higherPriorityWins()
+{
+    LeaseArbiter leases;
+    QSignalSpy spy(&leases, &LeaseArbiter::ownerChanged);
+
+    leases.acquire(":1.1", 100);
+    QCOMPARE(leases.owner(), QString(":1.1"));
+    QVERIFY(leases.mayControl(":1.1"));
+    // Clients without a lease are suspended too
+    QVERIFY(!leases.mayControl(":1.3"));
+
+    // A lower priority is suspended, the owner doesn't change
+    leases.acquire(":1.2", 50);
+    QCOMPARE(leases.owner(), QString(":1.1"));
+    QVERIFY(!leases.mayControl(":1.2"));
+    QCOMPARE(spy.count(), 1);
+
+    leases.acquire(":1.3", 200);
+    QCOMPARE(leases.owner(), QString(":1.3"));
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(spy.last().at(0).toString(), QString(":1.1"));
+    QCOMPARE(spy.last().at(1).toString(), QString(":1.3"));
+}
+
+void testLeaseArbiter::previousOwnerComesBack()
+{
+    LeaseArbiter leases;
+    QSignalSpy spy(&leases, &LeaseArbiter::ownerChanged);
+
+    leases.acquire(":1.1", 100);
+    // Equal priorities, the most recent lease wins
+    leases.acquire(":1.2", 100);
+    QCOMPARE(leases.owner(), QString(":1.2"));
+
+    QVERIFY(leases.release(":1.2"));
+    QCOMPARE(leases.owner(), QString(":1.1"));
+    QVERIFY(!leases.holds(":1.2"));
+
+    // Releasing a suspended lease doesn't change the owner
+    leases.acquire(":1.3", 10);
+    QVERIFY(leases.release(":1.3"));
+    QCOMPARE(spy.count(), 3);
+
+    QVERIFY(leases.release(":1.1"));
+    QVERIFY(leases.owner().isEmpty());
+    QCOMPARE(spy.count(), 4);
+    QCOMPARE(spy.last().at(0).toString(), QString(":1.1"));
+    QVERIFY(spy.last().at(1).toString().isEmpty());
+}
+
+void testLeaseArbiter::reacquiringKeepsOrder()
+{
+    LeaseArbiter leases;
+    leases.acquire(":1.1", 100);
+    leases.acquire(":1.2", 100);
+
+    // Calling again with the same priority doesn't take the lighting back
+    leases.acquire(":1.1", 100);
+    QCOMPARE(leases.owner(), QString(":1.2"));
+
+    leases.acquire(":1.1", 101);
+    QCOMPARE(leases.owner(), QString(":1.1"));
+    leases.acquire(":1.1", 0);
+    QCOMPARE(leases.owner(), QString(":1.2"));
+}
+
+void testLeaseArbiter::releasesClientsThatAlreadyLeft()
+{
+    LeaseArbiter leases;
+    leases.acquire(":1.1", 100);
+    leases.acquire("peer", 200);
+    QCOMPARE(leases.owner(), QString("peer"));
+
+    // The peer hung up before its call was handled, nobody would ever release the lease
+    QDBusConnection peer = QDBusConnection::connectToPeer("unix:path=/nonexistent/razer_test", "peer");
+    QVERIFY(!peer.isConnected());
+    leases.watch("peer", peer);
+    QVERIFY(!leases.holds("peer"));
+    QCOMPARE(leases.owner(), QString(":1.1"));
+    QDBusConnection::disconnectFromPeer("peer");
+}
+
+#include "testLeaseArbiter.moc"
@@ -0,0 +1,111 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QDataStream>
+#include <QObject>
+#include <QtTest>
+
+#include "../src/openrgb/openrgbprotocol.h"
+
+using namespace OpenRgb;
+
+class testOpenRgbProtocol : public QObject
+{
+    Q_OBJECT
+private slots:
+    void header();
+    void controllerSize();
+    void mode();
+};
+
+QTEST_MAIN(testOpenRgbProtocol)
+
+void testOpenRgbProtocol::header()
+{
+    QByteArray data = packet(3, UpdateLeds, QByteArray(10, 'x'));
+    QCOMPARE(data.size(), headerSize + 10);
+
+    quint32 deviceIndex, packetId, size;
+    QVERIFY(parseHeader(data, &deviceIndex, &packetId, &size));
+    QCOMPARE(deviceIndex, static_cast<quint32>(3));
+    QCOMPARE(packetId, static_cast<quint32>(UpdateLeds));
+    QCOMPARE(size, static_cast<quint32>(10));
+
+    data[0] = 'X';
+    QVERIFY(!parseHeader(data, &deviceIndex, &packetId, &size));
+}
+
+void testOpenRgbProtocol::controllerSize()
+{
+    Controller controller;
+    controller.type = Keyboard;
+    controller.name = "Razer BlackWidow Chroma";
+    Mode direct;
+    direct.name = "Direct";
+    direct.flags = HasPerLedColor;
+    direct.colorMode = PerLed;
+    controller.modes.append(direct);
+    controller.zoneName = "Matrix";
+    controller.width = 22;
+    controller.height = 6;
+    controller.colors.fill(color(0x12, 0x34, 0x56), 22 * 6);
+
+    QByteArray data = controllerData(controller);
+    QDataStream stream(data);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    quint32 size;
+    qint32 type;
+    quint16 nameLength;
+    stream >> size >> type >> nameLength;
+    QCOMPARE(size, static_cast<quint32>(data.size()));
+    QCOMPARE(type, static_cast<qint32>(Keyboard));
+    QCOMPARE(nameLength, static_cast<quint16>(controller.name.size() + 1));
+
+    // The colors are at the end
+    QCOMPARE(data.right(4), QByteArray("\x12\x34\x56\x00", 4));
+}
+
+void testOpenRgbProtocol::mode()
+{
+    // Data of UpdateMode after the data size and the mode index
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream << static_cast<quint16>(7);
+    stream.writeRawData("Static", 7);
+    stream << static_cast<qint32>(2) << static_cast<quint32>(HasModeSpecificColor);
+    for (int i = 0; i < 6; i++)
+        stream << static_cast<quint32>(0);
+    stream << static_cast<quint32>(ModeSpecific) << static_cast<quint16>(1) << color(0xFF, 0x80, 0x00);
+
+    Mode mode;
+    int offset = 0;
+    QVERIFY(parseMode(data, &offset, &mode));
+    QCOMPARE(offset, data.size());
+    QCOMPARE(mode.name, QString("Static"));
+    QCOMPARE(mode.colorMode, static_cast<quint32>(ModeSpecific));
+    QCOMPARE(mode.colors.size(), 1);
+    QCOMPARE(red(mode.colors.at(0)), static_cast<uchar>(0xFF));
+    QCOMPARE(green(mode.colors.at(0)), static_cast<uchar>(0x80));
+
+    // Cut off in the middle of the colors
+    offset = 0;
+    QVERIFY(!parseMode(data.left(data.size() - 2), &offset, &mode));
+}
+
+#include "testOpenRgbProtocol.moc"
@@ -0,0 +1,135 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusPendingCall>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QObject>
+#include <QProcess>
+#include <QtTest>
+
+#include <grp.h>
+#include <unistd.h>
+
+#include "../src/dbus/peerserver.h"
+
+// Runs the client part of the test as nobody
+class UnprivilegedProcess : public QProcess
+{
+protected:
+    void setupChildProcess() override
+    {
+        if (setgroups(0, nullptr) != 0 || setgid(65534) != 0 || setuid(65534) != 0)
+            _exit(2);
+    }
+};
+
+class testPeerServer : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void identifiesClient();
+    void acceptsOtherUsers();
+
+private:
+    PeerServer server;
+};
+
+// Connects like the client library does and makes a call, so the connection is authenticated
+static bool introspect(const QDBusConnection &connection)
+{
+    QDBusPendingCall call = connection.asyncCall(QDBusMessage::createMethodCall(QString(), "/", "org.freedesktop.DBus.Introspectable", "Introspect"));
+    QElapsedTimer timer;
+    timer.start();
+    while (!call.isFinished() && timer.elapsed() < 5000)
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+    return call.isFinished() && !call.isError();
+}
+
+static QList<uint> peerUids()
+{
+    QList<uint> uids;
+    for (const QDBusConnection &connection : PeerServer::connections()) {
+        uint uid;
+        if (PeerServer::peerUid(connection, &uid))
+            uids.append(uid);
+    }
+    return uids;
+}
+
+void testPeerServer::initTestCase()
+{
+    QVERIFY(server.listen());
+}
+
+void testPeerServer::identifiesClient()
+{
+    {
+        QDBusConnection client = QDBusConnection::connectToPeer(server.address(), "client");
+        QVERIFY(client.isConnected());
+        QVERIFY(introspect(client));
+        QCOMPARE(peerUids(), QList<uint>({static_cast<uint>(getuid())}));
+    }
+    QDBusConnection::disconnectFromPeer("client");
+}
+
+void testPeerServer::acceptsOtherUsers()
+{
+    if (geteuid() != 0)
+        QSKIP("Running a client as another user needs root.");
+
+    UnprivilegedProcess client;
+    client.start(QCoreApplication::applicationFilePath(), {"--connect", server.address()});
+    if (!client.waitForStarted())
+        QSKIP("The test executable can't be run by nobody.");
+    QTRY_VERIFY_WITH_TIMEOUT(client.canReadLine() || client.state() == QProcess::NotRunning, 10000);
+    QCOMPARE(client.readLine(), QByteArray("connected\n"));
+    QVERIFY(peerUids().contains(65534));
+
+    client.closeWriteChannel();
+    QVERIFY(client.waitForFinished());
+    QCOMPARE(client.exitCode(), 0);
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    // Client part of acceptsOtherUsers, stays connected until its stdin is closed
+    if (argc == 3 && qstrcmp(argv[1], "--connect") == 0) {
+        QDBusConnection connection = QDBusConnection::connectToPeer(argv[2], "client");
+        if (!introspect(connection))
+            return 1;
+        QFile out;
+        out.open(stdout, QIODevice::WriteOnly);
+        out.write("connected\n");
+        out.flush();
+        QFile in;
+        in.open(stdin, QIODevice::ReadOnly);
+        in.readAll();
+        return 0;
+    }
+
+    testPeerServer test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "testPeerServer.moc"
@@ -0,0 +1,168 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QObject>
+#include <QtTest>
+
+#include "../src/device/busscheduler.h"
+#include "../src/device/reportscheduler.h"
+
+class testReportScheduler : public QObject
+{
+    Q_OBJECT
+private slots:
+    void sendsOneReportPerIteration();
+    void supersedesWaitingFrame();
+    void discard();
+    void interleavesDevicesOnBus();
+    void busUtilization();
+};
+
+QTEST_MAIN(testReportScheduler)
+
+static QVector<razer_report> reports(int first, int count)
+{
+    QVector<razer_report> result(count);
+    for (int i = 0; i < count; i++)
+        result[i].command_id.id = static_cast<unsigned char>(first + i);
+    return result;
+}
+
+void testReportScheduler::sendsOneReportPerIteration()
+{
+    QVector<int> sent;
+    ReportScheduler scheduler([&](const razer_report &report, razer_report *) {
+        sent.append(report.command_id.id);
+        return 0;
+    });
+    QVector<ReportScheduler::Result> results;
+    scheduler.submitBulk(reports(1, 3), [&](ReportScheduler::Result result) {
+        results.append(result);
+    });
+    QVERIFY(sent.isEmpty());
+    QVERIFY(scheduler.isBulkPending());
+
+    // D-Bus calls get a chance between the reports
+    QCoreApplication::processEvents();
+    QVERIFY(sent.size() <= 1);
+    QTRY_VERIFY(!scheduler.isBulkPending());
+    QCOMPARE(sent, QVector<int>({1, 2, 3}));
+    QCOMPARE(results, QVector<ReportScheduler::Result>({ReportScheduler::Result::Sent}));
+
+    // Nothing to send is done right away
+    scheduler.submitBulk({}, [&](ReportScheduler::Result result) {
+        results.append(result);
+    });
+    QCOMPARE(results.size(), 2);
+}
+
+void testReportScheduler::supersedesWaitingFrame()
+{
+    QVector<int> sent;
+    ReportScheduler scheduler([&](const razer_report &report, razer_report *) {
+        sent.append(report.command_id.id);
+        // The second report of the last frame fails
+        return report.command_id.id == 8 ? 1 : 0;
+    });
+    QVector<QPair<int, ReportScheduler::Result>> results;
+    for (int frame = 0; frame < 3; frame++) {
+        scheduler.submitBulk(reports(frame * 3 + 1, 2), [&, frame](ReportScheduler::Result result) {
+            results.append({frame, result});
+        });
+    }
+    QTRY_VERIFY(!scheduler.isBulkPending());
+    // The frame that was being sent is finished, the one waiting behind it is replaced
+    QCOMPARE(sent, QVector<int>({1, 2, 7, 8}));
+    QCOMPARE(results.size(), 3);
+    QCOMPARE(results.at(0), qMakePair(1, ReportScheduler::Result::Superseded));
+    QCOMPARE(results.at(1), qMakePair(0, ReportScheduler::Result::Sent));
+    QCOMPARE(results.at(2), qMakePair(2, ReportScheduler::Result::Failed));
+}
+
+void testReportScheduler::discard()
+{
+    int sent = 0;
+    ReportScheduler scheduler([&](const razer_report &, razer_report *) {
+        sent++;
+        return 0;
+    });
+    QVector<ReportScheduler::Result> results;
+    for (int frame = 0; frame < 2; frame++) {
+        scheduler.submitBulk(reports(0, 5), [&](ReportScheduler::Result result) {
+            results.append(result);
+        });
+    }
+    QCoreApplication::processEvents();
+    scheduler.discardBulk();
+    QVERIFY(!scheduler.isBulkPending());
+    QCOMPARE(results, QVector<ReportScheduler::Result>({ReportScheduler::Result::Superseded, ReportScheduler::Result::Superseded}));
+
+    int sentBefore = sent;
+    QTest::qWait(10);
+    QCOMPARE(sent, sentBefore);
+}
+
+void testReportScheduler::interleavesDevicesOnBus()
+{
+    QVector<int> sent;
+    auto sender = [&](const razer_report &report, razer_report *) {
+        sent.append(report.command_id.id);
+        return 0;
+    };
+    BusScheduler bus;
+    ReportScheduler keyboard(sender);
+    ReportScheduler mousepad(sender);
+    ReportScheduler mouse(sender);
+    bus.attach(&keyboard, false);
+    bus.attach(&mousepad, false);
+    bus.attach(&mouse, true);
+
+    keyboard.submitBulk(reports(10, 3), nullptr);
+    mousepad.submitBulk(reports(20, 3), nullptr);
+    mouse.submitBulk(reports(30, 2), nullptr);
+    QTRY_VERIFY(!keyboard.isBulkPending() && !mousepad.isBulkPending());
+    // The mouse goes first, the others take turns
+    QCOMPARE(sent, QVector<int>({30, 31, 10, 20, 11, 21, 12, 22}));
+
+    // Detached schedulers send on their own again
+    bus.detach(&mousepad);
+    sent.clear();
+    mousepad.submitBulk(reports(20, 2), nullptr);
+    QTRY_VERIFY(!mousepad.isBulkPending());
+    QCOMPARE(sent, QVector<int>({20, 21}));
+}
+
+void testReportScheduler::busUtilization()
+{
+    BusScheduler bus;
+    // The first window starts here, nothing is known before it's complete
+    QCOMPARE(bus.utilization(1000000), 0.0);
+    bus.recordTransaction(1001000, 1002000);
+    bus.recordTransaction(1600000, 1850000);
+    QCOMPARE(bus.utilization(1999000), 0.0);
+
+    QCOMPARE(bus.utilization(2000000), 0.251);
+    bus.recordTransaction(2200000, 2300000);
+    QCOMPARE(bus.utilization(2500000), 0.251);
+    QCOMPARE(bus.utilization(3100000), 0.1);
+
+    // An idle bus
+    QCOMPARE(bus.utilization(10000000), 0.0);
+}
+
+#include "testReportScheduler.moc"
@@ -0,0 +1,156 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QObject>
+#include <QtTest>
+
+#include "../src/device/razerfakedevice.h"
+#include "../src/led/razermatrixled.h"
+
+class testSettingCommits : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void storesOnlyLastValue();
+    void changeRestartsDelay();
+    void commitFlushes();
+    void zeroDelayStoresImmediately();
+    void customFrameDropsPendingEffects();
+
+private:
+    bool sendValue(const QString &key, uchar value);
+    // The varstore and the value of every report the device received
+    QVector<QPair<RazerVarstore, uchar>> received() const;
+
+    RazerFakeDevice *device = nullptr;
+};
+
+QTEST_MAIN(testSettingCommits)
+
+void testSettingCommits::init()
+{
+    device = new RazerFakeDevice("", 0x1532, 0x0000, "Fake mouse", "mouse", "fake",
+                                 {RazerLedId::LogoLED}, {"static"}, {}, {RazerDeviceQuirks::MouseMatrix}, {1, 1}, 0);
+    QVERIFY(static_cast<RazerDevice *>(device)->openDeviceHandle());
+    device->setCommitDelay(100);
+}
+
+void testSettingCommits::cleanup()
+{
+    delete device;
+    device = nullptr;
+}
+
+bool testSettingCommits::sendValue(const QString &key, uchar value)
+{
+    return device->sendSetting(key, [value](RazerVarstore varstore) {
+        razer_report report = get_razer_report(0x0F, 0x04, 0x03);
+        report.arguments[0] = static_cast<uchar>(varstore);
+        report.arguments[2] = value;
+        return report;
+    });
+}
+
+QVector<QPair<RazerVarstore, uchar>> testSettingCommits::received() const
+{
+    QVector<QPair<RazerVarstore, uchar>> result;
+    foreach (const razer_report &report, device->receivedReports())
+        result.append(qMakePair(static_cast<RazerVarstore>(report.arguments[0]), report.arguments[2]));
+    return result;
+}
+
+void testSettingCommits::storesOnlyLastValue()
+{
+    QVERIFY(sendValue("brightness/4", 10));
+    QVERIFY(sendValue("brightness/4", 20));
+    QVERIFY(sendValue("brightness/4", 30));
+    // Every change is applied right away, none is stored yet
+    QCOMPARE(received().size(), 3);
+    foreach (const auto &report, received())
+        QCOMPARE(report.first, RazerVarstore::NOSTORE);
+
+    QTRY_COMPARE(received().size(), 4);
+    QCOMPARE(received().last(), qMakePair(RazerVarstore::STORE, uchar(30)));
+    QTest::qWait(200);
+    QCOMPARE(received().size(), 4);
+}
+
+void testSettingCommits::changeRestartsDelay()
+{
+    // Each change comes before the previous one would have been stored
+    for (uchar value = 1; value <= 4; value++) {
+        QVERIFY(sendValue("brightness/4", value));
+        QTest::qWait(50);
+    }
+    QCOMPARE(received().size(), 4);
+
+    QTRY_COMPARE(received().size(), 5);
+    QCOMPARE(received().last(), qMakePair(RazerVarstore::STORE, uchar(4)));
+}
+
+void testSettingCommits::commitFlushes()
+{
+    QVERIFY(sendValue("brightness/4", 10));
+    QVERIFY(sendValue("rgb/4", 20));
+    device->clearReceivedReports();
+
+    QVERIFY(device->commit());
+    auto reports = received();
+    QCOMPARE(reports.size(), 2);
+    QVERIFY(reports.contains(qMakePair(RazerVarstore::STORE, uchar(10))));
+    QVERIFY(reports.contains(qMakePair(RazerVarstore::STORE, uchar(20))));
+
+    // Nothing is left for the timer
+    QTest::qWait(200);
+    QCOMPARE(received().size(), 2);
+}
+
+void testSettingCommits::zeroDelayStoresImmediately()
+{
+    QVERIFY(sendValue("brightness/4", 10));
+    device->clearReceivedReports();
+    // Turning the delay off stores what is pending
+    QVERIFY(device->setCommitDelay(0));
+    QCOMPARE(received(), QVector<QPair<RazerVarstore, uchar>>({qMakePair(RazerVarstore::STORE, uchar(10))}));
+
+    QVERIFY(sendValue("brightness/4", 20));
+    QCOMPARE(received().size(), 2);
+    QCOMPARE(received().last(), qMakePair(RazerVarstore::STORE, uchar(20)));
+    QTest::qWait(200);
+    QCOMPARE(received().size(), 2);
+}
+
+void testSettingCommits::customFrameDropsPendingEffects()
+{
+    RazerMatrixLED led(device, RazerLedId::LogoLED);
+    QVERIFY(sendValue("brightness/4", 10));
+    QVERIFY(led.setMouseMatrixEffect(RazerMouseMatrixEffectId::Static, 0x00, 0x00, 0x01, 0xFF, 0x00, 0x00));
+    QVERIFY(led.setMouseMatrixEffect(RazerMouseMatrixEffectId::CustomFrame));
+    device->clearReceivedReports();
+
+    // Storing the static effect would replace the custom frame, the brightness is still stored
+    QTRY_COMPARE(received().size(), 1);
+    QCOMPARE(received().first(), qMakePair(RazerVarstore::STORE, uchar(10)));
+    QTest::qWait(200);
+    QCOMPARE(received().size(), 1);
+}
+
+#include "testSettingCommits.moc"
@@ -0,0 +1,109 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QObject>
+#include <QThread>
+#include <QtTest>
+
+#include "../src/customeffect/triplebuffer.h"
+
+struct TestFrame {
+    int id;
+    int data[16];
+};
+
+class ProducerThread : public QThread
+{
+public:
+    ProducerThread(TripleBuffer<TestFrame> *buffer, int frameCount) : buffer(buffer), frameCount(frameCount) {}
+
+protected:
+    void run() override
+    {
+        for (int i = 1; i <= frameCount; i++) {
+            TestFrame &frame = buffer->writeBuffer();
+            frame.id = i;
+            for (int &value : frame.data)
+                value = i;
+            buffer->publish();
+        }
+    }
+
+private:
+    TripleBuffer<TestFrame> *buffer;
+    int frameCount;
+};
+
+class testTripleBuffer : public QObject
+{
+    Q_OBJECT
+private slots:
+    void fetchReturnsNewestFrame();
+    void concurrentFramesAreComplete();
+};
+
+QTEST_MAIN(testTripleBuffer)
+
+void testTripleBuffer::fetchReturnsNewestFrame()
+{
+    TripleBuffer<int> buffer;
+    buffer.reset(0);
+
+    QVERIFY(!buffer.fetch());
+
+    buffer.writeBuffer() = 1;
+    buffer.publish();
+    buffer.writeBuffer() = 2;
+    buffer.publish();
+
+    QVERIFY(buffer.fetch());
+    QCOMPARE(buffer.readBuffer(), 2);
+    // Nothing new has been published since
+    QVERIFY(!buffer.fetch());
+    QCOMPARE(buffer.readBuffer(), 2);
+
+    buffer.writeBuffer() = 3;
+    buffer.publish();
+    QVERIFY(buffer.fetch());
+    QCOMPARE(buffer.readBuffer(), 3);
+}
+
+void testTripleBuffer::concurrentFramesAreComplete()
+{
+    const int frameCount = 200000;
+    TripleBuffer<TestFrame> buffer;
+    buffer.reset(TestFrame {0, {}});
+
+    ProducerThread producer(&buffer, frameCount);
+    producer.start();
+
+    int lastId = 0;
+    while (lastId < frameCount) {
+        if (!buffer.fetch())
+            continue;
+        const TestFrame &frame = buffer.readBuffer();
+        QVERIFY(frame.id > lastId);
+        for (int value : frame.data)
+            QCOMPARE(value, frame.id);
+        lastId = frame.id;
+    }
+
+    producer.wait();
+}
+
+#include "testTripleBuffer.moc"
@@ -0,0 +1,93 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QObject>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include "../src/device/usbtopology.h"
+
+class testUsbTopology : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void deviceBehindHub();
+    void deviceOnRootHub();
+    void unknownDevice();
+
+private:
+    void addDevice(const QString &usbDevice, const QString &interface, int bus, const QString &ports, const QString &hidraw);
+
+    QTemporaryDir sysfs;
+};
+
+QTEST_MAIN(testUsbTopology)
+
+void testUsbTopology::initTestCase()
+{
+    QVERIFY(sysfs.isValid());
+    QVERIFY(QDir(sysfs.path()).mkpath("class/hidraw"));
+    addDevice("devices/pci0000:00/0000:00:14.0/usb1/1-2/1-2.3", "1-2.3:1.0", 1, "2.3", "hidraw3");
+    addDevice("devices/pci0000:00/0000:00:14.0/usb3/3-1", "3-1:1.2", 3, "1", "hidraw7");
+}
+
+// Creates the directories of a USB device with one HID interface and links the hidraw node to it, like the kernel does
+void testUsbTopology::addDevice(const QString &usbDevice, const QString &interface, int bus, const QString &ports, const QString &hidraw)
+{
+    QDir root(sysfs.path());
+    QString hid = QString("%1/%2/0003:1532:0226.0005").arg(usbDevice, interface);
+    QVERIFY(root.mkpath(hid + "/hidraw/" + hidraw));
+
+    QFile busnum(root.filePath(usbDevice + "/busnum"));
+    QVERIFY(busnum.open(QIODevice::WriteOnly));
+    busnum.write(QByteArray::number(bus) + "\n");
+    QFile devpath(root.filePath(usbDevice + "/devpath"));
+    QVERIFY(devpath.open(QIODevice::WriteOnly));
+    devpath.write(ports.toLatin1() + "\n");
+
+    QVERIFY(QFile::link(root.filePath(hid + "/hidraw/" + hidraw), root.filePath("class/hidraw/" + hidraw)));
+    QVERIFY(QFile::link(root.filePath(hid), root.filePath(hid + "/hidraw/" + hidraw + "/device")));
+}
+
+void testUsbTopology::deviceBehindHub()
+{
+    UsbLocation location = UsbTopology::locate("/dev/hidraw3", sysfs.path());
+    QVERIFY(location.isValid());
+    QCOMPARE(location.bus, 1);
+    QCOMPARE(location.ports, QString("2.3"));
+}
+
+void testUsbTopology::deviceOnRootHub()
+{
+    UsbLocation location = UsbTopology::locate("/dev/hidraw7", sysfs.path());
+    QCOMPARE(location.bus, 3);
+    QCOMPARE(location.ports, QString("1"));
+}
+
+void testUsbTopology::unknownDevice()
+{
+    QVERIFY(!UsbTopology::locate("/dev/hidraw9", sysfs.path()).isValid());
+    // Paths of the fake devices and other backends
+    QVERIFY(!UsbTopology::locate("fake", sysfs.path()).isValid());
+    QVERIFY(!UsbTopology::locate("", sysfs.path()).isValid());
+}
+
+#include "testUsbTopology.moc"
@@ -0,0 +1,127 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Calls methods of a device of a running daemon and reports the calls per second, e.g.
+ *   razer_test --fake-devices &
+ *   dbuscall_bench --peer
+ * Run it against a daemon started with --legacy-adaptors to compare with the adaptors.
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusPendingCall>
+#include <QDBusReply>
+#include <QDBusVariant>
+#include <QElapsedTimer>
+#include <QQueue>
+
+static const char *const serviceName = "io.github.openrazer1";
+static const char *const managerPath = "/io/github/openrazer1";
+
+// Sends the call count times with up to pipeline calls waiting for their reply. Returns calls per second.
+static double run(const QDBusConnection &connection, const QDBusMessage &call, int count, int pipeline, int *errors)
+{
+    QQueue<QDBusPendingCall> pending;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < count; i++) {
+        if (pending.size() >= pipeline) {
+            QDBusPendingCall reply = pending.dequeue();
+            reply.waitForFinished();
+            if (reply.isError())
+                (*errors)++;
+        }
+        pending.enqueue(connection.asyncCall(call));
+    }
+    while (!pending.isEmpty()) {
+        QDBusPendingCall reply = pending.dequeue();
+        reply.waitForFinished();
+        if (reply.isError())
+            (*errors)++;
+    }
+    return count / (timer.nsecsElapsed() / 1000000000.0);
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addOption({"peer", "Calls over the peer-to-peer connection of the daemon instead of the system bus."});
+    parser.addOption({"device", "Calls the device with the object <path> instead of the first one.", "path"});
+    parser.addOption({"calls", "Number of calls per method, 10000 by default.", "count", "10000"});
+    parser.addOption({"pipeline", "Number of calls waiting for their reply at once, 1 by default.", "count", "1"});
+    parser.process(app);
+
+    int count = parser.value("calls").toInt();
+    int pipeline = parser.value("pipeline").toInt();
+    if (count <= 0 || pipeline <= 0)
+        qFatal("--calls and --pipeline have to be positive.");
+
+    QDBusConnection connection = QDBusConnection::systemBus();
+    QString service = serviceName;
+    if (parser.isSet("peer")) {
+        QDBusMessage call = QDBusMessage::createMethodCall(serviceName, managerPath, "io.github.openrazer1.Manager", "getPeerAddress");
+        QDBusReply<QString> address = connection.call(call);
+        if (!address.isValid())
+            qFatal("Failed to get the peer address: %s", qUtf8Printable(address.error().message()));
+        connection = QDBusConnection::connectToPeer(address.value(), "dbuscall_bench");
+        if (!connection.isConnected())
+            qFatal("Failed to connect to %s.", qUtf8Printable(address.value()));
+        service = QString();
+    }
+
+    QString devicePath = parser.value("device");
+    if (devicePath.isEmpty()) {
+        QDBusMessage call = QDBusMessage::createMethodCall(service, managerPath, "org.freedesktop.DBus.Properties", "Get");
+        call << "io.github.openrazer1.Manager" << "Devices";
+        QDBusReply<QDBusVariant> devices = connection.call(call);
+        if (!devices.isValid())
+            qFatal("Failed to get the devices: %s", qUtf8Printable(devices.error().message()));
+        QList<QDBusObjectPath> paths = qdbus_cast<QList<QDBusObjectPath>>(devices.value().variant());
+        if (paths.isEmpty())
+            qFatal("No device found.");
+        devicePath = paths.first().path();
+    }
+    printf("%d calls to %s, %d in flight\n", count, qPrintable(devicePath), pipeline);
+
+    QDBusMessage monotonicTime = QDBusMessage::createMethodCall(service, devicePath, "io.github.openrazer1.Device", "getMonotonicTime");
+    QDBusMessage softwareBrightness = QDBusMessage::createMethodCall(service, devicePath, "io.github.openrazer1.Device", "setSoftwareBrightness");
+    softwareBrightness << QVariant::fromValue(static_cast<uchar>(0xFF));
+    QDBusMessage property = QDBusMessage::createMethodCall(service, devicePath, "org.freedesktop.DBus.Properties", "Get");
+    property << "io.github.openrazer1.Device" << "Name";
+
+    const QList<QPair<const char *, QDBusMessage>> calls {
+        {"getMonotonicTime", monotonicTime},
+        {"setSoftwareBrightness", softwareBrightness},
+        {"Properties.Get", property}
+    };
+    for (const auto &call : calls) {
+        int errors = 0;
+        // Warm up, e.g. the caches of the daemon
+        run(connection, call.second, qMin(count, 100), pipeline, &errors);
+        errors = 0;
+        double rate = run(connection, call.second, count, pipeline, &errors);
+        printf("%-22s %10.0f calls/s%s\n", call.first, rate, errors > 0 ? qPrintable(QString(", %1 errors").arg(errors)) : "");
+    }
+    return 0;
+}
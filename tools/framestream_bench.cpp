@@ -0,0 +1,196 @@
+/*
+ * <one line to give the program's name and a brief idea of what it does.>
+ * Copyright (C) 2018  Luca Weiss <luca@z3ntu.xyz>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Streams frames to a device of a running daemon and reports the frame rate and latency, e.g.
+ *   razer_test --fake-devices &
+ *   framestream_bench --frames 600 --fps 60
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QLocalSocket>
+#include <QVector>
+
+#include <algorithm>
+#include <chrono>
+
+#include "../src/stream/framestreamprotocol.h"
+
+using namespace FrameStream;
+
+// Same clock as the presentation timestamps of the daemon
+static qint64 monotonicTime()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool readMessage(QLocalSocket &socket, QByteArray &buffer, MessageType *type, QByteArray *payload, int timeout)
+{
+    QElapsedTimer timer;
+    timer.start();
+    bool error;
+    while (!takeMessage(&buffer, type, payload, &error)) {
+        if (error)
+            return false;
+        int remaining = timeout - static_cast<int>(timer.elapsed());
+        if (remaining <= 0 || !socket.waitForReadyRead(remaining))
+            return false;
+        buffer.append(socket.readAll());
+    }
+    if (*type == MessageType::Error) {
+        qWarning("Error from the daemon: %s", qUtf8Printable(QString::fromUtf8(*payload)));
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addOption({"socket", QString("Connects to the local socket <name> instead of %1.").arg(defaultSocketName), "name"});
+    parser.addOption({"device", "Streams to the device with the object <path> instead of the first one.", "path"});
+    parser.addOption({"frames", "Number of frames to send, 600 by default.", "count", "600"});
+    parser.addOption({"fps", "Frames per second to send at, 60 by default.", "fps", "60"});
+    parser.process(app);
+
+    int frameCount = parser.value("frames").toInt();
+    int fps = parser.value("fps").toInt();
+    if (frameCount <= 0 || fps <= 0)
+        qFatal("--frames and --fps have to be positive.");
+
+    QLocalSocket socket;
+    socket.connectToServer(parser.isSet("socket") ? parser.value("socket") : defaultSocketName);
+    if (!socket.waitForConnected(1000))
+        qFatal("Failed to connect: %s", qUtf8Printable(socket.errorString()));
+
+    QByteArray buffer;
+    MessageType type;
+    QByteArray payload;
+
+    QByteArray hello;
+    appendUInt16(&hello, protocolVersion);
+    socket.write(encodeMessage(MessageType::Hello, hello));
+    if (!readMessage(socket, buffer, &type, &payload, 1000) || type != MessageType::Welcome || payload.size() < 3)
+        qFatal("No welcome from the daemon.");
+
+    // Pick the device from the list in the welcome message
+    QString devicePath;
+    int offset = 3;
+    for (int i = 0; i < static_cast<quint8>(payload.at(2)) && offset < payload.size(); i++) {
+        int length = static_cast<quint8>(payload.at(offset));
+        QString path = QString::fromUtf8(payload.mid(offset + 1, length));
+        offset += 1 + length + 2;
+        if (devicePath.isEmpty() && (!parser.isSet("device") || parser.value("device") == path))
+            devicePath = path;
+    }
+    if (devicePath.isEmpty())
+        qFatal("Device not found.");
+
+    socket.write(encodeMessage(MessageType::SelectDevice, devicePath.toUtf8()));
+    if (!readMessage(socket, buffer, &type, &payload, 1000) || type != MessageType::DeviceSelected || payload.size() < 2)
+        qFatal("Failed to select %s.", qUtf8Printable(devicePath));
+    int width = static_cast<quint8>(payload.at(0));
+    int height = static_cast<quint8>(payload.at(1));
+    qInfo("Streaming %d frames of %dx%d to %s at %d fps.", frameCount, width, height, qUtf8Printable(devicePath), fps);
+
+    QVector<qint64> sendTimes(frameCount);
+    QVector<qint64> latencies;
+    int presented = 0, dropped = 0, rejected = 0, acked = 0;
+    qint64 firstPresent = 0, lastPresent = 0;
+
+    auto handleAck = [&](const QByteArray &ack) {
+        quint32 sequence = readUInt32(ack, 0);
+        auto status = static_cast<AckStatus>(static_cast<quint8>(ack.at(4)));
+        if (sequence >= static_cast<quint32>(frameCount))
+            return;
+        acked++;
+        if (status == AckStatus::Presented) {
+            qint64 now = monotonicTime();
+            latencies.append(now - sendTimes.at(static_cast<int>(sequence)));
+            if (presented == 0)
+                firstPresent = now;
+            lastPresent = now;
+            presented++;
+        } else if (status == AckStatus::Dropped) {
+            dropped++;
+        } else {
+            rejected++;
+        }
+    };
+    // Reads acks until the deadline on the monotonic clock
+    auto readAcksUntil = [&](qint64 deadline) {
+        bool error;
+        forever {
+            while (takeMessage(&buffer, &type, &payload, &error)) {
+                if (type == MessageType::Ack && payload.size() >= 13)
+                    handleAck(payload);
+                else if (type == MessageType::Error)
+                    qWarning("Error from the daemon: %s", qUtf8Printable(QString::fromUtf8(payload)));
+            }
+            if (error)
+                qFatal("Malformed message from the daemon.");
+            qint64 remaining = deadline - monotonicTime();
+            if (remaining <= 0)
+                return;
+            if (socket.waitForReadyRead(static_cast<int>(qMax(remaining / 1000, static_cast<qint64>(1)))))
+                buffer.append(socket.readAll());
+        }
+    };
+
+    qint64 interval = 1000000 / fps;
+    qint64 start = monotonicTime();
+    QByteArray frame;
+    for (int i = 0; i < frameCount; i++) {
+        readAcksUntil(start + i * interval);
+
+        frame.clear();
+        appendUInt32(&frame, static_cast<quint32>(i));
+        appendInt64(&frame, 0);
+        appendUInt8(&frame, RequestAck);
+        // A color that changes every frame, so nothing can be skipped as unchanged
+        frame.append(QByteArray(width * height * 3, static_cast<char>(i)));
+        sendTimes[i] = monotonicTime();
+        socket.write(encodeMessage(MessageType::Frame, frame));
+        socket.flush();
+    }
+    qint64 end = monotonicTime() + 2000000;
+    while (acked < frameCount && monotonicTime() < end)
+        readAcksUntil(qMin(end, monotonicTime() + 10000));
+
+    if (latencies.isEmpty())
+        qFatal("No frame was presented.");
+    std::sort(latencies.begin(), latencies.end());
+    qint64 sum = 0;
+    foreach (qint64 latency, latencies)
+        sum += latency;
+    double seconds = (lastPresent - firstPresent) / 1000000.0;
+
+    printf("presented %d, dropped %d, rejected %d, unacknowledged %d\n", presented, dropped, rejected, frameCount - acked);
+    printf("frames per second: %.1f\n", seconds > 0 ? (presented - 1) / seconds : 0.0);
+    printf("latency (us): mean %lld, p50 %lld, p99 %lld, max %lld\n",
+           sum / latencies.size(),
+           latencies.at(latencies.size() / 2),
+           latencies.at(latencies.size() * 99 / 100),
+           latencies.last());
+    return 0;
+}